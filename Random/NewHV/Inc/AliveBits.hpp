@@ -0,0 +1,187 @@
+// Copyright (c) 2013-2015 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+#ifndef SSVU_NEWHV_ALIVEBITS
+#define SSVU_NEWHV_ALIVEBITS
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include "SSVUtils/Core/Core.hpp"
+#include "../../NewHV/Inc/Common.hpp"
+
+namespace ssvu
+{
+    namespace Internal
+    {
+        /// @brief Packed liveness flags of a HandleVector, 64 items per word.
+        /// @details Scans work a word at a time, using popcount to count
+        /// alive items and ctz/clz to jump to the next alive (or dead) item.
+        /// Words are atomic so that items can be set dead concurrently
+        /// (e.g. from `forEachParallel`); every other operation must not run
+        /// concurrently with a modification.
+        class HVAliveBits
+        {
+        public:
+            using Word = std::uint64_t;
+            static constexpr SizeT wordBits{64u};
+
+        private:
+            std::unique_ptr<std::atomic<Word>[]> words;
+            SizeT wordCount{0u};
+
+            inline static constexpr SizeT getWordIdx(SizeT mI) noexcept
+            {
+                return mI / wordBits;
+            }
+
+            inline static constexpr Word getBit(SizeT mI) noexcept
+            {
+                return Word(1) << (mI % wordBits);
+            }
+
+            /// @brief Bits of the word `mW` that are in `[mB, mE)`.
+            inline static Word getMask(SizeT mW, SizeT mB, SizeT mE) noexcept
+            {
+                auto wB(mW * wordBits);
+                auto lo(mB > wB ? mB - wB : 0u);
+                auto hi(mE < wB + wordBits ? mE - wB : wordBits);
+
+                auto hiMask(hi == wordBits ? ~Word(0) : (Word(1) << hi) - 1);
+                return hiMask & ~((Word(1) << lo) - 1);
+            }
+
+            inline Word load(SizeT mW) const noexcept
+            {
+                return words[mW].load(std::memory_order_relaxed);
+            }
+
+            inline void store(SizeT mW, Word mX) noexcept
+            {
+                words[mW].store(mX, std::memory_order_relaxed);
+            }
+
+            /// @brief Calls `mF(i)` for every `i` in `[mB, mE)` whose bit is
+            /// `TValue`.
+            template <bool TValue, typename TF>
+            inline void forEachImpl(SizeT mB, SizeT mE, const TF& mF) const
+            {
+                if(mB >= mE) return;
+
+                for(auto w(getWordIdx(mB)); w <= getWordIdx(mE - 1); ++w)
+                {
+                    auto x((TValue ? load(w) : ~load(w)) & getMask(w, mB, mE));
+
+                    for(; x != 0; x &= x - 1)
+                        mF(w * wordBits + SizeT(__builtin_ctzll(x)));
+                }
+            }
+
+        public:
+            /// @brief Grows the storage to `mCapacity` items, which are
+            /// dead.
+            inline void grow(SizeT mCapacity)
+            {
+                auto wordCountNew(getWordIdx(mCapacity + wordBits - 1));
+                if(wordCountNew <= wordCount) return;
+
+                std::unique_ptr<std::atomic<Word>[]> wordsNew{
+                    new std::atomic<Word>[wordCountNew]};
+
+                for(auto w(0u); w < wordCountNew; ++w)
+                    wordsNew[w].store(w < wordCount ? load(w) : 0u,
+                        std::memory_order_relaxed);
+
+                words = std::move(wordsNew);
+                wordCount = wordCountNew;
+            }
+
+            inline bool test(SizeT mI) const noexcept
+            {
+                return (load(getWordIdx(mI)) & getBit(mI)) != 0;
+            }
+
+            inline void set(SizeT mI) noexcept
+            {
+                auto w(getWordIdx(mI));
+                store(w, load(w) | getBit(mI));
+            }
+
+            /// @brief Can be called concurrently for different items.
+            inline void resetConcurrent(SizeT mI) noexcept
+            {
+                words[getWordIdx(mI)].fetch_and(
+                    ~getBit(mI), std::memory_order_relaxed);
+            }
+
+            /// @brief Sets the items in `[mB, mE)` alive or dead.
+            inline void assign(SizeT mB, SizeT mE, bool mValue) noexcept
+            {
+                if(mB >= mE) return;
+
+                for(auto w(getWordIdx(mB)); w <= getWordIdx(mE - 1); ++w)
+                {
+                    auto mask(getMask(w, mB, mE));
+                    store(w, mValue ? load(w) | mask : load(w) & ~mask);
+                }
+            }
+
+            /// @brief Number of alive items in `[mB, mE)`.
+            inline SizeT count(SizeT mB, SizeT mE) const noexcept
+            {
+                if(mB >= mE) return 0;
+
+                SizeT result{0u};
+                for(auto w(getWordIdx(mB)); w <= getWordIdx(mE - 1); ++w)
+                    result += __builtin_popcountll(load(w) & getMask(w, mB, mE));
+
+                return result;
+            }
+
+            /// @brief First dead item in `[mB, mE)`, or `mE`.
+            inline SizeT findNextDead(SizeT mB, SizeT mE) const noexcept
+            {
+                if(mB >= mE) return mE;
+
+                for(auto w(getWordIdx(mB)); w <= getWordIdx(mE - 1); ++w)
+                {
+                    auto x(~load(w) & getMask(w, mB, mE));
+                    if(x != 0) return w * wordBits + SizeT(__builtin_ctzll(x));
+                }
+
+                return mE;
+            }
+
+            /// @brief Last alive item in `[mB, mE)`, or `mE`.
+            inline SizeT findPrevAlive(SizeT mB, SizeT mE) const noexcept
+            {
+                if(mB >= mE) return mE;
+
+                for(auto w(getWordIdx(mE - 1) + 1); w-- > getWordIdx(mB);)
+                {
+                    auto x(load(w) & getMask(w, mB, mE));
+                    if(x != 0)
+                        return w * wordBits + wordBits - 1 -
+                               SizeT(__builtin_clzll(x));
+                }
+
+                return mE;
+            }
+
+            template <typename TF>
+            inline void forEachAlive(SizeT mB, SizeT mE, const TF& mF) const
+            {
+                forEachImpl<true>(mB, mE, mF);
+            }
+
+            template <typename TF>
+            inline void forEachDead(SizeT mB, SizeT mE, const TF& mF) const
+            {
+                forEachImpl<false>(mB, mE, mF);
+            }
+        };
+    }
+}
+
+#endif
@@ -29,9 +29,19 @@ namespace ssvu
             SizeT size{0u};
             SizeT sizeNext{0u};
 
+            // Incremented whenever items may have moved or been destroyed.
+            SizeT epoch{0u};
+
             GrowableArray<Stat> stats;
             GrowableArray<Mark> marks;
 
+            // Liveness of the items, indexed like `stats`.
+            Internal::HVAliveBits aliveBits;
+
+            // Scratch storage of `refreshParallel`, kept between refreshes.
+            std::vector<SizeT> parallelCounts;
+            std::vector<HIdx> parallelIdxs;
+
             /// @brief Increases internal storage capacity by mAmount.
             inline void growCapacityBy(SizeT mAmount)
             {
@@ -41,6 +51,8 @@ namespace ssvu
                 getTD().growImpl(capacity, capacityNew);
                 stats.grow(capacity, capacityNew);
                 marks.grow(capacity, capacityNew);
+                aliveBits.grow(capacityNew);
+                ++epoch;
 
                 // Initialize resized storage and set `capacity` to
                 // `capacityNew`.
@@ -80,7 +92,7 @@ namespace ssvu
 
             inline void setDeadFromMark(HIdx mMarkIdx) noexcept
             {
-                getStatFromMark(mMarkIdx).alive = false;
+                aliveBits.resetConcurrent(marks[mMarkIdx].statIdx);
             }
 
         public:
@@ -92,14 +104,14 @@ namespace ssvu
 
                 for(auto i(0u); i < size; ++i)
                 {
-                    SSVU_ASSERT(stats[i].alive);
-                    stats[i].alive = false;
-
+                    SSVU_ASSERT(isAliveAt(i));
                     getTD().deinitImpl(i);
                     ++(marks[i].ctr);
                 }
 
+                aliveBits.assign(0, size, false);
                 size = sizeNext = 0u;
+                ++epoch;
             }
 
             /// @brief Reserves storage, increasing the capacity.
@@ -120,40 +132,242 @@ namespace ssvu
 
                 // `sizeNext` now is the first empty valid index - we create our
                 // atom there
+                auto idx(sizeNext);
+                createAtNext(fwd<TArgs>(mArgs)...);
+
+                // Create the handle
+                return Handle{
+                    getTD(), stats[idx].markIdx, getMarkFromStat(idx).ctr};
+            }
+
+            /// @brief Creates `mCount` atoms, constructing each of them from
+            /// `mArgs`, in contiguous storage that grows at most once.
+            /// @details The created atoms will not be used until the
+            /// HandleVector is refreshed.
+            template <typename... TArgs>
+            inline void createN(SizeT mCount, const TArgs&... mArgs)
+            {
+                reserve(sizeNext + mCount);
+                for(auto i(0u); i < mCount; ++i) createAtNext(mArgs...);
+            }
+
+            /// @brief Creates an atom at `sizeNext`, which must be a valid
+            /// index, and increments `sizeNext`.
+            template <typename... TArgs>
+            inline void createAtNext(TArgs&&... mArgs)
+            {
                 getTD().createImpl(fwd<TArgs>(mArgs)...);
-                stats[sizeNext].alive = true;
+                aliveBits.set(sizeNext);
 
                 // Update the mark
                 getMarkFromStat(sizeNext).statIdx = sizeNext;
 
-                // Create the handle
-                Handle result{getTD(), stats[sizeNext].markIdx,
-                    getMarkFromStat(sizeNext).ctr};
-
                 // Update next size
                 ++sizeNext;
+            }
+
+        protected:
+            /// @brief Swaps the dead item `mD` with the alive item `mA`.
+            /// @details Does not update `aliveBits`.
+            inline void refreshSwap(SizeT mD, SizeT mA)
+            {
+                getTD().refreshSwapImpl(mD, mA);
+                std::swap(stats[mD], stats[mA]);
+                getMarkFromStat(mD).statIdx = mD;
+            }
+
+            /// @brief Destroys the dead items in `[sizeNew, sizeNext)`,
+            /// invalidating their handles, and updates `aliveBits` and the
+            /// sizes after the alive items were moved to `[0, sizeNew)`.
+            inline void refreshFinish(SizeT mSizeNew)
+            {
+                for(auto i(mSizeNew); i < sizeNext; ++i)
+                {
+                    getTD().deinitImpl(i);
+                    ++(getMarkFromStat(i).ctr);
+                }
 
-                return result;
+                aliveBits.assign(0, mSizeNew, true);
+                aliveBits.assign(mSizeNew, sizeNext, false);
+                size = sizeNext = mSizeNew;
+                ++epoch;
             }
 
+        public:
+            /// @brief Moves the alive items to `[0, sizeNew)` and destroys
+            /// the dead ones.
+            /// @details The leftmost dead item is swapped with the rightmost
+            /// alive one, until they meet at `sizeNew`. `sizeNew` is
+            /// counted, and both items are found, a word of `aliveBits` at a
+            /// time.
             inline void
             refresh() // noexcept(noexcept(getTD().refreshDeinitImpl(mD)))
             {
-                Internal::refreshImpl(size, sizeNext,
-                    [this](SizeT mI)
+                auto sizeNew(aliveBits.count(0, sizeNext));
+
+                // Bits are only updated at the end: the searches skip the
+                // items already swapped through their bounds.
+                for(auto iD(aliveBits.findNextDead(0, sizeNew)), iA(sizeNext);
+                    iD < sizeNew; iD = aliveBits.findNextDead(iD + 1, sizeNew))
+                {
+                    iA = aliveBits.findPrevAlive(sizeNew, iA);
+                    SSVU_ASSERT(iA < sizeNext);
+
+                    refreshSwap(iD, iA);
+                }
+
+                refreshFinish(sizeNew);
+            }
+
+            /// @brief Refreshes the HandleVector using the threads of
+            /// `mPool`. Produces the same layout as `refresh()`.
+            /// @details The dead items in `[0, sizeNew)` are swapped with the
+            /// alive items in `[sizeNew, sizeNext)`, pairing the leftmost
+            /// dead item with the rightmost alive one, as `refresh()` does.
+            /// Both lists are built in parallel from per-chunk counts and
+            /// their prefix sums; the swaps and the deinitializations of
+            /// the dead items are then independent. Items must support
+            /// being swapped and destroyed concurrently with other items.
+            inline void refreshParallel(HVThreadPool& mPool)
+            {
+                Internal::HVChunks chunks{sizeNext, mPool};
+                if(chunks.count < 2 || mPool.getThreadCount() < 2)
+                {
+                    refresh();
+                    return;
+                }
+
+                // Alive items per chunk.
+                auto& counts(parallelCounts);
+                counts.resize(chunks.count * 2);
+
+                mPool.run(chunks.count, [this, &chunks, &counts](SizeT mC)
+                    {
+                        counts[mC] =
+                            aliveBits.count(chunks.begin(mC), chunks.end(mC));
+                    });
+
+                SizeT sizeNew{0u};
+                for(auto c(0u); c < chunks.count; ++c) sizeNew += counts[c];
+
+                // Dead items left of `sizeNew` (`counts[c]`) and alive items
+                // right of it (`counts[chunks.count + c]`), per chunk. Only
+                // the chunk containing `sizeNew` has to be scanned again.
+                for(auto c(0u); c < chunks.count; ++c)
+                {
+                    auto b(chunks.begin(c)), e(chunks.end(c));
+                    auto& deadLeft(counts[c]);
+                    auto& aliveRight(counts[chunks.count + c]);
+
+                    if(e <= sizeNew)
                     {
-                        return isAliveAt(mI);
-                    },
-                    [this](SizeT mD, SizeT mA)
+                        aliveRight = 0;
+                        deadLeft = (e - b) - deadLeft;
+                    }
+                    else if(b >= sizeNew)
                     {
-                        getTD().refreshSwapImpl(mD, mA);
-                        std::swap(stats[mD], stats[mA]);
-                        getMarkFromStat(mD).statIdx = mD;
-                    },
-                    [this](SizeT mD)
+                        aliveRight = deadLeft;
+                        deadLeft = 0;
+                    }
+                    else
                     {
-                        getTD().deinitImpl(mD);
-                        ++(getMarkFromStat(mD).ctr);
+                        deadLeft = (sizeNew - b) - aliveBits.count(b, sizeNew);
+                        aliveRight = aliveBits.count(sizeNew, e);
+                    }
+                }
+
+                // Exclusive prefix sums: first rank of every chunk.
+                SizeT pairCount{0u}, aliveRank{0u};
+                for(auto c(0u); c < chunks.count; ++c)
+                {
+                    auto d(counts[c]), a(counts[chunks.count + c]);
+                    counts[c] = pairCount;
+                    counts[chunks.count + c] = aliveRank;
+                    pairCount += d;
+                    aliveRank += a;
+                }
+
+                SSVU_ASSERT(pairCount == aliveRank);
+
+                // `parallelIdxs[p]` is the `p`-th dead item from the left,
+                // `parallelIdxs[pairCount + p]` the `p`-th alive item from
+                // the right.
+                auto& idxs(parallelIdxs);
+                idxs.resize(pairCount * 2);
+
+                mPool.run(chunks.count,
+                    [this, &chunks, &counts, &idxs, sizeNew, pairCount](SizeT mC)
+                    {
+                        auto d(counts[mC]), a(counts[chunks.count + mC]);
+                        auto b(chunks.begin(mC)), e(chunks.end(mC));
+
+                        aliveBits.forEachDead(b, std::min(e, sizeNew),
+                            [&idxs, &d](SizeT mI)
+                            {
+                                idxs[d++] = mI;
+                            });
+
+                        aliveBits.forEachAlive(std::max(b, sizeNew), e,
+                            [&idxs, &a, pairCount](SizeT mI)
+                            {
+                                idxs[pairCount * 2 - 1 - a++] = mI;
+                            });
+                    });
+
+                Internal::HVChunks pairChunks{pairCount, mPool};
+                mPool.run(pairChunks.count,
+                    [this, &pairChunks, &idxs, pairCount](SizeT mC)
+                    {
+                        for(auto p(pairChunks.begin(mC));
+                            p < pairChunks.end(mC); ++p)
+                        {
+                            refreshSwap(idxs[p], idxs[pairCount + p]);
+                        }
+                    });
+
+                // Every item in `[sizeNew, sizeNext)` is now dead.
+                Internal::HVChunks deadChunks{sizeNext - sizeNew, mPool};
+                mPool.run(deadChunks.count,
+                    [this, &deadChunks, sizeNew](SizeT mC)
+                    {
+                        for(auto i(sizeNew + deadChunks.begin(mC));
+                            i < sizeNew + deadChunks.end(mC); ++i)
+                        {
+                            getTD().deinitImpl(i);
+                            ++(getMarkFromStat(i).ctr);
+                        }
+                    });
+
+                aliveBits.assign(0, sizeNew, true);
+                aliveBits.assign(sizeNew, sizeNext, false);
+                size = sizeNext = sizeNew;
+                ++epoch;
+            }
+
+            /// @brief Returns the number of items in `[0, size)` that were
+            /// not killed since the last refresh.
+            inline auto countAlive() const noexcept
+            {
+                return aliveBits.count(0, size);
+            }
+
+            /// @brief Calls `mF(i)` for the index of every item in
+            /// `[0, size)` that was not killed since the last refresh.
+            template <typename TF>
+            inline void forEachAliveIdx(const TF& mF) const
+            {
+                aliveBits.forEachAlive(0, size, mF);
+            }
+
+            /// @brief Calls `mF(mBegin, mEnd)` for chunks of `[0, size)`,
+            /// using the threads of `mPool`.
+            template <typename TF>
+            inline void forChunksParallel(HVThreadPool& mPool, const TF& mF)
+            {
+                Internal::HVChunks chunks{size, mPool};
+                mPool.run(chunks.count, [&chunks, &mF](SizeT mC)
+                    {
+                        mF(chunks.begin(mC), chunks.end(mC));
                     });
             }
 
@@ -161,6 +375,12 @@ namespace ssvu
             inline auto getSize() const noexcept { return size; }
             inline auto getSizeNext() const noexcept { return sizeNext; }
 
+            /// @brief Returns a counter that changes on every refresh, and
+            /// whenever the storage grows or is cleared.
+            /// @details Pointers to items (e.g. from `resolveAll`) stay valid
+            /// while the epoch they were obtained in does not change.
+            inline auto getEpoch() const noexcept { return epoch; }
+
             inline auto& getStats() noexcept { return stats; }
             inline const auto& getStats() const noexcept { return stats; }
 
@@ -169,7 +389,7 @@ namespace ssvu
 
             inline bool isAliveAt(SizeT mI) const noexcept
             {
-                return stats[mI].alive;
+                return aliveBits.test(mI);
             }
         };
     }
@@ -56,17 +56,31 @@ namespace ssvu
         template <typename... TArgs>
         inline void createImpl(TArgs&&... mArgs) // noexcept(...)
         {
-            // TODO: tuple_emplace with N parameter packs for N types
-            // TODO: fix initialization                                  v ????
             tsFor([this, &mArgs...](auto& mA)
                 {
                     mA.initAt(this->sizeNext, fwd<TArgs>(mArgs)...);
                 });
+        }
+
+        // Piecewise construction: the `I`-th tuple holds the arguments of
+        // the `I`-th type.
+        template <typename T, typename TTpl, SizeT... TIs>
+        inline void initFromTpl(TTpl&& mTpl, std::index_sequence<TIs...>)
+        {
+            getArrayOf<T>().initAt(
+                this->sizeNext, std::get<TIs>(fwd<TTpl>(mTpl))...);
+        }
+
+        template <typename... TTpls>
+        inline void createImpl(std::piecewise_construct_t, TTpls&&... mTpls)
+        {
+            SSVU_ASSERT_STATIC_NM(sizeof...(TTpls) == sizeof...(TTs));
 
-            // TODO: instead of passing margs, pass a single tuple argument that
-            // contains N tuples containing the
-            // parameters used to initialize every single type
-            // basically, a tuple of tuples
+            using Swallow = int[];
+            (void)Swallow{(initFromTpl<TTs>(fwd<TTpls>(mTpls),
+                               std::make_index_sequence<std::tuple_size<
+                                   std::decay_t<TTpls>>::value>{}),
+                0)...};
         }
         template <typename T>
         inline auto& getItemFromMark(HIdx mMarkIdx) noexcept
@@ -98,6 +112,18 @@ namespace ssvu
             return std::get<GrowableArray<T>>(tplArrays);
         }
 
+        /// @brief Calls `mF(items...)` for every alive item, using the
+        /// threads of `mPool`. Items must not be created or refreshed
+        /// meanwhile.
+        template <typename TF>
+        inline void forEachParallel(HVThreadPool& mPool, const TF& mF)
+        {
+            this->forChunksParallel(mPool, [this, &mF](SizeT mB, SizeT mE)
+                {
+                    for(auto i(mB); i < mE; ++i) mF(getArrayOf<TTs>()[i]...);
+                });
+        }
+
         template <typename T>
         inline auto beginSingle() noexcept
         {
@@ -58,6 +58,45 @@ namespace ssvu
         inline auto& operator=(const HVSingle&) = delete;
         inline auto& operator=(HVSingle&&) = delete;
 
+        /// @brief Calls `mF(item)` for every alive item, using the threads
+        /// of `mPool`. Items must not be created or refreshed meanwhile.
+        template <typename TF>
+        inline void forEachParallel(HVThreadPool& mPool, const TF& mF)
+        {
+            this->forChunksParallel(mPool, [this, &mF](SizeT mB, SizeT mE)
+                {
+                    for(auto i(mB); i < mE; ++i) mF(items[i]);
+                });
+        }
+
+        /// @brief Writes a pointer to the item of each of the `mCount`
+        /// handles in `mHandles` to `mOut`, or `nullptr` for invalid
+        /// handles. Returns the current epoch.
+        /// @details Only the marks are read: the marks of later handles are
+        /// prefetched while earlier ones are resolved, so that their misses
+        /// overlap instead of being paid one after another as by
+        /// `Handle::get`. The pointers can be reused while `getEpoch()`
+        /// returns the same value.
+        inline auto resolveAll(
+            const Handle* mHandles, SizeT mCount, T** mOut) noexcept
+        {
+            constexpr SizeT prefetchDistance{16u};
+
+            for(auto i(0u); i < mCount; ++i)
+            {
+                if(i + prefetchDistance < mCount)
+                    __builtin_prefetch(
+                        &this->marks[mHandles[i + prefetchDistance].markIdx]);
+
+                const auto& h(mHandles[i]);
+                SSVU_ASSERT(h.hVec == this);
+
+                mOut[i] = h.isAlive() ? &getItemFromMark(h.markIdx) : nullptr;
+            }
+
+            return this->epoch;
+        }
+
         inline auto& getItems() noexcept { return items; }
         inline const auto& getItems() const noexcept { return items; }
 
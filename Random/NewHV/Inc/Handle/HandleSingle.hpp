@@ -13,6 +13,7 @@ namespace ssvu
     {
         template <typename, typename>
         friend class ssvu::Internal::HVImpl;
+        friend class ssvu::HVSingle<T>;
 
     private:
         inline HVHandleSingle(
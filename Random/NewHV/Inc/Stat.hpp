@@ -15,7 +15,6 @@ namespace ssvu
         struct HVStat
         {
             HIdx markIdx;
-            bool alive{false};
 
             HVStat(HIdx mMarkIdx) noexcept;
         };
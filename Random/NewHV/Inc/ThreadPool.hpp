@@ -0,0 +1,176 @@
+// Copyright (c) 2013-2015 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+#ifndef SSVU_NEWHV_THREADPOOL
+#define SSVU_NEWHV_THREADPOOL
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "SSVUtils/Core/Core.hpp"
+
+namespace ssvu
+{
+    /// @brief Minimal fork-join thread pool used by the parallel
+    /// HandleVector operations.
+    /// @details `run(n, f)` calls `f(i)` for every `i` in `[0, n)`,
+    /// distributing the indices between the workers and the calling thread,
+    /// and returns when every call returned. `f` must not throw.
+    class HVThreadPool
+    {
+    private:
+        std::vector<std::thread> workers;
+
+        std::mutex mtx;
+        std::condition_variable cvWork, cvDone;
+        SizeT generation{0u};
+        SizeT busy{0u};
+        bool stopping{false};
+
+        // Current job, published under `mtx`.
+        const void* jobData{nullptr};
+        void (*jobFn)(const void*, SizeT){nullptr};
+        SizeT jobCount{0u};
+        std::atomic<SizeT> jobNext{0u};
+
+        inline void work() noexcept
+        {
+            for(auto i(jobNext.fetch_add(1, std::memory_order_relaxed));
+                i < jobCount;
+                i = jobNext.fetch_add(1, std::memory_order_relaxed))
+                jobFn(jobData, i);
+        }
+
+        inline void workerLoop()
+        {
+            SizeT seen{0u};
+
+            while(true)
+            {
+                {
+                    std::unique_lock<std::mutex> lk{mtx};
+                    cvWork.wait(lk, [this, &seen]
+                        {
+                            return stopping || generation != seen;
+                        });
+
+                    if(stopping) return;
+                    seen = generation;
+                }
+
+                work();
+
+                std::lock_guard<std::mutex> lk{mtx};
+                if(--busy == 0) cvDone.notify_one();
+            }
+        }
+
+    public:
+        /// @brief Creates `mThreadCount - 1` workers: the thread calling
+        /// `run` is the last one.
+        inline explicit HVThreadPool(
+            SizeT mThreadCount = std::thread::hardware_concurrency())
+        {
+            for(auto i(1u); i < mThreadCount; ++i)
+                workers.emplace_back([this]
+                    {
+                        workerLoop();
+                    });
+        }
+
+        inline ~HVThreadPool()
+        {
+            {
+                std::lock_guard<std::mutex> lk{mtx};
+                stopping = true;
+            }
+
+            cvWork.notify_all();
+            for(auto& w : workers) w.join();
+        }
+
+        inline HVThreadPool(const HVThreadPool&) = delete;
+        inline HVThreadPool(HVThreadPool&&) = delete;
+
+        inline auto& operator=(const HVThreadPool&) = delete;
+        inline auto& operator=(HVThreadPool&&) = delete;
+
+        /// @brief Returns the number of threads taking part in `run`.
+        inline auto getThreadCount() const noexcept
+        {
+            return workers.size() + 1;
+        }
+
+        template <typename TF>
+        inline void run(SizeT mCount, const TF& mF)
+        {
+            if(workers.empty() || mCount < 2)
+            {
+                for(auto i(0u); i < mCount; ++i) mF(i);
+                return;
+            }
+
+            {
+                std::lock_guard<std::mutex> lk{mtx};
+
+                jobData = &mF;
+                jobFn = [](const void* mData, SizeT mI)
+                {
+                    (*static_cast<const TF*>(mData))(mI);
+                };
+                jobCount = mCount;
+                jobNext.store(0, std::memory_order_relaxed);
+                busy = workers.size();
+                ++generation;
+            }
+
+            cvWork.notify_all();
+            work();
+
+            std::unique_lock<std::mutex> lk{mtx};
+            cvDone.wait(lk, [this]
+                {
+                    return busy == 0;
+                });
+        }
+    };
+
+    namespace Internal
+    {
+        /// @brief Splits `[0, mSize)` into chunks of at least `minChunkSize`
+        /// items, up to four per thread of `mPool`.
+        struct HVChunks
+        {
+            static constexpr SizeT minChunkSize{4096u};
+
+            SizeT size, count, chunkSize;
+
+            inline HVChunks(SizeT mSize, const HVThreadPool& mPool) noexcept
+                : size{mSize}
+            {
+                auto maxCount(mPool.getThreadCount() * 4);
+                count = (size + minChunkSize - 1) / minChunkSize;
+                if(count > maxCount) count = maxCount;
+                if(count == 0) count = 1;
+
+                chunkSize = (size + count - 1) / count;
+            }
+
+            inline SizeT begin(SizeT mChunk) const noexcept
+            {
+                auto result(mChunk * chunkSize);
+                return result < size ? result : size;
+            }
+
+            inline SizeT end(SizeT mChunk) const noexcept
+            {
+                return begin(mChunk + 1);
+            }
+        };
+    }
+}
+
+#endif
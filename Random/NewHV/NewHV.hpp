@@ -21,6 +21,8 @@
 #include "../NewHV/Inc/Handle/HandleSingle.hpp"
 #include "../NewHV/Inc/Handle/HandleMulti.hpp"
 #include "../NewHV/Inc/Iterator.hpp"
+#include "../NewHV/Inc/ThreadPool.hpp"
+#include "../NewHV/Inc/AliveBits.hpp"
 #include "../NewHV/Inc/HV/HVImpl.hpp"
 #include "../NewHV/Inc/HV/HVSingle.hpp"
 #include "../NewHV/Inc/HV/HVMulti.hpp"
@@ -0,0 +1,180 @@
+// Copyright (c) 2013-2015 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+// Compares the packed liveness bits of the HandleVector with the previous
+// layout, an `alive` flag stored next to the mark index of every stat, on
+// 1M particles with 5% (sparse) and 95% (dense) of them alive: counting the
+// alive items, visiting them, and refreshing.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "NewHV.hpp"
+
+using namespace ssvu;
+
+struct Particle
+{
+    float x, y, vx, vy;
+    int id;
+
+    inline Particle(int mId) noexcept : x{0}, y{0}, vx{1}, vy{1}, id{mId} {}
+};
+
+using HV = HVSingle<Particle>;
+using HRClock = std::chrono::high_resolution_clock;
+
+constexpr SizeT particleCount{1000000u};
+constexpr SizeT repeatCount{20u};
+
+// Previous layout of `HVStat`.
+struct OldStat
+{
+    HIdx markIdx;
+    bool alive;
+};
+
+struct OldMark
+{
+    HIdx statIdx;
+    HCtr ctr;
+};
+
+template <typename TF>
+double measure(const TF& mF)
+{
+    auto start(HRClock::now());
+    for(auto r(0u); r < repeatCount; ++r) mF();
+    auto end(HRClock::now());
+
+    return std::chrono::duration<double, std::milli>(end - start).count() /
+           repeatCount;
+}
+
+// Emulates the previous `refresh()`: a two-pointer pass over the flags,
+// updating the marks as `HVImpl` does.
+void refreshOld(std::vector<OldStat>& mStats, std::vector<OldMark>& mMarks,
+    std::vector<Particle>& mItems)
+{
+    SizeT iD{0u}, iA{mStats.size() - 1};
+
+    while(true)
+    {
+        for(; true; ++iD)
+        {
+            if(iD > iA) goto finish;
+            if(!mStats[iD].alive) break;
+        }
+
+        for(; true; --iA)
+        {
+            if(mStats[iA].alive) break;
+            if(iA <= iD) goto finish;
+        }
+
+        std::swap(mItems[iD], mItems[iA]);
+        std::swap(mStats[iD], mStats[iA]);
+        mMarks[mStats[iD].markIdx].statIdx = iD;
+        ++iD;
+        --iA;
+    }
+
+finish:
+    for(auto i(iD); i < mStats.size(); ++i) ++(mMarks[mStats[i].markIdx].ctr);
+
+    mStats.resize(iD);
+    mItems.erase(mItems.begin() + iD, mItems.end());
+}
+
+int main()
+{
+    std::printf("%-8s | %-8s | %10s | %10s | %10s\n", "alive", "layout",
+        "count ms", "visit ms", "refresh ms");
+
+    for(auto aliveRate : {0.05f, 0.95f})
+    {
+        std::minstd_rand rng{1234u};
+        std::uniform_real_distribution<float> dist{0.f, 1.f};
+
+        std::vector<bool> kill(particleCount);
+        for(auto i(0u); i < particleCount; ++i)
+            kill[i] = dist(rng) >= aliveRate;
+
+        // Previous layout.
+        std::vector<OldStat> oldStats(particleCount);
+        std::vector<OldMark> oldMarks(particleCount);
+        std::vector<Particle> oldItems;
+        for(auto i(0u); i < particleCount; ++i)
+        {
+            oldStats[i] = {HIdx(i), !kill[i]};
+            oldMarks[i] = {HIdx(i), 0};
+            oldItems.emplace_back(int(i));
+        }
+
+        SizeT oldCount{0u};
+        auto oldCountMs(measure([&]
+            {
+                oldCount = 0;
+                for(const auto& s : oldStats) oldCount += s.alive;
+            }));
+
+        float oldSum{0.f};
+        auto oldVisitMs(measure([&]
+            {
+                for(auto i(0u); i < particleCount; ++i)
+                    if(oldStats[i].alive) oldSum += oldItems[i].x += 1.f;
+            }));
+
+        auto start(HRClock::now());
+        refreshOld(oldStats, oldMarks, oldItems);
+        auto oldRefreshMs(std::chrono::duration<double, std::milli>(
+            HRClock::now() - start).count());
+
+        // Packed bits.
+        HV hv;
+        std::vector<HV::Handle> handles;
+        for(auto i(0u); i < particleCount; ++i)
+            handles.emplace_back(hv.create(int(i)));
+        hv.refresh();
+
+        for(auto i(0u); i < particleCount; ++i)
+            if(kill[i]) handles[i].setDead();
+
+        SizeT newCount{0u};
+        auto newCountMs(measure([&]
+            {
+                newCount = hv.countAlive();
+            }));
+
+        float newSum{0.f};
+        auto newVisitMs(measure([&]
+            {
+                auto& items(hv.getItems());
+                hv.forEachAliveIdx([&items, &newSum](SizeT mI)
+                    {
+                        newSum += items[mI].x += 1.f;
+                    });
+            }));
+
+        start = HRClock::now();
+        hv.refresh();
+        auto newRefreshMs(std::chrono::duration<double, std::milli>(
+            HRClock::now() - start).count());
+
+        SSVU_ASSERT(oldCount == newCount);
+        SSVU_ASSERT(oldSum == newSum);
+        SSVU_ASSERT(hv.getSize() == oldItems.size());
+        for(auto i(0u); i < hv.getSize(); ++i)
+            SSVU_ASSERT(hv.getItems()[i].id == oldItems[i].id);
+
+        std::printf("%7.0f%% | %-8s | %10.3f | %10.3f | %10.3f\n",
+            aliveRate * 100.f, "flags", oldCountMs, oldVisitMs, oldRefreshMs);
+        std::printf("%7.0f%% | %-8s | %10.3f | %10.3f | %10.3f\n",
+            aliveRate * 100.f, "bits", newCountMs, newVisitMs, newRefreshMs);
+    }
+
+    return 0;
+}
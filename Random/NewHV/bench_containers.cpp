@@ -0,0 +1,352 @@
+// Copyright (c) 2013-2015 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+// Benchmark suite of the handle containers: `HVSingle`, `HVMulti`, the old
+// `HManager` and `std::vector` + `eraseRemoveIf`, with small and big items,
+// from 1k to 10M items. Every cycle creates the items (refreshing the
+// handle containers so that they are live), iterates them, kills a random
+// fraction, refreshes and dereferences the surviving handles in random
+// order. Seeds are fixed, and an untimed warmup cycle runs first.
+// `HManager` only runs up to 100k items, see `BenchHManager::maxItems`.
+//
+// Usage: `bench_containers [maxItems [output.csv]]`. The CSV (stdout by
+// default) has one row per container, item type, size and operation, with
+// the ns per operation and the operations per second.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <numeric>
+#include <random>
+#include <vector>
+#include "NewHV.hpp"
+#include "../Old/HManager.hpp"
+
+using ssvu::SizeT;
+using HRClock = std::chrono::high_resolution_clock;
+
+volatile int state{0};
+
+struct OSmall
+{
+    char k[16];
+    int myState{0};
+
+    inline OSmall() noexcept { ++state; }
+    inline ~OSmall() noexcept { ++state; }
+    inline void a() noexcept { ++myState; }
+};
+
+struct OBig
+{
+    char k[128];
+    int myState{0};
+
+    inline OBig() noexcept { ++state; }
+    inline ~OBig() noexcept { ++state; }
+    inline void a() noexcept { ++myState; }
+};
+
+struct Velocity
+{
+    float x{1.f}, y{1.f};
+};
+
+constexpr float killFraction{0.25f};
+constexpr SizeT itemsPerSize{10000000u};
+
+enum Op : SizeT
+{
+    OpCreate,
+    OpIterate,
+    OpKill,
+    OpRefresh,
+    OpDeref,
+    OpCount
+};
+
+constexpr const char* opNames[OpCount]{
+    "create", "iterate", "kill", "refresh", "deref"};
+
+// Indices, fixed for a given size: the items to kill, and the survivors in
+// the order their handles are dereferenced.
+struct Workload
+{
+    std::vector<SizeT> kills, derefs;
+
+    inline Workload(SizeT mCount)
+    {
+        std::vector<SizeT> idxs(mCount);
+        std::iota(idxs.begin(), idxs.end(), 0u);
+
+        std::mt19937 rng{12345u};
+        std::shuffle(idxs.begin(), idxs.end(), rng);
+
+        auto killCount(SizeT(mCount * killFraction));
+        kills.assign(idxs.begin(), idxs.begin() + killCount);
+        derefs.assign(idxs.begin() + killCount, idxs.end());
+        std::shuffle(derefs.begin(), derefs.end(), rng);
+    }
+};
+
+template <typename T>
+struct BenchHVSingle
+{
+    static constexpr const char* name{"HVSingle"};
+    static constexpr SizeT maxItems{itemsPerSize};
+    static constexpr bool hasDeref{true};
+
+    ssvu::HVSingle<T> hv;
+    std::vector<typename ssvu::HVSingle<T>::Handle> handles;
+
+    inline void create(SizeT mCount)
+    {
+        for(auto i(0u); i < mCount; ++i) handles.emplace_back(hv.create());
+        hv.refresh();
+    }
+
+    inline void iterate()
+    {
+        for(auto& o : hv) o.a();
+    }
+
+    inline void kill(const std::vector<SizeT>& mIdxs)
+    {
+        for(auto i : mIdxs) handles[i].setDead();
+    }
+
+    inline void refresh() { hv.refresh(); }
+
+    inline int deref(const std::vector<SizeT>& mIdxs)
+    {
+        int result{0};
+        for(auto i : mIdxs) result += handles[i]->myState;
+        return result;
+    }
+};
+
+template <typename T>
+struct BenchHVMulti
+{
+    static constexpr const char* name{"HVMulti"};
+    static constexpr SizeT maxItems{itemsPerSize};
+    static constexpr bool hasDeref{true};
+
+    ssvu::HVMulti<T, Velocity> hv;
+    std::vector<typename ssvu::HVMulti<T, Velocity>::Handle> handles;
+
+    inline void create(SizeT mCount)
+    {
+        for(auto i(0u); i < mCount; ++i) handles.emplace_back(hv.create());
+        hv.refresh();
+    }
+
+    inline void iterate()
+    {
+        auto& items(hv.template getArrayOf<T>());
+        for(auto i(0u); i < hv.getSize(); ++i) items[i].a();
+    }
+
+    inline void kill(const std::vector<SizeT>& mIdxs)
+    {
+        for(auto i : mIdxs) handles[i].setDead();
+    }
+
+    inline void refresh() { hv.refresh(); }
+
+    inline int deref(const std::vector<SizeT>& mIdxs)
+    {
+        int result{0};
+        for(auto i : mIdxs) result += handles[i].template get<T>().myState;
+        return result;
+    }
+};
+
+template <typename T>
+struct BenchHManager
+{
+    static constexpr const char* name{"HManager"};
+
+    // `refresh` looks for the next alive atom from every dead one: it is
+    // quadratic with randomly killed atoms.
+    static constexpr SizeT maxItems{100000u};
+    static constexpr bool hasDeref{true};
+
+    HManager<T> mgr;
+    std::vector<Handle<T>> handles;
+
+    inline void create(SizeT mCount)
+    {
+        for(auto i(0u); i < mCount; ++i) handles.emplace_back(mgr.create());
+        mgr.refresh();
+    }
+
+    inline void iterate()
+    {
+        mgr.forEach([](T& mO)
+            {
+                mO.a();
+            });
+    }
+
+    inline void kill(const std::vector<SizeT>& mIdxs)
+    {
+        for(auto i : mIdxs) handles[i].destroy();
+    }
+
+    inline void refresh() { mgr.refresh(); }
+
+    inline int deref(const std::vector<SizeT>& mIdxs)
+    {
+        int result{0};
+        for(auto i : mIdxs) result += handles[i]->myState;
+        return result;
+    }
+};
+
+template <typename T>
+struct BenchVector
+{
+    static constexpr const char* name{"vector+eraseRemoveIf"};
+    static constexpr SizeT maxItems{itemsPerSize};
+    static constexpr bool hasDeref{false};
+
+    struct Item : T
+    {
+        bool alive{true};
+    };
+
+    std::vector<Item> items;
+
+    inline void create(SizeT mCount)
+    {
+        for(auto i(0u); i < mCount; ++i) items.emplace_back();
+    }
+
+    inline void iterate()
+    {
+        for(auto& o : items) o.a();
+    }
+
+    // Items have not moved since `create`: indices are still valid.
+    inline void kill(const std::vector<SizeT>& mIdxs)
+    {
+        for(auto i : mIdxs) items[i].alive = false;
+    }
+
+    inline void refresh()
+    {
+        ssvu::eraseRemoveIf(items, [](const Item& mO)
+            {
+                return !mO.alive;
+            });
+    }
+
+    // No stable handles.
+    inline int deref(const std::vector<SizeT>&) { return 0; }
+};
+
+// Nanoseconds of every operation, summed over the timed cycles.
+template <typename TB>
+void runCycle(SizeT mCount, const Workload& mWorkload, double (&mNs)[OpCount],
+    int& mSink)
+{
+    TB b;
+
+    auto time([&mNs](Op mOp, const auto& mF)
+        {
+            auto start(HRClock::now());
+            mF();
+            auto end(HRClock::now());
+
+            mNs[mOp] +=
+                std::chrono::duration<double, std::nano>(end - start).count();
+        });
+
+    time(OpCreate, [&]
+        {
+            b.create(mCount);
+        });
+    time(OpIterate, [&]
+        {
+            b.iterate();
+        });
+    time(OpKill, [&]
+        {
+            b.kill(mWorkload.kills);
+        });
+    time(OpRefresh, [&]
+        {
+            b.refresh();
+        });
+    time(OpDeref, [&]
+        {
+            mSink += b.deref(mWorkload.derefs);
+        });
+}
+
+template <typename TB>
+void run(std::FILE* mOut, const char* mItemName, SizeT mCount,
+    const Workload& mWorkload)
+{
+    if(mCount > TB::maxItems) return;
+
+    double ns[OpCount]{}, warmupNs[OpCount]{};
+    int sink{0};
+
+    runCycle<TB>(mCount, mWorkload, warmupNs, sink);
+
+    auto cycles(std::max(SizeT(1u), itemsPerSize / mCount));
+    for(auto c(0u); c < cycles; ++c) runCycle<TB>(mCount, mWorkload, ns, sink);
+
+    SizeT opCounts[OpCount]{mCount, mCount, mWorkload.kills.size(), mCount,
+        mWorkload.derefs.size()};
+
+    for(auto op(0u); op < OpCount; ++op)
+    {
+        if(op == OpDeref && !TB::hasDeref) continue;
+
+        auto nsPerOp(ns[op] / (double(cycles) * opCounts[op]));
+        std::fprintf(mOut, "%s,%s,%zu,%s,%.3f,%.0f\n", TB::name, mItemName,
+            mCount, opNames[op], nsPerOp, 1e9 / nsPerOp);
+    }
+
+    std::fflush(mOut);
+    state = state + sink;
+}
+
+template <typename T>
+void runAll(std::FILE* mOut, const char* mItemName, SizeT mCount)
+{
+    Workload workload{mCount};
+
+    run<BenchHVSingle<T>>(mOut, mItemName, mCount, workload);
+    run<BenchHVMulti<T>>(mOut, mItemName, mCount, workload);
+    run<BenchHManager<T>>(mOut, mItemName, mCount, workload);
+    run<BenchVector<T>>(mOut, mItemName, mCount, workload);
+}
+
+int main(int argc, char** argv)
+{
+    SizeT maxItems{argc > 1 ? SizeT(std::atoll(argv[1])) : 10000000u};
+
+    auto out(argc > 2 ? std::fopen(argv[2], "w") : stdout);
+    if(out == nullptr)
+    {
+        std::fprintf(stderr, "cannot open %s\n", argv[2]);
+        return 1;
+    }
+
+    std::fprintf(out, "container,item,items,operation,ns_per_op,items_per_sec\n");
+
+    for(SizeT count{1000u}; count <= maxItems; count *= 10)
+    {
+        runAll<OSmall>(out, "small", count);
+        runAll<OBig>(out, "big", count);
+    }
+
+    if(out != stdout) std::fclose(out);
+    return 0;
+}
@@ -0,0 +1,98 @@
+// Copyright (c) 2013-2015 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+// Compares `refresh()` and `refreshParallel()` on 1M particles, killing 10%
+// and 50% of them between refreshes, and checks that both produce the same
+// layout and keep the surviving handles valid.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "NewHV.hpp"
+
+using namespace ssvu;
+
+struct Particle
+{
+    float x, y, vx, vy;
+    int id;
+
+    inline Particle(int mId) noexcept : x{0}, y{0}, vx{1}, vy{1}, id{mId} {}
+};
+
+using HV = HVSingle<Particle>;
+using HRClock = std::chrono::high_resolution_clock;
+
+constexpr SizeT particleCount{1000000u};
+
+template <typename TF>
+double fill(HV& mHV, std::vector<HV::Handle>& mHandles, float mDeathRate,
+    const TF& mRefresh)
+{
+    mHandles.clear();
+    for(auto i(0u); i < particleCount; ++i)
+        mHandles.emplace_back(mHV.create(int(i)));
+    mHV.refresh();
+
+    std::minstd_rand rng{1234u};
+    std::uniform_real_distribution<float> dist{0.f, 1.f};
+    for(auto& h : mHandles)
+        if(dist(rng) < mDeathRate) h.setDead();
+
+    auto start(HRClock::now());
+    mRefresh();
+    auto end(HRClock::now());
+
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+int main(int argc, char** argv)
+{
+    // Thread count, defaults to the hardware concurrency.
+    HVThreadPool pool{argc > 1 ? SizeT(std::atoi(argv[1]))
+                               : SizeT(std::thread::hardware_concurrency())};
+
+    std::printf("%zu threads\n", pool.getThreadCount());
+
+    for(auto deathRate : {0.1f, 0.5f})
+    {
+        HV sequential, parallel;
+        std::vector<HV::Handle> hSequential, hParallel;
+
+        auto msSequential(fill(sequential, hSequential, deathRate, [&]
+            {
+                sequential.refresh();
+            }));
+
+        auto msParallel(fill(parallel, hParallel, deathRate, [&]
+            {
+                parallel.refreshParallel(pool);
+            }));
+
+        SSVU_ASSERT(sequential.getSize() == parallel.getSize());
+        for(auto i(0u); i < sequential.getSize(); ++i)
+            SSVU_ASSERT(sequential.getItems()[i].id == parallel.getItems()[i].id);
+
+        for(auto i(0u); i < particleCount; ++i)
+        {
+            SSVU_ASSERT(hSequential[i].isAlive() == hParallel[i].isAlive());
+            if(hParallel[i].isAlive())
+                SSVU_ASSERT(hParallel[i]->id == int(i));
+        }
+
+        // Parallel iteration over the survivors.
+        parallel.forEachParallel(pool, [](Particle& mP)
+            {
+                mP.x += mP.vx;
+                mP.y += mP.vy;
+            });
+
+        std::printf("%2.0f%% dead: refresh %7.2f ms | refreshParallel %7.2f ms\n",
+            deathRate * 100.f, msSequential, msParallel);
+    }
+
+    return 0;
+}
@@ -0,0 +1,84 @@
+// Copyright (c) 2013-2015 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+
+// Resolves 1M handles, in random order, every "frame": through
+// `Handle::get`, through `resolveAll`, and through pointers cached by
+// `resolveAll` and revalidated with `getEpoch()`.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "NewHV.hpp"
+
+using namespace ssvu;
+
+struct Particle
+{
+    float x, y, vx, vy;
+    int id;
+
+    inline Particle(int mId) noexcept : x{0}, y{0}, vx{1}, vy{1}, id{mId} {}
+};
+
+using HV = HVSingle<Particle>;
+using HRClock = std::chrono::high_resolution_clock;
+
+constexpr SizeT particleCount{1000000u};
+constexpr SizeT frameCount{20u};
+
+template <typename TF>
+double measure(const TF& mF)
+{
+    auto start(HRClock::now());
+    for(auto f(0u); f < frameCount; ++f) mF();
+    auto end(HRClock::now());
+
+    return std::chrono::duration<double, std::nano>(end - start).count() /
+           (frameCount * particleCount);
+}
+
+int main()
+{
+    HV hv;
+    std::vector<HV::Handle> handles;
+    for(auto i(0u); i < particleCount; ++i)
+        handles.emplace_back(hv.create(int(i)));
+    hv.refresh();
+
+    std::shuffle(handles.begin(), handles.end(), std::minstd_rand{1234u});
+
+    long long sumGet{0}, sumResolve{0}, sumCached{0};
+
+    auto nsGet(measure([&]
+        {
+            for(auto& h : handles) sumGet += h->id;
+        }));
+
+    std::vector<Particle*> ptrs(particleCount);
+    auto nsResolve(measure([&]
+        {
+            hv.resolveAll(handles.data(), handles.size(), ptrs.data());
+            for(auto p : ptrs) sumResolve += p->id;
+        }));
+
+    auto cachedEpoch(hv.resolveAll(handles.data(), handles.size(), ptrs.data()));
+    auto nsCached(measure([&]
+        {
+            if(hv.getEpoch() != cachedEpoch)
+                cachedEpoch =
+                    hv.resolveAll(handles.data(), handles.size(), ptrs.data());
+
+            for(auto p : ptrs) sumCached += p->id;
+        }));
+
+    SSVU_ASSERT(sumGet == sumResolve && sumGet == sumCached);
+
+    std::printf("Handle::get        %6.2f ns/handle\n", nsGet);
+    std::printf("resolveAll         %6.2f ns/handle\n", nsResolve);
+    std::printf("cached, same epoch %6.2f ns/handle\n", nsCached);
+
+    return 0;
+}
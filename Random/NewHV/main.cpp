@@ -14,6 +14,20 @@ struct ST1
     ~ST1() { ssvu::lo("ST1 DTOR") << " \n"; }
 };
 
+// Neither default-constructible nor copyable
+struct MoveOnly
+{
+    int value;
+
+    explicit MoveOnly(int mValue) : value{mValue} {}
+
+    MoveOnly(const MoveOnly&) = delete;
+    MoveOnly& operator=(const MoveOnly&) = delete;
+
+    MoveOnly(MoveOnly&&) = default;
+    MoveOnly& operator=(MoveOnly&&) = default;
+};
+
 
 int main()
 {
@@ -116,6 +130,49 @@ int main()
             ssvu::lo("aaa") << x << "\n";
     }
 
+    {
+        HVSingle<MoveOnly> test;
+        test.refresh();
+
+        auto h0 = test.create(10);
+        test.createN(30, 20);
+        test.refresh();
+
+        SSVU_ASSERT(h0->value == 10);
+        SSVU_ASSERT(test.getItems()[30].value == 20);
+
+        h0.setDead();
+        test.refresh();
+
+        for(const auto& x : test) SSVU_ASSERT(x.value == 20);
+    }
+
+    {
+        HVMulti<MoveOnly, UPtr<std::string>> test;
+        test.refresh();
+
+        // Each tuple holds the arguments of one type: arguments are moved
+        // into the items.
+        auto h0 = test.create(std::piecewise_construct,
+            std::forward_as_tuple(10),
+            std::forward_as_tuple(makeUPtr<std::string>("h0 str")));
+
+        // `createN` copies its arguments: the tuples must hold copyable
+        // arguments.
+        test.createN(30, std::piecewise_construct, std::make_tuple(20),
+            std::make_tuple(nullptr));
+        test.refresh();
+
+        SSVU_ASSERT(h0.get<MoveOnly>().value == 10);
+        ssvu::lo("h0 str") << *h0.get<UPtr<std::string>>() << "\n";
+
+        h0.setDead();
+        test.refresh();
+
+        for(const auto& x : makeRange(
+                test.beginSingle<MoveOnly>(), test.endSingle<MoveOnly>()))
+            SSVU_ASSERT(x.value == 20);
+    }
 
     // h1.destroy();
     // test.refresh();
@@ -0,0 +1,223 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "./chains.hpp"
+
+#if __has_include(<ecst/thread_pool.hpp>)
+#include <ecst/thread_pool.hpp>
+#define LL_BENCH_ECST 1
+#endif
+
+// End-to-end latency of a 10-stage `then` chain and of a 64-wide `wait_all`,
+// on the work-stealing pool with inline continuations, and on pools that
+// post every continuation.
+
+constexpr std::size_t runs = 2000;
+constexpr std::size_t wide = 64;
+
+/// @brief Pool with a single locked FIFO queue, the design of
+/// `ecst::thread_pool`. Used as the baseline when ecst is not available.
+class locked_queue_pool
+{
+private:
+    std::vector<std::thread> _threads;
+    std::mutex _mutex;
+    std::condition_variable _cv;
+    std::deque<ll::task*> _queue;
+    bool _running{true};
+
+public:
+    explicit locked_queue_pool(
+        std::size_t n = std::thread::hardware_concurrency())
+    {
+        for(std::size_t i = 0; i < std::max(n, std::size_t(1)); ++i)
+        {
+            _threads.emplace_back([this] {
+                while(true)
+                {
+                    ll::task* t;
+
+                    {
+                        std::unique_lock<std::mutex> l{_mutex};
+                        _cv.wait(
+                            l, [this] { return !_running || !_queue.empty(); });
+
+                        if(_queue.empty()) return;
+
+                        t = _queue.front();
+                        _queue.pop_front();
+                    }
+
+                    (*t)();
+                }
+            });
+        }
+    }
+
+    ~locked_queue_pool()
+    {
+        {
+            std::lock_guard<std::mutex> l{_mutex};
+            _running = false;
+        }
+
+        _cv.notify_all();
+        for(auto& t : _threads) t.join();
+    }
+
+    void post(ll::task& t)
+    {
+        {
+            std::lock_guard<std::mutex> l{_mutex};
+            _queue.emplace_back(&t);
+        }
+
+        _cv.notify_one();
+    }
+
+    auto concurrency() const noexcept
+    {
+        return _threads.size();
+    }
+};
+
+#ifdef LL_BENCH_ECST
+/// @brief Posts tasks through the `ecst::thread_pool` closure interface.
+struct ecst_executor
+{
+    ecst::thread_pool _p;
+
+    void post(ll::task& t)
+    {
+        _p.post([&t] { t(); });
+    }
+
+    auto concurrency() const noexcept
+    {
+        return std::thread::hardware_concurrency();
+    }
+};
+#endif
+
+using hr_clock = std::chrono::high_resolution_clock;
+
+struct stage
+{
+    std::atomic<int>& _ctr;
+
+    void operator()() const
+    {
+        _ctr.fetch_add(1, std::memory_order_relaxed);
+    }
+};
+
+/// @brief `wait_all` requires a distinct type per callable object.
+template <std::size_t I>
+struct branch : stage
+{
+};
+
+/// @brief Starts `chain` `runs` times, waiting for `done` every time, and
+/// prints the mean latency.
+template <typename TChain>
+void measure(const char* title, TChain& chain, std::atomic<bool>& done)
+{
+    std::vector<double> us;
+    us.reserve(runs);
+
+    for(std::size_t i = 0; i < runs; ++i)
+    {
+        done.store(false, std::memory_order_relaxed);
+
+        auto start = hr_clock::now();
+        chain.start();
+
+        while(!done.load(std::memory_order_acquire))
+        {
+            std::this_thread::yield();
+        }
+
+        auto end = hr_clock::now();
+        us.emplace_back(
+            std::chrono::duration<double, std::micro>(end - start).count());
+    }
+
+    std::sort(us.begin(), us.end());
+
+    double mean = 0;
+    for(auto x : us) mean += x;
+    mean /= us.size();
+
+    std::printf("%-40s | mean %8.2f us | median %8.2f us\n", title, mean,
+        us[us.size() / 2]);
+}
+
+template <std::size_t... Is>
+auto make_wide_chain(ll::context& ctx, std::atomic<int>& ctr,
+    std::atomic<bool>& done, std::index_sequence<Is...>)
+{
+    return ctx.build(stage{ctr})
+        .wait_all(branch<Is>{{ctr}}...)
+        .then([&done] { done.store(true, std::memory_order_release); });
+}
+
+void run(const char* title, ll::context& ctx)
+{
+    std::atomic<int> ctr{0};
+    std::atomic<bool> done{false};
+
+    auto chain10 = ctx.build(stage{ctr})
+                       .then(stage{ctr})
+                       .then(stage{ctr})
+                       .then(stage{ctr})
+                       .then(stage{ctr})
+                       .then(stage{ctr})
+                       .then(stage{ctr})
+                       .then(stage{ctr})
+                       .then(stage{ctr})
+                       .then(stage{ctr})
+                       .then([&done] {
+                           done.store(true, std::memory_order_release);
+                       });
+
+    auto chain_wide =
+        make_wide_chain(ctx, ctr, done, std::make_index_sequence<wide>{});
+
+    std::printf("%s\n", title);
+    measure("    10-stage then", chain10, done);
+    measure("    64-wide wait_all", chain_wide, done);
+}
+
+template <typename TExecutor>
+void run_with(const char* title, bool inline_continuations)
+{
+    TExecutor e;
+    ll::context ctx{e};
+    ctx._inline_continuations = inline_continuations;
+
+    run(title, ctx);
+}
+
+int main()
+{
+    std::printf("hardware_concurrency: %u\n\n",
+        std::thread::hardware_concurrency());
+
+    run_with<ll::work_stealing_pool>("work_stealing_pool, inline", true);
+    run_with<ll::work_stealing_pool>("work_stealing_pool, posted", false);
+    run_with<locked_queue_pool>("locked_queue_pool, posted", false);
+
+#ifdef LL_BENCH_ECST
+    run_with<ecst_executor>("ecst::thread_pool, posted", false);
+#endif
+
+    return 0;
+}
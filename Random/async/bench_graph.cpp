@@ -0,0 +1,127 @@
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <vector>
+
+#include "./graph.hpp"
+
+// Re-runs a 200-node frame graph (10 layers of 20 nodes, each depending on
+// 1 to 3 nodes of the previous layer) 10000 times. Reports the overhead per
+// execution and per node, against running the same bodies in topological
+// order on one thread, and the heap allocations per execution.
+
+static std::atomic<std::size_t> allocations{0};
+
+void* operator new(std::size_t n)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+
+    if(auto p = std::malloc(n)) return p;
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+constexpr int layers = 10;
+constexpr int width = 20;
+constexpr int node_count = layers * width;
+constexpr int runs = 10000;
+
+using hr_clock = std::chrono::high_resolution_clock;
+
+/// @brief Small amount of work per node, that the compiler cannot elide.
+struct body
+{
+    std::uint64_t* _slot;
+
+    void operator()() const
+    {
+        auto x = *_slot;
+        for(int i = 0; i < 16; ++i) x = x * 6364136223846793005ull + 1;
+        *_slot = x;
+    }
+};
+
+template <typename TF>
+double measure_us(TF&& run_once)
+{
+    for(int i = 0; i < 100; ++i) run_once();
+
+    auto start = hr_clock::now();
+    for(int i = 0; i < runs; ++i) run_once();
+    auto end = hr_clock::now();
+
+    return std::chrono::duration<double, std::micro>(end - start).count() /
+           runs;
+}
+
+int main()
+{
+    ll::pool p;
+    ll::context ctx{p};
+
+    // One cache line per node, so that the bodies do not false-share.
+    std::vector<std::uint64_t> slots(node_count * 8, 1);
+
+    std::mt19937 rng{1234};
+    ll::graph g{ctx};
+
+    std::vector<body> serial;
+
+    for(int l = 0; l < layers; ++l)
+    {
+        for(int i = 0; i < width; ++i)
+        {
+            body b{&slots[(l * width + i) * 8]};
+            serial.emplace_back(b);
+
+            if(l == 0)
+            {
+                g.add(b);
+                continue;
+            }
+
+            auto prev = std::size_t((l - 1) * width);
+            auto pick = [&] { return prev + rng() % width; };
+
+            switch(rng() % 3)
+            {
+                case 0: g.add(b, {pick()}); break;
+                case 1: g.add(b, {pick(), pick()}); break;
+                default: g.add(b, {pick(), pick(), pick()}); break;
+            }
+        }
+    }
+
+    auto serial_us = measure_us([&] {
+        for(auto& b : serial) b();
+    });
+
+    auto a0 = allocations.load();
+    auto graph_us = measure_us([&] { g.run(); });
+    auto a1 = allocations.load();
+
+    std::printf("%d nodes, %d executions, %zu workers\n", int(g.size()), runs,
+        std::size_t(ctx.concurrency()));
+
+    std::printf("serial bodies | %8.2f us/execution\n", serial_us);
+
+    std::printf("graph         | %8.2f us/execution | %6.1f ns/node "
+                "overhead | %.2f allocations/execution\n",
+        graph_us, (graph_us - serial_us) * 1000 / node_count,
+        double(a1 - a0) / (runs + 100));
+
+    return 0;
+}
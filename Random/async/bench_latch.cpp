@@ -0,0 +1,93 @@
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "./latch.hpp"
+#include "./locking_latch.hpp"
+
+// N threads count down a shared latch that the main thread waits on,
+// repeated `rounds` times: compares the `mutex` + `condition_variable`
+// latch against the atomic one. Also measures the phase rate of
+// `ll::barrier` with N threads.
+
+constexpr int rounds = 20000;
+
+using hr_clock = std::chrono::high_resolution_clock;
+
+template <typename TLatch>
+double countdown_us(int n)
+{
+    // The latches are created up front, so that the thread startup cost
+    // stays out of the measurement: the workers count down every latch in
+    // order while the main thread waits on each of them.
+    std::vector<std::unique_ptr<TLatch>> latches;
+    latches.reserve(rounds);
+
+    for(int r = 0; r < rounds; ++r)
+    {
+        latches.emplace_back(std::make_unique<TLatch>(n));
+    }
+
+    std::vector<std::thread> threads;
+    threads.reserve(n);
+
+    auto start = hr_clock::now();
+
+    for(int i = 0; i < n; ++i)
+    {
+        threads.emplace_back([&latches] {
+            for(auto& l : latches) l->count_down();
+        });
+    }
+
+    for(auto& l : latches) l->wait();
+
+    auto end = hr_clock::now();
+
+    for(auto& t : threads) t.join();
+
+    return std::chrono::duration<double, std::micro>(end - start).count() /
+           rounds;
+}
+
+double barrier_phases_per_ms(int n)
+{
+    constexpr int phases = 20000;
+
+    ll::barrier b{n};
+    std::vector<std::thread> threads;
+
+    auto start = hr_clock::now();
+
+    for(int i = 0; i < n; ++i)
+    {
+        threads.emplace_back([&b] {
+            for(int p = 0; p < phases; ++p) b.arrive_and_wait();
+        });
+    }
+
+    for(auto& t : threads) t.join();
+
+    auto end = hr_clock::now();
+    return phases /
+           std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+int main()
+{
+    std::printf("%8s | %16s | %16s | %16s\n", "threads", "locking_latch",
+        "latch", "barrier");
+
+    for(int n : {1, 2, 4, 8, 16})
+    {
+        auto locking = countdown_us<ll::locking_latch>(n);
+        auto atomic = countdown_us<ll::latch>(n);
+
+        std::printf("%8d | %13.2f us | %13.2f us | %9.1f phases/ms\n", n,
+            locking, atomic, barrier_phases_per_ms(n));
+    }
+
+    return 0;
+}
@@ -0,0 +1,155 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <thread>
+#include <tuple>
+
+#include "./chains.hpp"
+
+// Counts heap allocations per execution of a value-passing chain, and
+// compares its latency against posting closures that capture the values
+// (the approach of `value_passing.cpp`), joined through a `shared_ptr`.
+
+static std::atomic<std::size_t> allocations{0};
+
+void* operator new(std::size_t n)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+
+    if(auto p = std::malloc(n)) return p;
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+constexpr std::size_t runs = 10000;
+
+struct vec2
+{
+    float _x, _y;
+};
+
+using hr_clock = std::chrono::high_resolution_clock;
+
+template <typename TF>
+void measure(const char* title, TF&& run_once)
+{
+    // Warm up: lets the pool grow its deques and the thread-locals
+    // initialize.
+    for(std::size_t i = 0; i < 100; ++i) run_once();
+
+    auto a0 = allocations.load();
+    auto start = hr_clock::now();
+
+    for(std::size_t i = 0; i < runs; ++i) run_once();
+
+    auto end = hr_clock::now();
+    auto a1 = allocations.load();
+
+    std::printf("%-28s | %8.2f us | %6.2f allocations/execution (%zu total)\n",
+        title,
+        std::chrono::duration<double, std::micro>(end - start).count() / runs,
+        double(a1 - a0) / runs, a1 - a0);
+}
+
+void wait_for_flag(std::atomic<bool>& done)
+{
+    while(!done.load(std::memory_order_acquire))
+    {
+        std::this_thread::yield();
+    }
+
+    done.store(false, std::memory_order_relaxed);
+}
+
+int main()
+{
+    ll::pool p;
+    ll::context ctx{p};
+
+    std::atomic<bool> done{false};
+    float sink = 0.f;
+
+    auto chain =
+        ctx.build([] { return 10; })
+            .then([](int x) { return x * 0.5; })
+            .wait_all([](double x) { return int(x) + 1; },
+                [](double x) { return float(x) * 2.f; },
+                [](double x) {
+                    return vec2{float(x), float(x)};
+                })
+            .then([&sink, &done](std::tuple<int, float, vec2> t) {
+                sink += std::get<0>(t) + std::get<1>(t) + std::get<2>(t)._y;
+                done.store(true, std::memory_order_release);
+            });
+
+    measure("ll chain", [&] {
+        chain.start();
+        wait_for_flag(done);
+    });
+
+    if(sink != (6 + 10 + 5) * float(runs + 100))
+    {
+        std::printf("wrong result: %f\n", sink);
+        return 1;
+    }
+
+    measure("posted closures", [&] {
+        p.post([&] {
+            auto x0 = 10;
+
+            p.post([&, x0] {
+                auto x1 = x0 * 0.5;
+                auto results =
+                    std::make_shared<std::tuple<int, float, vec2>>();
+                auto ctr = std::make_shared<std::atomic<int>>(3);
+
+                auto join = [&, results, ctr] {
+                    if(--*ctr != 0) return;
+
+                    auto& t = *results;
+                    sink +=
+                        std::get<0>(t) + std::get<1>(t) + std::get<2>(t)._y;
+                    done.store(true, std::memory_order_release);
+                };
+
+                p.post([=] {
+                    std::get<0>(*results) = int(x1) + 1;
+                    join();
+                });
+
+                p.post([=] {
+                    std::get<1>(*results) = float(x1) * 2.f;
+                    join();
+                });
+
+                p.post([=] {
+                    std::get<2>(*results) = vec2{float(x1), float(x1)};
+                    join();
+                });
+            });
+        });
+
+        wait_for_flag(done);
+    });
+
+    auto results = ll::wait_until_complete(
+        ctx.build([] { return 1; }).then([](int x) { return x + 1; }),
+        ctx.build([] { return 2.f; }));
+
+    std::printf("wait_until_complete: %d %f\n", std::get<0>(results),
+        std::get<1>(results));
+
+    return 0;
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <atomic>
+
+namespace ll
+{
+    class cancellation_source;
+
+    /// @brief Observes the flag of a `cancellation_source`, which must
+    /// outlive it. Default-constructed tokens are never cancelled.
+    class cancellation_token
+    {
+    private:
+        friend class cancellation_source;
+
+        const std::atomic<bool>* _flag{nullptr};
+
+        explicit cancellation_token(const std::atomic<bool>& flag) noexcept
+            : _flag{&flag}
+        {
+        }
+
+    public:
+        cancellation_token() = default;
+
+        /// @brief Cancellation is cooperative and advisory: a relaxed load is
+        /// enough, as the flag never goes back to `false` while observed.
+        bool cancelled() const noexcept
+        {
+            return _flag != nullptr && _flag->load(std::memory_order_relaxed);
+        }
+    };
+
+    /// @brief Owns a cancellation flag. Does not allocate.
+    class cancellation_source
+    {
+    private:
+        std::atomic<bool> _flag{false};
+
+    public:
+        cancellation_source() = default;
+
+        cancellation_source(const cancellation_source&) = delete;
+        cancellation_source& operator=(const cancellation_source&) = delete;
+
+        void request_cancellation() noexcept
+        {
+            _flag.store(true, std::memory_order_relaxed);
+        }
+
+        bool cancellation_requested() const noexcept
+        {
+            return _flag.load(std::memory_order_relaxed);
+        }
+
+        auto token() const noexcept
+        {
+            return cancellation_token{_flag};
+        }
+    };
+}
@@ -0,0 +1,1177 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <experimental/tuple>
+#include <functional>
+#include <iterator>
+#include <optional>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <vrm/core/utility_macros.hpp>
+
+#include "./cancellation.hpp"
+#include "./executor.hpp"
+#include "./latch.hpp"
+
+namespace ll
+{
+    using pool = work_stealing_pool;
+
+    inline void sleep_ms(int ms)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+    }
+
+    template <typename T>
+    inline void print_sleep_ms(int ms, const T& x)
+    {
+        std::puts(x);
+        sleep_ms(ms);
+    }
+
+    template <typename TTuple, typename TF>
+    void for_tuple(TTuple&& t, TF&& f)
+    {
+        std::experimental::apply(
+            [&f](auto&&... xs) { (f(FWD(xs)), ...); }, FWD(t));
+    }
+
+    /// @brief Result of a node whose callable object returns `void`, and
+    /// input of the first node.
+    struct nothing_t
+    {
+    };
+
+    constexpr nothing_t nothing{};
+
+    /// @brief Calls `f(x)`, or `f()` if `x` is `nothing`.
+    template <typename TF, typename T>
+    decltype(auto) call_ignoring_nothing(TF&& f, T&& x)
+    {
+        if constexpr(std::is_same<std::decay_t<T>, nothing_t>{})
+        {
+            return f();
+        }
+        else
+        {
+            return f(FWD(x));
+        }
+    }
+
+    /// @brief Like `call_ignoring_nothing`, but returns `nothing` instead of
+    /// `void`. The result is always returned by value.
+    template <typename TF, typename T>
+    auto with_void_to_nothing(TF&& f, T&& x)
+    {
+        using return_type = decltype(call_ignoring_nothing(FWD(f), FWD(x)));
+
+        if constexpr(std::is_same<return_type, void>{})
+        {
+            call_ignoring_nothing(FWD(f), FWD(x));
+            return nothing;
+        }
+        else
+        {
+            return call_ignoring_nothing(FWD(f), FWD(x));
+        }
+    }
+
+    /// @brief Type stored by a node running `TF` on an input of type `T`.
+    template <typename TF, typename T>
+    using continuation_result_t = decltype(
+        with_void_to_nothing(std::declval<TF&>(), std::declval<T>()));
+
+    struct context
+    {
+        /// @brief Maximum number of continuations run inline on top of each
+        /// other on the same thread, before falling back to posting.
+        static constexpr int max_inline_depth = 64;
+
+        executor_ref _executor;
+
+        /// @brief If `false`, every continuation is posted to the executor.
+        bool _inline_continuations{true};
+
+        template <typename TExecutor>
+        context(TExecutor& e) : _executor{e}
+        {
+        }
+
+        static int& inline_depth() noexcept
+        {
+            thread_local int result{0};
+            return result;
+        }
+
+        void post(task& t)
+        {
+            _executor.post(t);
+        }
+
+        /// @brief Runs `*t` (if any) on the calling thread, as the work that
+        /// completed on it is the only predecessor of `*t`. Posts it instead
+        /// if the stack is already deep.
+        void continue_with(task* t)
+        {
+            if(t == nullptr) return;
+
+            auto& depth = inline_depth();
+            if(!_inline_continuations || depth >= max_inline_depth)
+            {
+                post(*t);
+                return;
+            }
+
+            ++depth;
+            (*t)();
+            --depth;
+        }
+
+        auto concurrency() const
+        {
+            return _executor.concurrency();
+        }
+
+        template <typename TF>
+        auto build(TF&& f);
+    };
+
+    struct base_node
+    {
+        context& _ctx;
+        base_node(context& ctx) noexcept : _ctx{ctx}
+        {
+        }
+    };
+
+    /// @brief Scheduling state of a node, set when its chain is started.
+    /// @details Chains are stored by the caller, so nodes have stable
+    /// addresses once started: tasks point directly to them, and starting a
+    /// chain does not allocate.
+    struct node_tasks
+    {
+        /// @brief Task that runs this node.
+        task _entry;
+
+        /// @brief Entry task of the next node, `nullptr` for the last one.
+        task* _next{nullptr};
+    };
+
+    template <typename TNode>
+    void link(TNode& n) noexcept
+    {
+        n._entry = n.entry_task();
+        n._next = nullptr;
+    }
+
+    /// @brief Makes every node continue with the following one.
+    template <typename TNode, typename TNext, typename... TNodes>
+    void link(TNode& n, TNext& next, TNodes&... ns) noexcept
+    {
+        n._entry = n.entry_task();
+        n._next = &next._entry;
+        link(next, ns...);
+    }
+
+    struct root : base_node
+    {
+        using result_type = nothing_t;
+
+        nothing_t _result;
+
+        /// @brief Checked by every node of the chain before running.
+        cancellation_token _token;
+
+        using base_node::base_node;
+
+        auto& result() & noexcept
+        {
+            return _result;
+        }
+
+        template <typename TNode, typename... TNodes>
+        void start(TNode& n, TNodes&... ns) &
+        {
+            link(n, ns...);
+            n.execute();
+        }
+
+        auto& ctx() & noexcept
+        {
+            return this->_ctx;
+        }
+
+        const auto& ctx() const & noexcept
+        {
+            return this->_ctx;
+        }
+
+        auto& token() & noexcept
+        {
+            return _token;
+        }
+    };
+
+    template <typename TParent>
+    struct parent_holder
+    {
+        TParent _p;
+
+        template <typename TParentFwd>
+        parent_holder(TParentFwd&& p) : _p{FWD(p)}
+        {
+        }
+    };
+
+    template <typename TParent>
+    struct child_of : parent_holder<TParent>, node_tasks
+    {
+        using parent_holder<TParent>::parent_holder;
+
+        auto& parent() & noexcept
+        {
+            return this->_p;
+        }
+
+        const auto& parent() const & noexcept
+        {
+            return this->_p;
+        }
+
+        auto parent() && noexcept
+        {
+            return std::move(this->_p);
+        }
+
+        auto& ctx() & noexcept
+        {
+            return this->_p.ctx();
+        }
+
+        const auto& ctx() const & noexcept
+        {
+            return this->_p.ctx();
+        }
+
+        auto& token() & noexcept
+        {
+            return this->_p.token();
+        }
+
+        /// @brief Makes the whole chain observe `t`. Once cancelled, nodes
+        /// skip their work (leaving their result empty) and only pass
+        /// control down to the `finally` nodes.
+        void cancel_with(cancellation_token t) & noexcept
+        {
+            token() = t;
+        }
+
+        bool cancelled() & noexcept
+        {
+            return token().cancelled();
+        }
+    };
+
+    template <typename TParent, typename TF>
+    struct node_finally;
+
+    template <typename TParent, typename TRange, typename TF>
+    struct node_for_each;
+
+    template <typename TParent, typename TRange, typename T, typename TOp>
+    struct node_reduce;
+
+    /// @brief Runs `TF` on the result of its parent, which is moved in.
+    template <typename TParent, typename TF>
+    struct node_then : child_of<TParent>, TF
+    {
+        using this_type = node_then<TParent, TF>;
+        using input_type = typename std::decay_t<TParent>::result_type;
+        using result_type = continuation_result_t<TF, input_type&&>;
+
+        /// @brief Stored inline: passing values down a chain never
+        /// allocates.
+        std::optional<result_type> _result;
+
+        auto& as_f() noexcept
+        {
+            return static_cast<TF&>(*this);
+        }
+
+        template <typename TParentFwd, typename TFFwd>
+        node_then(TParentFwd&& p, TFFwd&& f)
+            : child_of<TParent>{FWD(p)}, TF{FWD(f)}
+        {
+        }
+
+        auto entry_task() & noexcept
+        {
+            return task{[](void* self) { static_cast<this_type*>(self)->run(); },
+                this};
+        }
+
+        /// @details Once the body has run, the chain may be complete and
+        /// restarted by another thread: the node is not touched anymore.
+        void run() &
+        {
+            auto& ctx = this->ctx();
+            auto next = this->_next;
+
+            // A cancelled parent leaves its result empty: cancellation is
+            // monotonic, so this node sees it as well.
+            if(!this->cancelled())
+            {
+                _result.emplace(with_void_to_nothing(
+                    as_f(), std::move(this->parent().result())));
+            }
+            else
+            {
+                _result.reset();
+            }
+
+            ctx.continue_with(next);
+        }
+
+        /// @brief Result of the last run. The chain must be complete and
+        /// not cancelled.
+        auto& result() & noexcept
+        {
+            return *_result;
+        }
+
+        bool has_result() const noexcept
+        {
+            return _result.has_value();
+        }
+
+        auto execute() &
+        {
+            this->ctx().post(this->_entry);
+        }
+
+        template <typename TCont>
+        auto then(TCont&& cont) &&
+        {
+            return node_then<this_type, TCont>{std::move(*this), FWD(cont)};
+        }
+
+        template <typename TCont>
+        auto then(TCont&& cont) &
+        {
+            return node_then<this_type&, TCont>{*this, FWD(cont)};
+        }
+
+        template <typename... TConts>
+        auto wait_all(TConts&&... cont) &&;
+
+        template <typename TRange, typename TCont>
+        auto then_for_each(TRange&& range, TCont&& cont) &&
+        {
+            return node_for_each<this_type, TRange, TCont>{
+                std::move(*this), FWD(range), FWD(cont)};
+        }
+
+        template <typename TRange, typename T, typename TOp>
+        auto then_reduce(TRange&& range, T&& init, TOp&& op) &&
+        {
+            return node_reduce<this_type, TRange, std::decay_t<T>, TOp>{
+                std::move(*this), FWD(range), FWD(init), FWD(op)};
+        }
+
+        template <typename TCont>
+        auto finally(TCont&& cont) &&
+        {
+            return node_finally<this_type, TCont>{std::move(*this), FWD(cont)};
+        }
+
+        template <typename TCont>
+        auto finally(TCont&& cont) &
+        {
+            return node_finally<this_type&, TCont>{*this, FWD(cont)};
+        }
+
+        template <typename... TNodes>
+        auto start(TNodes&... ns) &
+        {
+            this->parent().start(*this, ns...);
+        }
+    };
+
+    template <typename T>
+    struct movable_atomic : std::atomic<T>
+    {
+        using base_type = std::atomic<T>;
+        using base_type::base_type;
+
+        movable_atomic(movable_atomic&& r) : base_type{r.load()}
+        {
+        }
+
+        movable_atomic& operator=(movable_atomic&& r)
+        {
+            static_cast<base_type&>(*this).store(r.load());
+            return *this;
+        }
+    };
+
+    /// @brief Runs every `TFs` in parallel on the result of its parent,
+    /// which is shared. The result is a `std::tuple` of their results.
+    template <typename TParent, typename... TFs>
+    struct node_wait_all : child_of<TParent>, TFs...
+    {
+        using this_type = node_wait_all<TParent, TFs...>;
+        using input_type = typename std::decay_t<TParent>::result_type;
+
+        template <typename TF>
+        using branch_result_t = continuation_result_t<TF, const input_type&>;
+
+        static constexpr bool all_void =
+            (std::is_same<branch_result_t<TFs>, nothing_t>{} && ...);
+
+        /// @brief `nothing_t` if every branch returns `void`.
+        using result_type = std::conditional_t<all_void, nothing_t,
+            std::tuple<branch_result_t<TFs>...>>;
+
+        static constexpr auto branch_count = sizeof...(TFs);
+
+        /// @brief Result of every branch, filled concurrently.
+        std::tuple<std::optional<branch_result_t<TFs>>...> _partials;
+
+        std::optional<result_type> _result;
+
+        movable_atomic<int> _ctr{branch_count};
+
+        /// @brief One task per callable object.
+        std::array<task, branch_count> _branches;
+
+        template <typename TParentFwd, typename... TFFwds>
+        node_wait_all(TParentFwd&& p, TFFwds&&... fs)
+            : child_of<TParent>{FWD(p)}, TFs{FWD(fs)}...
+        {
+        }
+
+        template <std::size_t I>
+        void run_branch() &
+        {
+            using f_type = std::tuple_element_t<I, std::tuple<TFs...>>;
+            auto& ctx = this->ctx();
+            auto next = this->_next;
+
+            if(!this->cancelled())
+            {
+                const auto& input = this->parent().result();
+                std::get<I>(_partials).emplace(
+                    with_void_to_nothing(static_cast<f_type&>(*this), input));
+            }
+
+            // The decrement publishes the partial result to the last branch.
+            if(--_ctr == 0)
+            {
+                gather(std::make_index_sequence<branch_count>{});
+                ctx.continue_with(next);
+            }
+        }
+
+        /// @brief Builds the result, unless a branch was skipped because of
+        /// cancellation.
+        template <std::size_t... Is>
+        void gather(std::index_sequence<Is...>) &
+        {
+            _result.reset();
+            if(!(std::get<Is>(_partials).has_value() && ...)) return;
+
+            if constexpr(all_void)
+            {
+                _result.emplace();
+            }
+            else
+            {
+                _result.emplace(std::move(*std::get<Is>(_partials))...);
+            }
+        }
+
+        /// @brief Result of the last run. The chain must be complete and
+        /// not cancelled.
+        auto& result() & noexcept
+        {
+            return *_result;
+        }
+
+        bool has_result() const noexcept
+        {
+            return _result.has_value();
+        }
+
+        template <std::size_t... Is>
+        void set_branches(std::index_sequence<Is...>) & noexcept
+        {
+            _branches = {{task{[](void* self) {
+                static_cast<this_type*>(self)->template run_branch<Is>();
+            },
+                this}...}};
+        }
+
+        auto entry_task() & noexcept
+        {
+            return task{[](void* self) { static_cast<this_type*>(self)->run(); },
+                this};
+        }
+
+        /// @brief Posts all the branches but the first one, which runs
+        /// inline.
+        void run() &
+        {
+            if(this->cancelled())
+            {
+                _result.reset();
+                this->ctx().continue_with(this->_next);
+                return;
+            }
+
+            std::experimental::apply(
+                [](auto&... xs) { (xs.reset(), ...); }, _partials);
+
+            _ctr = branch_count;
+            set_branches(std::make_index_sequence<branch_count>{});
+
+            for(std::size_t i = 1; i < branch_count; ++i)
+            {
+                this->ctx().post(_branches[i]);
+            }
+
+            _branches[0]();
+        }
+
+        auto execute() &
+        {
+            this->ctx().post(this->_entry);
+        }
+
+        template <typename TCont>
+        auto then(TCont&& cont) &
+        {
+            return node_then<this_type&, TCont>{*this, FWD(cont)};
+        }
+
+        template <typename TCont>
+        auto then(TCont&& cont) &&
+        {
+            return node_then<this_type, TCont>{std::move(*this), FWD(cont)};
+        }
+
+        template <typename TRange, typename TCont>
+        auto then_for_each(TRange&& range, TCont&& cont) &&
+        {
+            return node_for_each<this_type, TRange, TCont>{
+                std::move(*this), FWD(range), FWD(cont)};
+        }
+
+        template <typename TRange, typename T, typename TOp>
+        auto then_reduce(TRange&& range, T&& init, TOp&& op) &&
+        {
+            return node_reduce<this_type, TRange, std::decay_t<T>, TOp>{
+                std::move(*this), FWD(range), FWD(init), FWD(op)};
+        }
+
+        template <typename TCont>
+        auto finally(TCont&& cont) &&
+        {
+            return node_finally<this_type, TCont>{std::move(*this), FWD(cont)};
+        }
+
+        template <typename TCont>
+        auto finally(TCont&& cont) &
+        {
+            return node_finally<this_type&, TCont>{*this, FWD(cont)};
+        }
+
+        template <typename... TNodes>
+        auto start(TNodes&... ns) &
+        {
+            this->parent().start(*this, ns...);
+        }
+    };
+
+    /// @brief Splits the indices `[0, size)` of a range into chunks, claimed
+    /// by up to `concurrency` participants: the thread running the node, and
+    /// one task posted to the executor once per other participant.
+    /// @details The remaining-counter tracks participants, not chunks: a
+    /// posted task that finds no chunk left still checks out, so that no
+    /// task touches the node after it continued.
+    struct chunked_range
+    {
+        /// @brief More chunks than participants, to balance uneven chunks.
+        static constexpr std::size_t chunks_per_participant = 4;
+
+        std::size_t _size{0};
+        std::size_t _chunk_size{1};
+        std::size_t _chunk_count{0};
+
+        movable_atomic<std::size_t> _next_chunk{0};
+        movable_atomic<std::size_t> _remaining{0};
+
+        /// @brief Posted once per participant but the first.
+        task _participant;
+
+        /// @brief Resets the counters for a range of `size` elements.
+        /// Returns the number of participants.
+        std::size_t prepare(std::size_t size, std::size_t concurrency) noexcept
+        {
+            auto participants =
+                std::max(std::size_t(1), std::min(concurrency, size));
+
+            _size = size;
+            _chunk_size = std::max(std::size_t(1),
+                size / (participants * chunks_per_participant));
+            _chunk_count = (size + _chunk_size - 1) / _chunk_size;
+
+            _next_chunk = 0;
+            _remaining = participants;
+
+            return participants;
+        }
+
+        /// @brief Calls `f(chunk, begin, end)` on chunks until none is left.
+        template <typename TF>
+        void claim_chunks(TF&& f)
+        {
+            for(auto i = _next_chunk++; i < _chunk_count; i = _next_chunk++)
+            {
+                auto begin = i * _chunk_size;
+                f(i, begin, std::min(begin + _chunk_size, _size));
+            }
+        }
+
+        /// @brief Returns `true` for the last participant. The decrement
+        /// publishes the work of the others to it.
+        bool check_out() noexcept
+        {
+            return --_remaining == 0;
+        }
+
+        /// @brief Posts the other participants, then runs the first one
+        /// inline.
+        template <typename TNode>
+        void start(TNode& n, std::size_t participants)
+        {
+            _participant = task{[](void* self) {
+                static_cast<TNode*>(self)->run_participant();
+            },
+                &n};
+
+            for(std::size_t i = 1; i < participants; ++i)
+            {
+                n.ctx().post(_participant);
+            }
+
+            n.run_participant();
+        }
+    };
+
+    template <typename TRange>
+    constexpr void assert_random_access_range() noexcept
+    {
+        using iterator_type =
+            decltype(std::begin(std::declval<std::decay_t<TRange>&>()));
+
+        static_assert(
+            std::is_base_of<std::random_access_iterator_tag,
+                typename std::iterator_traits<
+                    iterator_type>::iterator_category>{},
+            "chunked nodes require a random access range");
+    }
+
+    /// @brief Runs `TF` on every element of a range, in parallel chunks.
+    /// The result of the parent is ignored.
+    /// @details Ranges passed as lvalues are referenced, and their size is
+    /// read every time the node runs.
+    template <typename TParent, typename TRange, typename TF>
+    struct node_for_each : child_of<TParent>, TF
+    {
+        using this_type = node_for_each<TParent, TRange, TF>;
+        using result_type = nothing_t;
+
+        std::optional<result_type> _result;
+
+        TRange _range;
+        chunked_range _chunks;
+
+        auto& as_f() noexcept
+        {
+            return static_cast<TF&>(*this);
+        }
+
+        template <typename TParentFwd, typename TRangeFwd, typename TFFwd>
+        node_for_each(TParentFwd&& p, TRangeFwd&& range, TFFwd&& f)
+            : child_of<TParent>{FWD(p)}, TF{FWD(f)}, _range{FWD(range)}
+        {
+            assert_random_access_range<TRange>();
+        }
+
+        auto entry_task() & noexcept
+        {
+            return task{[](void* self) { static_cast<this_type*>(self)->run(); },
+                this};
+        }
+
+        void run_participant() &
+        {
+            auto& ctx = this->ctx();
+            auto next = this->_next;
+            auto first = std::begin(_range);
+
+            _chunks.claim_chunks(
+                [this, first](std::size_t, std::size_t begin, std::size_t end) {
+                    if(this->cancelled()) return;
+                    for(auto i = begin; i < end; ++i) as_f()(first[i]);
+                });
+
+            if(!_chunks.check_out()) return;
+
+            if(!this->cancelled())
+            {
+                _result.emplace();
+            }
+            else
+            {
+                _result.reset();
+            }
+
+            ctx.continue_with(next);
+        }
+
+        void run() &
+        {
+            if(this->cancelled())
+            {
+                _result.reset();
+                this->ctx().continue_with(this->_next);
+                return;
+            }
+
+            _chunks.start(*this,
+                _chunks.prepare(std::size(_range), this->ctx().concurrency()));
+        }
+
+        auto& result() & noexcept
+        {
+            return *_result;
+        }
+
+        bool has_result() const noexcept
+        {
+            return _result.has_value();
+        }
+
+        auto execute() &
+        {
+            this->ctx().post(this->_entry);
+        }
+
+        template <typename TCont>
+        auto then(TCont&& cont) &&
+        {
+            return node_then<this_type, TCont>{std::move(*this), FWD(cont)};
+        }
+
+        template <typename TCont>
+        auto then(TCont&& cont) &
+        {
+            return node_then<this_type&, TCont>{*this, FWD(cont)};
+        }
+
+        template <typename TRangeFwd, typename TCont>
+        auto then_for_each(TRangeFwd&& range, TCont&& cont) &&
+        {
+            return node_for_each<this_type, TRangeFwd, TCont>{
+                std::move(*this), FWD(range), FWD(cont)};
+        }
+
+        template <typename TRangeFwd, typename T, typename TOp>
+        auto then_reduce(TRangeFwd&& range, T&& init, TOp&& op) &&
+        {
+            return node_reduce<this_type, TRangeFwd, std::decay_t<T>, TOp>{
+                std::move(*this), FWD(range), FWD(init), FWD(op)};
+        }
+
+        template <typename TCont>
+        auto finally(TCont&& cont) &&
+        {
+            return node_finally<this_type, TCont>{std::move(*this), FWD(cont)};
+        }
+
+        template <typename TCont>
+        auto finally(TCont&& cont) &
+        {
+            return node_finally<this_type&, TCont>{*this, FWD(cont)};
+        }
+
+        template <typename... TNodes>
+        auto start(TNodes&... ns) &
+        {
+            this->parent().start(*this, ns...);
+        }
+    };
+
+    /// @brief Folds a range with `TOp`, in parallel chunks, starting from
+    /// `init`. The result of the parent is ignored.
+    /// @details Like `std::reduce`, `TOp` must be associative and the
+    /// elements convertible to `T`. Chunk results are combined in order, so
+    /// `TOp` does not need to be commutative. The chunk results are stored
+    /// in a vector that only allocates when the range grows.
+    template <typename TParent, typename TRange, typename T, typename TOp>
+    struct node_reduce : child_of<TParent>, TOp
+    {
+        using this_type = node_reduce<TParent, TRange, T, TOp>;
+        using result_type = T;
+
+        std::optional<result_type> _result;
+
+        TRange _range;
+        T _init;
+        chunked_range _chunks;
+
+        /// @brief Result of every chunk, filled concurrently.
+        std::vector<std::optional<T>> _partials;
+
+        auto& as_op() noexcept
+        {
+            return static_cast<TOp&>(*this);
+        }
+
+        template <typename TParentFwd, typename TRangeFwd, typename TInitFwd,
+            typename TOpFwd>
+        node_reduce(
+            TParentFwd&& p, TRangeFwd&& range, TInitFwd&& init, TOpFwd&& op)
+            : child_of<TParent>{FWD(p)}, TOp{FWD(op)}, _range{FWD(range)},
+              _init{FWD(init)}
+        {
+            assert_random_access_range<TRange>();
+        }
+
+        auto entry_task() & noexcept
+        {
+            return task{[](void* self) { static_cast<this_type*>(self)->run(); },
+                this};
+        }
+
+        void run_participant() &
+        {
+            auto& ctx = this->ctx();
+            auto next = this->_next;
+            auto first = std::begin(_range);
+
+            _chunks.claim_chunks([this, first](std::size_t chunk,
+                                     std::size_t begin, std::size_t end) {
+                if(this->cancelled()) return;
+
+                T acc(first[begin]);
+                for(auto i = begin + 1; i < end; ++i)
+                {
+                    acc = as_op()(std::move(acc), first[i]);
+                }
+
+                _partials[chunk].emplace(std::move(acc));
+            });
+
+            if(!_chunks.check_out()) return;
+
+            gather();
+            ctx.continue_with(next);
+        }
+
+        /// @brief Folds the chunk results into `init`, unless a chunk was
+        /// skipped because of cancellation.
+        void gather() &
+        {
+            _result.reset();
+            if(this->cancelled()) return;
+
+            T acc(_init);
+            for(auto& p : _partials)
+            {
+                if(!p.has_value()) return;
+                acc = as_op()(std::move(acc), std::move(*p));
+            }
+
+            _result.emplace(std::move(acc));
+        }
+
+        void run() &
+        {
+            if(this->cancelled())
+            {
+                _result.reset();
+                this->ctx().continue_with(this->_next);
+                return;
+            }
+
+            auto participants =
+                _chunks.prepare(std::size(_range), this->ctx().concurrency());
+
+            _partials.clear();
+            _partials.resize(_chunks._chunk_count);
+
+            _chunks.start(*this, participants);
+        }
+
+        auto& result() & noexcept
+        {
+            return *_result;
+        }
+
+        bool has_result() const noexcept
+        {
+            return _result.has_value();
+        }
+
+        auto execute() &
+        {
+            this->ctx().post(this->_entry);
+        }
+
+        template <typename TCont>
+        auto then(TCont&& cont) &&
+        {
+            return node_then<this_type, TCont>{std::move(*this), FWD(cont)};
+        }
+
+        template <typename TCont>
+        auto then(TCont&& cont) &
+        {
+            return node_then<this_type&, TCont>{*this, FWD(cont)};
+        }
+
+        template <typename TRangeFwd, typename TCont>
+        auto then_for_each(TRangeFwd&& range, TCont&& cont) &&
+        {
+            return node_for_each<this_type, TRangeFwd, TCont>{
+                std::move(*this), FWD(range), FWD(cont)};
+        }
+
+        template <typename TRangeFwd, typename TInit, typename TOpFwd>
+        auto then_reduce(TRangeFwd&& range, TInit&& init, TOpFwd&& op) &&
+        {
+            return node_reduce<this_type, TRangeFwd, std::decay_t<TInit>,
+                TOpFwd>{std::move(*this), FWD(range), FWD(init), FWD(op)};
+        }
+
+        template <typename TCont>
+        auto finally(TCont&& cont) &&
+        {
+            return node_finally<this_type, TCont>{std::move(*this), FWD(cont)};
+        }
+
+        template <typename TCont>
+        auto finally(TCont&& cont) &
+        {
+            return node_finally<this_type&, TCont>{*this, FWD(cont)};
+        }
+
+        template <typename... TNodes>
+        auto start(TNodes&... ns) &
+        {
+            this->parent().start(*this, ns...);
+        }
+    };
+
+    /// @brief Runs `TF` without arguments, even if the chain was cancelled.
+    /// The result of the parent is left in place.
+    /// @details Meant to terminate chains: it is always the last node.
+    template <typename TParent, typename TF>
+    struct node_finally : child_of<TParent>, TF
+    {
+        using this_type = node_finally<TParent, TF>;
+        using result_type = nothing_t;
+
+        nothing_t _result;
+
+        template <typename TParentFwd, typename TFFwd>
+        node_finally(TParentFwd&& p, TFFwd&& f)
+            : child_of<TParent>{FWD(p)}, TF{FWD(f)}
+        {
+        }
+
+        auto entry_task() & noexcept
+        {
+            return task{[](void* self) { static_cast<this_type*>(self)->run(); },
+                this};
+        }
+
+        /// @details `TF` may end the lifetime of the node.
+        void run() &
+        {
+            static_cast<TF&>(*this)();
+        }
+
+        auto& result() & noexcept
+        {
+            return _result;
+        }
+
+        auto execute() &
+        {
+            this->ctx().post(this->_entry);
+        }
+
+        template <typename... TNodes>
+        auto start(TNodes&... ns) &
+        {
+            this->parent().start(*this, ns...);
+        }
+    };
+
+    template <typename TParent, typename TF>
+    template <typename... TConts>
+    auto node_then<TParent, TF>::wait_all(TConts&&... conts) &&
+    {
+        return node_wait_all<this_type, TConts...>{
+            std::move(*this), FWD(conts)...};
+    }
+
+    template <typename TF>
+    auto context::build(TF&& f)
+    {
+        return node_then<root, TF>(root{*this}, FWD(f));
+    }
+
+    /// @brief Runs all `chains` and returns a tuple of their results.
+    template <typename... TChains>
+    auto wait_until_complete(TChains&&... chains)
+    {
+        static_assert(sizeof...(TChains) > 0,
+            "wait_until_complete requires 1 or more chains of computation");
+        latch l{sizeof...(TChains)};
+
+        // The latched chains are built directly in the tuple: building them
+        // from the elements of a temporary tuple (as `hana::transform` did)
+        // left them referring to destroyed nodes.
+        auto latched_chains = std::make_tuple(
+            FWD(chains).finally([&l] { l.count_down(); })...);
+
+        for_tuple(latched_chains, [](auto& c) { c.start(); });
+        l.wait();
+
+        return std::experimental::apply(
+            [](auto&... cs) {
+                return std::make_tuple(std::move(cs.parent().result())...);
+            },
+            latched_chains);
+    }
+
+    template <typename TState>
+    struct timed_wait_release
+    {
+        TState* _state;
+
+        void operator()() const
+        {
+            _state->chain_done();
+        }
+    };
+
+    /// @brief Completion state shared by `wait_for` and the chains it
+    /// started. Owns the chains.
+    /// @details Reference-counted by the waiter and every chain: a timed
+    /// out waiter can return while the chains are still running, and the
+    /// last one to finish destroys the state.
+    template <typename... TChains>
+    class timed_wait_state
+    {
+    private:
+        using release_type = timed_wait_release<timed_wait_state>;
+
+        latch _latch{sizeof...(TChains)};
+        cancellation_source _source;
+        std::atomic<int> _refs{sizeof...(TChains) + 1};
+
+        std::tuple<decltype(std::declval<TChains&&>().finally(
+            std::declval<release_type>()))...>
+            _chains;
+
+        friend release_type;
+
+        void chain_done()
+        {
+            _latch.count_down();
+            release();
+        }
+
+    public:
+        timed_wait_state(TChains&&... chains)
+            : _chains{FWD(chains).finally(release_type{this})...}
+        {
+            for_tuple(_chains, [this](auto& c) {
+                c.cancel_with(_source.token());
+            });
+        }
+
+        void start()
+        {
+            for_tuple(_chains, [](auto& c) { c.start(); });
+        }
+
+        /// @brief Waits at most `t` for all chains. On timeout, requests
+        /// their cancellation and returns an empty optional.
+        template <typename Rep, typename Period>
+        auto wait_for(const std::chrono::duration<Rep, Period>& t)
+        {
+            using result_type = std::tuple<
+                typename std::decay_t<TChains>::result_type...>;
+
+            std::optional<result_type> result;
+
+            if(_latch.wait_for(t) == std::cv_status::timeout)
+            {
+                _source.request_cancellation();
+                return result;
+            }
+
+            std::experimental::apply(
+                [&result](auto&... cs) {
+                    result.emplace(std::move(cs.parent().result())...);
+                },
+                _chains);
+
+            return result;
+        }
+
+        /// @brief Drops one reference. `delete`s the state if it was the
+        /// last one.
+        void release()
+        {
+            if(_refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                delete this;
+            }
+        }
+    };
+
+    /// @brief Runs all `chains`, waiting at most `t`. Returns an empty
+    /// optional on timeout, and a tuple of their results otherwise.
+    /// @details On timeout, the chains are cancelled: they stop running
+    /// further stages and are destroyed once their current stage is done.
+    /// Chains passed as lvalues are referenced, and must outlive that.
+    template <typename... TChains, typename Rep, typename Period>
+    auto wait_for(const std::chrono::duration<Rep, Period>& t, TChains&&... chains)
+    {
+        static_assert(sizeof...(TChains) > 0,
+            "wait_for requires 1 or more chains of computation");
+
+        // One allocation: the state outlives this call on timeout.
+        auto state = new timed_wait_state<TChains...>{FWD(chains)...};
+        state->start();
+
+        auto result = state->wait_for(t);
+        state->release();
+
+        return result;
+    }
+}
@@ -0,0 +1,171 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace ll
+{
+    /// @brief Chase-Lev work-stealing deque of pointers.
+    /// @details The owner thread pushes and pops at the bottom, other threads
+    /// steal from the top. Follows "Correct and Efficient Work-Stealing for
+    /// Weak Memory Models" (Le et al., 2013). The ring grows when full; old
+    /// rings are kept alive until destruction, as thieves may still read
+    /// them.
+    template <typename T>
+    class chase_lev_deque
+    {
+        static_assert(std::is_pointer<T>{}, "");
+
+    private:
+        using index_type = std::int64_t;
+
+        struct ring
+        {
+            index_type _mask;
+            std::unique_ptr<std::atomic<T>[]> _items;
+
+            explicit ring(index_type capacity)
+                : _mask{capacity - 1},
+                  _items{std::make_unique<std::atomic<T>[]>(capacity)}
+            {
+            }
+
+            auto capacity() const noexcept
+            {
+                return _mask + 1;
+            }
+
+            T load(index_type i) const noexcept
+            {
+                return _items[i & _mask].load(std::memory_order_relaxed);
+            }
+
+            void store(index_type i, T x) noexcept
+            {
+                _items[i & _mask].store(x, std::memory_order_relaxed);
+            }
+        };
+
+        alignas(64) std::atomic<index_type> _top{0};
+        alignas(64) std::atomic<index_type> _bottom{0};
+        std::atomic<ring*> _ring;
+
+        /// @brief Every ring ever allocated. Only touched by the owner.
+        std::vector<std::unique_ptr<ring>> _rings;
+
+        ring* grow(ring* r, index_type top, index_type bottom)
+        {
+            auto next = std::make_unique<ring>(r->capacity() * 2);
+
+            for(auto i = top; i < bottom; ++i)
+            {
+                next->store(i, r->load(i));
+            }
+
+            auto result = next.get();
+            _rings.emplace_back(std::move(next));
+            _ring.store(result, std::memory_order_release);
+
+            return result;
+        }
+
+    public:
+        explicit chase_lev_deque(index_type initial_capacity = 256)
+        {
+            _rings.emplace_back(std::make_unique<ring>(initial_capacity));
+            _ring.store(_rings.back().get(), std::memory_order_relaxed);
+        }
+
+        chase_lev_deque(const chase_lev_deque&) = delete;
+        chase_lev_deque& operator=(const chase_lev_deque&) = delete;
+
+        /// @brief Pushes `x` at the bottom. Owner thread only.
+        void push(T x)
+        {
+            auto b = _bottom.load(std::memory_order_relaxed);
+            auto t = _top.load(std::memory_order_acquire);
+            auto r = _ring.load(std::memory_order_relaxed);
+
+            if(b - t > r->capacity() - 1)
+            {
+                r = grow(r, t, b);
+            }
+
+            r->store(b, x);
+
+            // A release store rather than a release fence: same code on x86,
+            // and visible to ThreadSanitizer, which ignores fences.
+            _bottom.store(b + 1, std::memory_order_release);
+        }
+
+        /// @brief Pops from the bottom, returns `nullptr` if empty. Owner
+        /// thread only.
+        T pop() noexcept
+        {
+            auto b = _bottom.load(std::memory_order_relaxed) - 1;
+            auto r = _ring.load(std::memory_order_relaxed);
+            _bottom.store(b, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            auto t = _top.load(std::memory_order_relaxed);
+
+            if(t > b)
+            {
+                // Empty.
+                _bottom.store(b + 1, std::memory_order_relaxed);
+                return nullptr;
+            }
+
+            T x = r->load(b);
+
+            if(t == b)
+            {
+                // Last item: race against thieves.
+                if(!_top.compare_exchange_strong(t, t + 1,
+                       std::memory_order_seq_cst, std::memory_order_relaxed))
+                {
+                    x = nullptr;
+                }
+
+                _bottom.store(b + 1, std::memory_order_relaxed);
+            }
+
+            return x;
+        }
+
+        /// @brief Steals from the top, returns `nullptr` if empty or if
+        /// another thread won the race. Any thread.
+        T steal() noexcept
+        {
+            auto t = _top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            auto b = _bottom.load(std::memory_order_acquire);
+
+            if(t >= b)
+            {
+                return nullptr;
+            }
+
+            T x = _ring.load(std::memory_order_acquire)->load(t);
+
+            if(!_top.compare_exchange_strong(t, t + 1,
+                   std::memory_order_seq_cst, std::memory_order_relaxed))
+            {
+                return nullptr;
+            }
+
+            return x;
+        }
+
+        /// @brief Returns `true` if the deque looks empty. Any thread.
+        bool empty() const noexcept
+        {
+            auto b = _bottom.load(std::memory_order_acquire);
+            auto t = _top.load(std::memory_order_acquire);
+            return b <= t;
+        }
+    };
+}
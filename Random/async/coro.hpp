@@ -0,0 +1,600 @@
+#pragma once
+
+// Requires C++20 (`-std=c++20`): the rest of the chain library only needs
+// C++17.
+
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vrm/core/utility_macros.hpp>
+
+#include "./chains.hpp"
+#include "./latch.hpp"
+
+namespace ll::co
+{
+    // `ll::task` is the intrusive executor task: coroutines live in their
+    // own namespace.
+
+    class scheduler;
+
+    template <typename T>
+    class task;
+
+    namespace impl
+    {
+        /// @brief Scheduler of the coroutine running on this thread, if
+        /// any. Frames of the coroutines it creates come from its pool.
+        inline scheduler*& current_scheduler() noexcept
+        {
+            thread_local scheduler* result{nullptr};
+            return result;
+        }
+
+        /// @brief Sets the current scheduler for its lifetime.
+        class scheduler_scope
+        {
+        private:
+            scheduler* _previous;
+
+        public:
+            explicit scheduler_scope(scheduler* s) noexcept
+                : _previous{current_scheduler()}
+            {
+                current_scheduler() = s;
+            }
+
+            ~scheduler_scope()
+            {
+                current_scheduler() = _previous;
+            }
+
+            scheduler_scope(const scheduler_scope&) = delete;
+            scheduler_scope& operator=(const scheduler_scope&) = delete;
+        };
+
+        /// @brief Recycles coroutine frames, in power-of-two size classes
+        /// from 64 to 4096 bytes. Larger frames go to the global heap.
+        /// @details Frames are often freed on another thread than the one
+        /// that allocated them: each class is a free list behind a mutex.
+        /// Every block starts with a header recording its pool and class.
+        class frame_pool
+        {
+        private:
+            struct alignas(__STDCPP_DEFAULT_NEW_ALIGNMENT__) header
+            {
+                frame_pool* _pool;
+                std::size_t _class;
+            };
+
+            struct free_block
+            {
+                free_block* _next;
+            };
+
+            struct size_class
+            {
+                std::mutex _mutex;
+                free_block* _head{nullptr};
+            };
+
+            static constexpr std::size_t min_block = 64;
+            static constexpr std::size_t class_count = 7;
+            static constexpr std::size_t unpooled = class_count;
+
+            std::array<size_class, class_count> _classes;
+
+            /// @brief Blocks obtained from the global heap.
+            std::atomic<std::size_t> _heap_allocations{0};
+
+            static std::size_t class_of(std::size_t n) noexcept
+            {
+                std::size_t c = 0;
+                while(c < class_count && (min_block << c) < n) ++c;
+                return c;
+            }
+
+            static void* with_header(
+                void* block, frame_pool* pool, std::size_t c) noexcept
+            {
+                auto h = ::new(block) header{pool, c};
+                return h + 1;
+            }
+
+        public:
+            frame_pool() = default;
+
+            frame_pool(const frame_pool&) = delete;
+            frame_pool& operator=(const frame_pool&) = delete;
+
+            ~frame_pool()
+            {
+                for(auto& c : _classes)
+                {
+                    while(c._head != nullptr)
+                    {
+                        auto next = c._head->_next;
+                        ::operator delete(c._head);
+                        c._head = next;
+                    }
+                }
+            }
+
+            void* allocate(std::size_t n)
+            {
+                auto c = class_of(n + sizeof(header));
+                if(c == unpooled) return allocate_unpooled(n);
+
+                auto& sc = _classes[c];
+                {
+                    std::lock_guard<std::mutex> l{sc._mutex};
+                    if(auto b = sc._head)
+                    {
+                        sc._head = b->_next;
+                        return with_header(b, this, c);
+                    }
+                }
+
+                _heap_allocations.fetch_add(1, std::memory_order_relaxed);
+                return with_header(
+                    ::operator new(min_block << c), this, c);
+            }
+
+            static void* allocate_unpooled(std::size_t n)
+            {
+                return with_header(::operator new(n + sizeof(header)),
+                    nullptr, unpooled);
+            }
+
+            /// @brief Returns `p` to the pool that allocated it.
+            static void deallocate(void* p) noexcept
+            {
+                auto h = static_cast<header*>(p) - 1;
+                auto pool = h->_pool;
+
+                if(pool == nullptr)
+                {
+                    ::operator delete(h);
+                    return;
+                }
+
+                auto& sc = pool->_classes[h->_class];
+                auto b = ::new(static_cast<void*>(h)) free_block{nullptr};
+
+                std::lock_guard<std::mutex> l{sc._mutex};
+                b->_next = sc._head;
+                sc._head = b;
+            }
+
+            auto heap_allocations() const noexcept
+            {
+                return _heap_allocations.load(std::memory_order_relaxed);
+            }
+        };
+
+        void* allocate_frame(std::size_t n);
+
+        /// @brief Part of the promise that does not depend on the result.
+        struct promise_base
+        {
+            /// @brief Resumed once this coroutine completes.
+            std::coroutine_handle<> _continuation;
+
+            /// @brief Counter of a `when_all`: only its last child resumes
+            /// the continuation.
+            std::atomic<int>* _join{nullptr};
+
+            /// @brief Counted down on completion by `sync_wait`.
+            latch* _done{nullptr};
+
+            scheduler* _scheduler{current_scheduler()};
+
+            std::coroutine_handle<> _self;
+
+            /// @brief Resumes `_self` on the executor, when posted.
+            ll::task _start;
+
+            static void* operator new(std::size_t n)
+            {
+                return allocate_frame(n);
+            }
+
+            static void operator delete(void* p) noexcept
+            {
+                frame_pool::deallocate(p);
+            }
+
+            std::suspend_always initial_suspend() noexcept
+            {
+                return {};
+            }
+
+            struct final_awaiter
+            {
+                bool await_ready() const noexcept
+                {
+                    return false;
+                }
+
+                /// @details Nothing touches the frame once the join counter
+                /// or the latch were counted down: the frame may be
+                /// destroyed right away by the thread that resumes.
+                template <typename TPromise>
+                std::coroutine_handle<> await_suspend(
+                    std::coroutine_handle<TPromise> h) noexcept
+                {
+                    promise_base& p = h.promise();
+                    auto continuation = p._continuation;
+
+                    if(auto done = p._done)
+                    {
+                        done->count_down();
+                        return std::noop_coroutine();
+                    }
+
+                    if(auto join = p._join;
+                        join != nullptr &&
+                        join->fetch_sub(1, std::memory_order_acq_rel) != 1)
+                    {
+                        return std::noop_coroutine();
+                    }
+
+                    return continuation ? continuation
+                                        : std::noop_coroutine();
+                }
+
+                void await_resume() const noexcept
+                {
+                }
+            };
+
+            final_awaiter final_suspend() noexcept
+            {
+                return {};
+            }
+
+            void unhandled_exception() noexcept
+            {
+                std::terminate();
+            }
+
+            /// @brief Makes `_start` resume this coroutine under its
+            /// scheduler.
+            void prepare_start() noexcept
+            {
+                _start = ll::task{[](void* data) {
+                    auto& p = *static_cast<promise_base*>(data);
+                    scheduler_scope s{p._scheduler};
+                    p._self.resume();
+                },
+                    this};
+            }
+        };
+
+        template <typename T>
+        struct promise : promise_base
+        {
+            std::optional<T> _value;
+
+            task<T> get_return_object() noexcept;
+
+            template <typename TFwd>
+            void return_value(TFwd&& x)
+            {
+                _value.emplace(FWD(x));
+            }
+
+            T&& result() noexcept
+            {
+                return std::move(*_value);
+            }
+        };
+
+        template <>
+        struct promise<void> : promise_base
+        {
+            task<void> get_return_object() noexcept;
+
+            void return_void() noexcept
+            {
+            }
+
+            void result() noexcept
+            {
+            }
+        };
+    }
+
+    /// @brief Lazily started coroutine producing a `T`. Starts when awaited,
+    /// on the thread of the awaiter, which it resumes when done.
+    template <typename T = void>
+    class [[nodiscard]] task
+    {
+    public:
+        using promise_type = impl::promise<T>;
+        using handle_type = std::coroutine_handle<promise_type>;
+
+    private:
+        template <typename...>
+        friend class when_all_awaiter;
+
+        friend class scheduler;
+
+        handle_type _h;
+
+    public:
+        explicit task(handle_type h) noexcept : _h{h}
+        {
+        }
+
+        task(task&& rhs) noexcept : _h{std::exchange(rhs._h, nullptr)}
+        {
+        }
+
+        task& operator=(task&& rhs) noexcept
+        {
+            std::swap(_h, rhs._h);
+            return *this;
+        }
+
+        ~task()
+        {
+            if(_h) _h.destroy();
+        }
+
+        auto operator co_await() && noexcept
+        {
+            struct awaiter
+            {
+                handle_type _h;
+
+                bool await_ready() const noexcept
+                {
+                    return false;
+                }
+
+                std::coroutine_handle<> await_suspend(
+                    std::coroutine_handle<> awaiting) noexcept
+                {
+                    _h.promise()._continuation = awaiting;
+                    return _h;
+                }
+
+                decltype(auto) await_resume() noexcept
+                {
+                    return _h.promise().result();
+                }
+            };
+
+            return awaiter{_h};
+        }
+    };
+
+    namespace impl
+    {
+        template <typename T>
+        task<T> promise<T>::get_return_object() noexcept
+        {
+            auto h = std::coroutine_handle<promise<T>>::from_promise(*this);
+            _self = h;
+            return task<T>{h};
+        }
+
+        inline task<void> promise<void>::get_return_object() noexcept
+        {
+            auto h = std::coroutine_handle<promise<void>>::from_promise(*this);
+            _self = h;
+            return task<void>{h};
+        }
+
+        template <typename T>
+        using result_or_nothing_t =
+            std::conditional_t<std::is_void_v<T>, nothing_t, T>;
+    }
+
+    /// @brief Runs coroutines on the executor of an `ll::context`, and owns
+    /// the pool their frames come from.
+    class scheduler
+    {
+    private:
+        context& _ctx;
+        impl::frame_pool _frames;
+
+        friend void* impl::allocate_frame(std::size_t);
+
+    public:
+        explicit scheduler(context& ctx) noexcept : _ctx{ctx}
+        {
+        }
+
+        scheduler(const scheduler&) = delete;
+        scheduler& operator=(const scheduler&) = delete;
+
+        auto& ctx() noexcept
+        {
+            return _ctx;
+        }
+
+        void post(ll::task& t)
+        {
+            _ctx.post(t);
+        }
+
+        /// @brief Frames that did not come from the free lists.
+        auto frame_heap_allocations() const noexcept
+        {
+            return _frames.heap_allocations();
+        }
+
+        /// @brief `co_await s.schedule()` resumes the coroutine on the
+        /// executor.
+        auto schedule() noexcept
+        {
+            struct awaiter
+            {
+                scheduler& _s;
+                std::coroutine_handle<> _h;
+                ll::task _resume;
+
+                bool await_ready() const noexcept
+                {
+                    return false;
+                }
+
+                void await_suspend(std::coroutine_handle<> h)
+                {
+                    _h = h;
+                    _resume = ll::task{[](void* data) {
+                        auto& self = *static_cast<awaiter*>(data);
+                        impl::scheduler_scope s{&self._s};
+                        self._h.resume();
+                    },
+                        this};
+
+                    _s.post(_resume);
+                }
+
+                void await_resume() const noexcept
+                {
+                }
+            };
+
+            return awaiter{*this, nullptr, {}};
+        }
+
+        /// @brief Runs `t` on the executor and blocks until it completes.
+        template <typename T>
+        T sync_wait(task<T> t)
+        {
+            latch l{1};
+
+            auto& p = t._h.promise();
+            p._done = &l;
+            p._scheduler = this;
+            p.prepare_start();
+
+            post(p._start);
+            l.wait();
+
+            return p.result();
+        }
+
+        /// @brief Calls `f`, which returns a `task`, with this scheduler
+        /// current: its frame comes from the pool as well.
+        template <typename TF>
+        auto sync_wait(TF&& f) -> decltype(sync_wait(f()))
+        {
+            auto make = [&] {
+                impl::scheduler_scope s{this};
+                return f();
+            };
+
+            return sync_wait(make());
+        }
+    };
+
+    namespace impl
+    {
+        inline void* allocate_frame(std::size_t n)
+        {
+            if(auto s = current_scheduler())
+            {
+                return s->_frames.allocate(n);
+            }
+
+            return frame_pool::allocate_unpooled(n);
+        }
+    }
+
+    /// @brief Awaitable returned by `when_all`. Starts every task, the
+    /// first one inline and the others on the executor, and resumes the
+    /// awaiter once the last one completes.
+    /// @details Same join as `node_wait_all`: one atomic counter, decremented
+    /// by every child when it completes. The results stay in the child
+    /// frames until `await_resume` moves them out.
+    template <typename... Ts>
+    class when_all_awaiter
+    {
+    private:
+        std::tuple<task<Ts>...> _tasks;
+        std::atomic<int> _ctr{sizeof...(Ts)};
+
+        static constexpr bool all_void = (std::is_void_v<Ts> && ...);
+
+    public:
+        explicit when_all_awaiter(task<Ts>&&... ts) : _tasks{std::move(ts)...}
+        {
+        }
+
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> h)
+        {
+            auto s = impl::current_scheduler();
+            assert(s != nullptr && "when_all must run on a scheduler");
+
+            std::apply(
+                [&](auto&... ts) {
+                    ((ts._h.promise()._continuation = h,
+                         ts._h.promise()._join = &_ctr,
+                         ts._h.promise()._scheduler = s),
+                        ...);
+                },
+                _tasks);
+
+            // The first child runs inline, through symmetric transfer.
+            std::apply(
+                [s](auto& first, auto&... others) {
+                    (void)first;
+                    ((others._h.promise().prepare_start(),
+                         s->post(others._h.promise()._start)),
+                        ...);
+                },
+                _tasks);
+
+            return std::get<0>(_tasks)._h;
+        }
+
+        /// @brief A `std::tuple` of the results, where `void` results are
+        /// `nothing`. Returns `void` if they all are.
+        auto await_resume()
+        {
+            if constexpr(all_void)
+            {
+                return;
+            }
+            else
+            {
+                return std::apply(
+                    [](auto&... ts) {
+                        return std::tuple<impl::result_or_nothing_t<Ts>...>{
+                            with_void_to_nothing(
+                                [&ts]() -> decltype(auto) {
+                                    return ts._h.promise().result();
+                                },
+                                nothing)...};
+                    },
+                    _tasks);
+            }
+        }
+    };
+
+    template <typename... Ts>
+    auto when_all(task<Ts>&&... ts)
+    {
+        static_assert(sizeof...(Ts) > 0, "when_all requires 1 or more tasks");
+        return when_all_awaiter<Ts...>{std::move(ts)...};
+    }
+}
@@ -0,0 +1,381 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <vrm/core/utility_macros.hpp>
+
+#include "./chase_lev_deque.hpp"
+
+namespace ll
+{
+    /// @brief Non-owning unit of work: a function pointer and its argument.
+    /// @details Nodes embed their tasks, so that posting them does not
+    /// allocate. A posted task must stay alive until it has run.
+    struct task
+    {
+        void (*_fn)(void*){nullptr};
+        void* _data{nullptr};
+
+        void operator()() const
+        {
+            (*_fn)(_data);
+        }
+
+        explicit operator bool() const noexcept
+        {
+            return _fn != nullptr;
+        }
+    };
+
+    /// @brief Returns a task that calls `(*x)()`.
+    template <typename T>
+    auto make_task(T& x) noexcept
+    {
+        return task{[](void* data) { (*static_cast<T*>(data))(); }, &x};
+    }
+
+    /// @brief Growable FIFO ring buffer. Does not allocate once it reached
+    /// its peak size, unlike `std::deque`.
+    template <typename T>
+    class ring_queue
+    {
+    private:
+        std::vector<T> _items;
+        std::size_t _head{0};
+        std::size_t _size{0};
+
+        void grow()
+        {
+            std::vector<T> next(std::max(_items.size() * 2, std::size_t(64)));
+
+            for(std::size_t i = 0; i < _size; ++i)
+            {
+                next[i] = _items[(_head + i) % _items.size()];
+            }
+
+            _items = std::move(next);
+            _head = 0;
+        }
+
+    public:
+        void push(T x)
+        {
+            if(_size == _items.size()) grow();
+
+            _items[(_head + _size) % _items.size()] = x;
+            ++_size;
+        }
+
+        T pop() noexcept
+        {
+            auto result = _items[_head];
+            _head = (_head + 1) % _items.size();
+            --_size;
+
+            return result;
+        }
+
+        bool empty() const noexcept
+        {
+            return _size == 0;
+        }
+    };
+
+    /// @brief Type-erased reference to an executor, which must provide
+    /// `post(task&)` and `concurrency()`.
+    class executor_ref
+    {
+    private:
+        void* _executor;
+        void (*_post)(void*, task&);
+        std::size_t (*_concurrency)(void*);
+
+    public:
+        template <typename TExecutor>
+        executor_ref(TExecutor& e) noexcept
+            : _executor{&e},
+              _post{[](void* x, task& t) {
+                  static_cast<TExecutor*>(x)->post(t);
+              }},
+              _concurrency{[](void* x) -> std::size_t {
+                  return static_cast<TExecutor*>(x)->concurrency();
+              }}
+        {
+        }
+
+        void post(task& t) const
+        {
+            (*_post)(_executor, t);
+        }
+
+        auto concurrency() const
+        {
+            return (*_concurrency)(_executor);
+        }
+    };
+
+    /// @brief Thread pool with one Chase-Lev deque per worker.
+    /// @details Tasks posted from a worker go to the bottom of its own deque
+    /// (LIFO, cache-friendly); tasks posted from other threads go to a shared
+    /// injection queue. Idle workers steal from the top of other deques,
+    /// spin for a while, then sleep until new work is posted.
+    class work_stealing_pool
+    {
+    private:
+        static constexpr int spin_iterations = 64;
+
+        struct worker
+        {
+            chase_lev_deque<task*> _deque;
+            std::thread _thread;
+            std::size_t _rng;
+        };
+
+        std::vector<std::unique_ptr<worker>> _workers;
+
+        std::mutex _injection_mutex;
+        ring_queue<task*> _injection;
+        std::atomic<std::size_t> _injection_size{0};
+
+        std::mutex _sleep_mutex;
+        std::condition_variable _sleep_cv;
+        std::atomic<int> _sleepers{0};
+
+        std::atomic<bool> _running{true};
+
+        // Worker of the calling thread and the pool it belongs to.
+        static worker*& current_worker() noexcept
+        {
+            thread_local worker* w{nullptr};
+            return w;
+        }
+
+        static work_stealing_pool*& current_pool() noexcept
+        {
+            thread_local work_stealing_pool* p{nullptr};
+            return p;
+        }
+
+        worker* local_worker() noexcept
+        {
+            return current_pool() == this ? current_worker() : nullptr;
+        }
+
+        task* pop_injection()
+        {
+            if(_injection_size.load(std::memory_order_relaxed) == 0)
+            {
+                return nullptr;
+            }
+
+            std::lock_guard<std::mutex> l{_injection_mutex};
+            if(_injection.empty()) return nullptr;
+
+            auto result = _injection.pop();
+            _injection_size.fetch_sub(1, std::memory_order_relaxed);
+
+            return result;
+        }
+
+        task* steal_from_others(worker& self)
+        {
+            auto n = _workers.size();
+
+            // xorshift
+            self._rng ^= self._rng << 13;
+            self._rng ^= self._rng >> 7;
+            self._rng ^= self._rng << 17;
+
+            auto start = self._rng % n;
+            for(std::size_t i = 0; i < n; ++i)
+            {
+                auto& victim = *_workers[(start + i) % n];
+                if(&victim == &self) continue;
+
+                if(auto t = victim._deque.steal())
+                {
+                    return t;
+                }
+            }
+
+            return nullptr;
+        }
+
+        task* find_task(worker& self)
+        {
+            if(auto t = self._deque.pop()) return t;
+            if(auto t = pop_injection()) return t;
+            return steal_from_others(self);
+        }
+
+        bool has_visible_work() const noexcept
+        {
+            if(_injection_size.load(std::memory_order_seq_cst) != 0)
+            {
+                return true;
+            }
+
+            for(const auto& w : _workers)
+            {
+                if(!w->_deque.empty()) return true;
+            }
+
+            return false;
+        }
+
+        void sleep()
+        {
+            std::unique_lock<std::mutex> l{_sleep_mutex};
+            _sleepers.fetch_add(1, std::memory_order_seq_cst);
+
+            // Re-check after announcing: pairs with the fence in `notify`.
+            _sleep_cv.wait(l, [this] {
+                return has_visible_work() ||
+                       !_running.load(std::memory_order_relaxed);
+            });
+
+            _sleepers.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        void notify()
+        {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if(_sleepers.load(std::memory_order_relaxed) == 0) return;
+
+            std::lock_guard<std::mutex> l{_sleep_mutex};
+            _sleep_cv.notify_one();
+        }
+
+        void worker_loop(worker& self)
+        {
+            current_pool() = this;
+            current_worker() = &self;
+
+            int idle = 0;
+
+            while(true)
+            {
+                if(auto t = find_task(self))
+                {
+                    (*t)();
+                    idle = 0;
+                    continue;
+                }
+
+                if(!_running.load(std::memory_order_acquire)) break;
+
+                if(++idle < spin_iterations)
+                {
+                    std::this_thread::yield();
+                    continue;
+                }
+
+                sleep();
+                idle = 0;
+            }
+
+            current_pool() = nullptr;
+            current_worker() = nullptr;
+        }
+
+    public:
+        explicit work_stealing_pool(
+            std::size_t n = std::thread::hardware_concurrency())
+        {
+            if(n == 0) n = 1;
+
+            _workers.reserve(n);
+            for(std::size_t i = 0; i < n; ++i)
+            {
+                _workers.emplace_back(std::make_unique<worker>());
+                _workers.back()->_rng = i * 2654435761u + 1;
+            }
+
+            // Start the threads only once `_workers` is complete, as they
+            // read it while stealing.
+            for(auto& w : _workers)
+            {
+                w->_thread = std::thread([this, &w = *w] { worker_loop(w); });
+            }
+        }
+
+        /// @brief Runs all the pending tasks, then joins the workers.
+        ~work_stealing_pool()
+        {
+            {
+                std::lock_guard<std::mutex> l{_sleep_mutex};
+                _running.store(false, std::memory_order_release);
+            }
+
+            _sleep_cv.notify_all();
+
+            for(auto& w : _workers)
+            {
+                w->_thread.join();
+            }
+        }
+
+        work_stealing_pool(const work_stealing_pool&) = delete;
+        work_stealing_pool& operator=(const work_stealing_pool&) = delete;
+
+        /// @brief Schedules `t`, which must stay alive until it has run.
+        void post(task& t)
+        {
+            if(auto w = local_worker())
+            {
+                w->_deque.push(&t);
+            }
+            else
+            {
+                std::lock_guard<std::mutex> l{_injection_mutex};
+                _injection.push(&t);
+                _injection_size.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            notify();
+        }
+
+        /// @brief Schedules a copy of `f`. Allocates: prefer `post(task&)`.
+        template <typename TF>
+        void post(TF&& f)
+        {
+            struct owned_task : task
+            {
+                std::decay_t<TF> _f;
+
+                owned_task(TF&& x) : _f{FWD(x)}
+                {
+                    _fn = [](void* data) {
+                        auto self = static_cast<owned_task*>(data);
+                        self->_f();
+                        delete self;
+                    };
+
+                    _data = this;
+                }
+            };
+
+            task& t = *new owned_task{FWD(f)};
+            post(t);
+        }
+
+        /// @brief Returns `true` if the calling thread is a worker of this
+        /// pool.
+        bool on_worker_thread() noexcept
+        {
+            return local_worker() != nullptr;
+        }
+
+        auto concurrency() const noexcept
+        {
+            return _workers.size();
+        }
+    };
+}
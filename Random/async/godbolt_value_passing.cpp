@@ -0,0 +1,36 @@
+#include <cstdio>
+
+#include "./chains.hpp"
+
+// Compare with `godbolt_value_passing_manual.cpp`.
+
+struct inline_executor
+{
+    void post(ll::task& t)
+    {
+        t();
+    }
+
+    std::size_t concurrency() const noexcept
+    {
+        return 1;
+    }
+};
+
+int main(int argc, char**)
+{
+    inline_executor e;
+    ll::context ctx{e};
+
+    volatile int out;
+
+    auto chain = ctx.build([argc] { return argc; })
+                     .then([](int x) { return x * 2; })
+                     .wait_all([](int x) { return x + 1; },
+                         [](int x) { return x * 3.f; })
+                     .then([&out](std::tuple<int, float> t) {
+                         out = std::get<0>(t) + int(std::get<1>(t));
+                     });
+
+    chain.start();
+}
@@ -0,0 +1,22 @@
+#include <atomic>
+#include <tuple>
+
+int main(int argc, char**)
+{
+    volatile int out;
+
+    auto x0 = argc;
+    auto x1 = x0 * 2;
+
+    std::atomic<int> ctr{2};
+    std::tuple<int, float> t;
+
+    std::get<0>(t) = x1 + 1;
+    --ctr;
+    std::get<1>(t) = x1 * 3.f;
+
+    if(--ctr == 0)
+    {
+        out = std::get<0>(t) + int(std::get<1>(t));
+    }
+}
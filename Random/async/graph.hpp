@@ -0,0 +1,220 @@
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <vrm/core/utility_macros.hpp>
+
+#include "./chains.hpp"
+#include "./latch.hpp"
+
+namespace ll
+{
+    class graph;
+
+    namespace impl
+    {
+        /// @brief Scheduling state of a graph node. Its task runs the
+        /// callable object of the derived `graph_node_impl`.
+        struct graph_node
+        {
+            graph& _graph;
+            task _task;
+
+            /// @brief Predecessors not completed yet in this execution.
+            std::atomic<int> _pending{0};
+            int _predecessor_count{0};
+
+            std::vector<graph_node*> _successors;
+
+            graph_node(graph& g) noexcept : _graph{g}
+            {
+            }
+
+            /// @brief Nodes are owned through this base.
+            virtual ~graph_node() = default;
+
+            graph_node(const graph_node&) = delete;
+            graph_node& operator=(const graph_node&) = delete;
+
+            /// @brief Returns `true` if this was the last predecessor to
+            /// complete. The decrement publishes its work to the node.
+            bool predecessor_done() noexcept
+            {
+                return _pending.fetch_sub(1, std::memory_order_acq_rel) == 1;
+            }
+        };
+
+        template <typename TF>
+        struct graph_node_impl : graph_node, TF
+        {
+            template <typename TFFwd>
+            graph_node_impl(graph& g, TFFwd&& f)
+                : graph_node{g}, TF{FWD(f)}
+            {
+                _task = task{[](void* self) {
+                    static_cast<graph_node_impl*>(self)->run();
+                },
+                    this};
+            }
+
+            void run() &;
+        };
+    }
+
+    /// @brief Dependency graph of `void()` callable objects, built once
+    /// and executed any number of times.
+    /// @details Nodes can have any number of predecessors, which must be
+    /// added before them: graphs are acyclic by construction. Each node
+    /// counts its pending predecessors with an atomic counter, and is
+    /// scheduled by the predecessor that brings it to zero. Building
+    /// allocates; executing does not (once the executor queues reached
+    /// their peak size).
+    class graph
+    {
+    public:
+        using node_id = std::size_t;
+
+    private:
+        template <typename>
+        friend struct impl::graph_node_impl;
+
+        context& _ctx;
+        std::vector<std::unique_ptr<impl::graph_node>> _nodes;
+
+        /// @brief Nodes without predecessors, posted by `start`.
+        std::vector<impl::graph_node*> _roots;
+
+        /// @brief Nodes without successors, which complete an execution.
+        std::size_t _sink_count{0};
+        std::atomic<std::size_t> _remaining_sinks{0};
+
+        latch _done{0};
+
+        /// @brief Counts down the predecessors of the successors of `n`.
+        /// The first one that becomes ready runs inline, the others are
+        /// posted.
+        /// @details Once the last successor of `n` is counted down, the
+        /// execution can complete on another thread, and the graph can be
+        /// destroyed by the owner returning from `wait`: from then on, only
+        /// locals may be used.
+        void complete(impl::graph_node& n)
+        {
+            if(n._successors.empty())
+            {
+                if(_remaining_sinks.fetch_sub(1, std::memory_order_acq_rel) ==
+                    1)
+                {
+                    _done.count_down();
+                }
+
+                return;
+            }
+
+            auto& ctx = _ctx;
+            task* inline_task = nullptr;
+
+            // A successor that is not counted down yet keeps the execution
+            // alive: `n._successors` can be read until the last one is.
+            for(auto s : n._successors)
+            {
+                if(!s->predecessor_done()) continue;
+
+                if(inline_task == nullptr)
+                {
+                    inline_task = &s->_task;
+                }
+                else
+                {
+                    ctx.post(s->_task);
+                }
+            }
+
+            ctx.continue_with(inline_task);
+        }
+
+    public:
+        explicit graph(context& ctx) noexcept : _ctx{ctx}
+        {
+        }
+
+        graph(const graph&) = delete;
+        graph& operator=(const graph&) = delete;
+
+        /// @brief Adds a node running `f` once all `predecessors` ran.
+        template <typename TF>
+        node_id add(
+            TF&& f, std::initializer_list<node_id> predecessors = {})
+        {
+            using node_type = impl::graph_node_impl<std::decay_t<TF>>;
+            auto& n = *_nodes.emplace_back(
+                std::make_unique<node_type>(*this, FWD(f)));
+
+            for(auto p : predecessors)
+            {
+                assert(p < _nodes.size() - 1);
+
+                auto& pn = *_nodes[p];
+                if(pn._successors.empty()) --_sink_count;
+
+                pn._successors.emplace_back(&n);
+                ++n._predecessor_count;
+            }
+
+            n._pending.store(n._predecessor_count, std::memory_order_relaxed);
+            if(n._predecessor_count == 0) _roots.emplace_back(&n);
+
+            ++_sink_count;
+            return _nodes.size() - 1;
+        }
+
+        auto size() const noexcept
+        {
+            return _nodes.size();
+        }
+
+        /// @brief Posts the root nodes. The previous execution must be
+        /// complete.
+        void start()
+        {
+            assert(_sink_count > 0);
+
+            _done.reset(1);
+            _remaining_sinks.store(_sink_count, std::memory_order_relaxed);
+
+            for(auto r : _roots) _ctx.post(r->_task);
+        }
+
+        /// @brief Blocks until the execution started by `start` completes.
+        void wait()
+        {
+            _done.wait();
+        }
+
+        void run()
+        {
+            start();
+            wait();
+        }
+    };
+
+    namespace impl
+    {
+        /// @details The counter is re-armed before the body runs: every
+        /// predecessor already counted down for this execution, and the
+        /// next one cannot start before the sinks complete.
+        template <typename TF>
+        void graph_node_impl<TF>::run() &
+        {
+            _pending.store(_predecessor_count, std::memory_order_relaxed);
+
+            static_cast<TF&>(*this)();
+            _graph.complete(*this);
+        }
+    }
+}
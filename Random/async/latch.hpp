@@ -1,159 +1,224 @@
 #ifndef LL_LATCH_HPP
 #define LL_LATCH_HPP
-// this is a search/replace of boost::thread::latch to use std library threading primitives
-
-#include <thread>
-
-namespace ll {
-  class latch
-  {
-    /// @Requires: count_ must be greater than 0
-    /// Effect: Decrement the count. Unlocks the lock and notify anyone waiting if we reached zero.
-    /// Returns: true if count_ reached the value 0.
-    /// @ThreadSafe ensured by the @c lk parameter
-    bool count_down(std::unique_lock<std::mutex> &)
-    /// pre_condition (count_ > 0)
-    {
-      assert(count_ > 0);
-      if (--count_ == 0)
-      {
-        ++generation_;
-        //lk.unlock();
-        cond_.notify_all();
-        return true;
-      }
-      return false;
-    }
-    /// Effect: Decrement the count is > 0. Unlocks the lock notify anyone waiting if we reached zero.
-    /// Returns: true if count_ is 0.
-    /// @ThreadSafe ensured by the @c lk parameter
-    bool try_count_down(std::unique_lock<std::mutex> &lk)
-    {
-      if (count_ > 0)
-      {
-        return count_down(lk);
-      }
-      return true;
-    }
-  public:
-    // BOOST_THREAD_NO_COPYABLE( latch)
-    latch(latch const& ) = delete;
-
-    /// Constructs a latch with a given count.
-    latch(std::size_t count) :
-      count_(count), generation_(0)
-    {
-    }
-
-    /// Destructor
-    /// Precondition: No threads are waiting or invoking count_down on @c *this.
-
-    ~latch()
-    {
-
-    }
-
-    /// Blocks until the latch has counted down to zero.
-    void wait()
-    {
-      std::unique_lock<std::mutex> lk(mutex_);
-      std::size_t generation(generation_);
-      cond_.wait(lk, not_equal(generation, generation_));
-    }
-
-    /// @return true if the internal counter is already 0, false otherwise
-    bool try_wait()
-    {
-      std::unique_lock<std::mutex> lk(mutex_);
-      return (count_ == 0);
-    }
-
-    /// try to wait for a specified amount of time is elapsed.
-    /// @return whether there is a timeout or not.
-    template <class Rep, class Period>
-    std::cv_status wait_for(const std::chrono::duration<Rep, Period>& rel_time)
-    {
-      std::unique_lock<std::mutex> lk(mutex_);
-      std::size_t generation(generation_);
-      return cond_.wait_for(lk, rel_time, not_equal(generation, generation_))
-              ? std::cv_status::no_timeout
-              : std::cv_status::timeout;
-    }
-
-    /// try to wait until the specified time_point is reached
-    /// @return whether there were a timeout or not.
-    template <class Clock, class Duration>
-    std::cv_status wait_until(const std::chrono::time_point<Clock, Duration>& abs_time)
-    {
-      std::unique_lock<std::mutex> lk(mutex_);
-      std::size_t generation(generation_);
-      // TODO detail
-      return cond_.wait_until(lk, abs_time, not_equal(generation, generation_))
-          ? std::cv_status::no_timeout
-          : std::cv_status::timeout;
-    }
-
-    /// Decrement the count and notify anyone waiting if we reach zero.
-    /// @Requires count must be greater than 0
-    void count_down()
-    {
-      std::unique_lock<std::mutex> lk(mutex_);
-      count_down(lk);
-    }
-    /// Effect: Decrement the count if it is > 0 and notify anyone waiting if we reached zero.
-    /// Returns: true if count_ was 0 or reached 0.
-    bool try_count_down()
-    {
-      std::unique_lock<std::mutex> lk(mutex_);
-      return try_count_down(lk);
-    }
-    void signal()
-    {
-      count_down();
-    }
 
-    /// Decrement the count and notify anyone waiting if we reach zero.
-    /// Blocks until the latch has counted down to zero.
-    /// @Requires count must be greater than 0
-    struct not_equal
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+
+#include "./park.hpp"
+
+namespace ll
+{
+    /// @brief Single-use countdown latch on an atomic counter.
+    /// @details `count_down` is one `fetch_sub`, plus a futex wake only if
+    /// it releases the latch while threads are parked. Waiters spin briefly
+    /// on the released flag, then park on it.
+    class latch
     {
-      not_equal(std::size_t& x, std::size_t& y) : x_(x), y_(y) {}
-      bool operator()() const { return x_ != y_; }
-      std::size_t& x_;
-      std::size_t& y_;
+    private:
+        /// @brief Bit set once the count reaches zero.
+        static constexpr std::uint32_t released_bit = 1;
+
+        /// @brief Increment of `_state` per parked thread.
+        static constexpr std::uint32_t one_waiter = 2;
+
+        std::atomic<std::ptrdiff_t> _count;
+
+        /// @brief `released_bit`, plus the number of parked (or about to
+        /// park) threads in the other bits.
+        /// @details A single word: the releasing thread must not touch the
+        /// latch after releasing it, as a spinning waiter may then return
+        /// and destroy it. The wake is a syscall on its address only, which
+        /// is harmless even if the memory was reused.
+        impl::park_word _state{0};
+
+        void release() noexcept
+        {
+            auto old = _state.fetch_or(released_bit, std::memory_order_acq_rel);
+            if(old >= one_waiter) impl::unpark_all(_state);
+        }
+
+        bool spin_until_released() const noexcept
+        {
+            for(int i = 0; i < impl::spin_iterations; ++i)
+            {
+                if(try_wait()) return true;
+                impl::spin_pause();
+            }
+
+            return false;
+        }
+
+        /// @brief `park(s)` blocks while `_state == s`. Returns `false` on
+        /// timeout.
+        template <typename TPark>
+        bool wait_impl(TPark&& park)
+        {
+            if(spin_until_released()) return true;
+
+            auto s = _state.fetch_add(one_waiter, std::memory_order_acquire) +
+                     one_waiter;
+
+            bool result = true;
+            while((s & released_bit) == 0)
+            {
+                if(!park(s))
+                {
+                    result = try_wait();
+                    break;
+                }
+
+                s = _state.load(std::memory_order_acquire);
+            }
+
+            _state.fetch_sub(one_waiter, std::memory_order_relaxed);
+            return result;
+        }
+
+    public:
+        explicit latch(std::ptrdiff_t count) noexcept
+            : _count{count}, _state{count == 0 ? released_bit : 0}
+        {
+            assert(count >= 0);
+        }
+
+        latch(const latch&) = delete;
+        latch& operator=(const latch&) = delete;
+
+        /// @brief Decrements the count by `n`, releasing the waiters if it
+        /// reaches zero.
+        void count_down(std::ptrdiff_t n = 1) noexcept
+        {
+            auto old = _count.fetch_sub(n, std::memory_order_acq_rel);
+            assert(old >= n);
+
+            if(old == n) release();
+        }
+
+        /// @brief Returns `true` if the count reached zero.
+        bool try_wait() const noexcept
+        {
+            return (_state.load(std::memory_order_acquire) & released_bit) != 0;
+        }
+
+        /// @brief Blocks until the count reaches zero.
+        void wait()
+        {
+            wait_impl([this](std::uint32_t s) {
+                impl::park_while_equal(_state, s);
+                return true;
+            });
+        }
+
+        template <class Clock, class Duration>
+        std::cv_status wait_until(
+            const std::chrono::time_point<Clock, Duration>& abs_time)
+        {
+            auto done = wait_impl([this, &abs_time](std::uint32_t s) {
+                impl::park_while_equal_until(_state, s, abs_time);
+                return Clock::now() < abs_time;
+            });
+
+            return done ? std::cv_status::no_timeout : std::cv_status::timeout;
+        }
+
+        template <class Rep, class Period>
+        std::cv_status wait_for(
+            const std::chrono::duration<Rep, Period>& rel_time)
+        {
+            return wait_until(std::chrono::steady_clock::now() + rel_time);
+        }
+
+        void count_down_and_wait()
+        {
+            count_down();
+            wait();
+        }
+
+        /// @brief Resets the count. No thread may be using the latch.
+        void reset(std::ptrdiff_t count) noexcept
+        {
+            _count.store(count, std::memory_order_relaxed);
+            _state.store(count == 0 ? released_bit : 0,
+                std::memory_order_release);
+        }
     };
 
-    void count_down_and_wait()
-    {
-      std::unique_lock<std::mutex> lk(mutex_);
-      std::size_t generation(generation_);
-      if (count_down(lk))
-      {
-        return;
-      }
-      cond_.wait(lk, not_equal(generation, generation_));
-    }
-    void sync()
+    /// @brief Reusable barrier for a fixed number of threads.
+    /// @details The last thread to arrive in a phase resets the counter and
+    /// bumps the phase number, which the other threads spin, then park on.
+    /// As in `latch`, the phase and the number of parked threads share one
+    /// word, so that the last thread does not touch the barrier after
+    /// releasing the others.
+    class barrier
     {
-      count_down_and_wait();
-    }
-
-    /// Reset the counter
-    /// #Requires This method may only be invoked when there are no other threads currently inside the count_down_and_wait() method.
-    void reset(std::size_t count)
-    {
-      std::lock_guard<std::mutex> lk(mutex_);
-      //BOOST_ASSERT(count_ == 0);
-      count_ = count;
-    }
-
-  private:
-    std::mutex mutex_;
-    std::condition_variable cond_;
-    std::size_t count_;
-    std::size_t generation_;
-  };
-
-}  // namespace ll
+    private:
+        /// @brief Number of parked threads in the low bits, phase in the
+        /// high ones. A thread cannot sleep through 2^16 phases, so the
+        /// phase can wrap around.
+        static constexpr std::uint32_t one_phase = 1u << 16;
+        static constexpr std::uint32_t waiters_mask = one_phase - 1;
+
+        const std::ptrdiff_t _expected;
+        std::atomic<std::ptrdiff_t> _remaining;
+
+        impl::park_word _state{0};
+
+        static std::uint32_t phase_of(std::uint32_t s) noexcept
+        {
+            return s >> 16;
+        }
+
+    public:
+        explicit barrier(std::ptrdiff_t expected) noexcept
+            : _expected{expected}, _remaining{expected}
+        {
+            assert(expected > 0 && expected <= std::ptrdiff_t(waiters_mask));
+        }
+
+        barrier(const barrier&) = delete;
+        barrier& operator=(const barrier&) = delete;
+
+        /// @brief Blocks until `expected` threads arrived in the current
+        /// phase.
+        void arrive_and_wait()
+        {
+            auto phase = phase_of(_state.load(std::memory_order_acquire));
+
+            if(_remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                // Nobody can arrive in the next phase before the bump.
+                _remaining.store(_expected, std::memory_order_relaxed);
+
+                auto old = _state.fetch_add(one_phase, std::memory_order_acq_rel);
+                if((old & waiters_mask) != 0) impl::unpark_all(_state);
+
+                return;
+            }
+
+            for(int i = 0; i < impl::spin_iterations; ++i)
+            {
+                if(phase_of(_state.load(std::memory_order_acquire)) != phase)
+                {
+                    return;
+                }
+
+                impl::spin_pause();
+            }
+
+            auto s = _state.fetch_add(1, std::memory_order_acquire) + 1;
+            while(phase_of(s) == phase)
+            {
+                impl::park_while_equal(_state, s);
+                s = _state.load(std::memory_order_acquire);
+            }
+
+            _state.fetch_sub(1, std::memory_order_relaxed);
+        }
+    };
+}
 
-#endif  // LL_LATCH_HPP
+#endif // LL_LATCH_HPP
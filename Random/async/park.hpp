@@ -0,0 +1,113 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+#if defined(__linux__)
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace ll
+{
+    namespace impl
+    {
+        using park_word = std::atomic<std::uint32_t>;
+
+        /// @brief Iterations spent spinning before parking.
+        constexpr int spin_iterations = 128;
+
+        inline void spin_pause() noexcept
+        {
+#if defined(__x86_64__) || defined(__i386__)
+            _mm_pause();
+#endif
+        }
+
+        /// @brief Spins while `w == old`, for at most `spin_iterations`
+        /// iterations. Returns `true` if the value changed.
+        inline bool spin_while_equal(const park_word& w, std::uint32_t old)
+        {
+            for(int i = 0; i < spin_iterations; ++i)
+            {
+                if(w.load(std::memory_order_acquire) != old) return true;
+                spin_pause();
+            }
+
+            return false;
+        }
+
+#if defined(__linux__)
+        inline long futex(park_word& w, int op, std::uint32_t val,
+            const timespec* timeout) noexcept
+        {
+            static_assert(sizeof(park_word) == sizeof(std::uint32_t), "");
+
+            return syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&w),
+                op, val, timeout, nullptr, 0);
+        }
+#endif
+
+        /// @brief Blocks while `w == old`. Can wake up spuriously.
+        inline void park_while_equal(park_word& w, std::uint32_t old)
+        {
+#if defined(__linux__)
+            futex(w, FUTEX_WAIT_PRIVATE, old, nullptr);
+#else
+            if(w.load(std::memory_order_acquire) == old)
+            {
+                std::this_thread::sleep_for(std::chrono::microseconds(50));
+            }
+#endif
+        }
+
+        /// @brief Blocks while `w == old`, at most until `deadline`. Can
+        /// wake up spuriously.
+        template <typename TClock, typename TDuration>
+        void park_while_equal_until(park_word& w, std::uint32_t old,
+            const std::chrono::time_point<TClock, TDuration>& deadline)
+        {
+            auto left = deadline - TClock::now();
+            if(left <= decltype(left)::zero()) return;
+
+#if defined(__linux__)
+            auto ns =
+                std::chrono::duration_cast<std::chrono::nanoseconds>(left)
+                    .count();
+
+            timespec ts;
+            ts.tv_sec = static_cast<time_t>(ns / 1000000000);
+            ts.tv_nsec = static_cast<long>(ns % 1000000000);
+
+            futex(w, FUTEX_WAIT_PRIVATE, old, &ts);
+#else
+            if(w.load(std::memory_order_acquire) == old)
+            {
+                std::this_thread::sleep_for(std::min(
+                    std::chrono::duration_cast<std::chrono::microseconds>(
+                        left),
+                    std::chrono::microseconds(50)));
+            }
+#endif
+        }
+
+        /// @brief Wakes all the threads parked on `w`.
+        inline void unpark_all(park_word& w) noexcept
+        {
+#if defined(__linux__)
+            futex(w, FUTEX_WAKE_PRIVATE, INT32_MAX, nullptr);
+#else
+            (void)w;
+#endif
+        }
+    }
+}
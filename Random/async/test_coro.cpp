@@ -0,0 +1,96 @@
+#include <atomic>
+#include <cassert>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <tuple>
+
+#include "./coro.hpp"
+
+// Checks `ll::co::task`, `when_all` and frame recycling. Requires C++20.
+// Run under TSan: the results of the children must be visible to the
+// awaiting coroutine.
+
+namespace co = ll::co;
+
+co::task<int> add_one(int x)
+{
+    co_return x + 1;
+}
+
+co::task<int> nested(co::scheduler& s, int x)
+{
+    co_await s.schedule();
+
+    auto a = co_await add_one(x);
+    auto b = co_await add_one(a);
+    co_return b;
+}
+
+co::task<void> touch(std::atomic<int>& ctr)
+{
+    ++ctr;
+    co_return;
+}
+
+co::task<std::string> name(int i)
+{
+    co_return "n" + std::to_string(i);
+}
+
+co::task<int> fan_out(co::scheduler& s, std::atomic<int>& ctr)
+{
+    co_await s.schedule();
+
+    auto [a, b, v, n] = co_await co::when_all(
+        nested(s, 1), add_one(10), touch(ctr), name(7));
+
+    static_assert(std::is_same_v<decltype(v), ll::nothing_t>);
+    assert(n == "n7");
+
+    co_await co::when_all(touch(ctr), touch(ctr));
+    co_return a + b;
+}
+
+void results(co::scheduler& s)
+{
+    assert(s.sync_wait(add_one(1)) == 2);
+    assert(s.sync_wait([&] { return nested(s, 1); }) == 3);
+
+    std::atomic<int> ctr{0};
+    assert(s.sync_wait([&] { return fan_out(s, ctr); }) == 3 + 11);
+    assert(ctr == 3);
+}
+
+void frames_are_recycled(co::scheduler& s)
+{
+    std::atomic<int> ctr{0};
+
+    for(int i = 0; i < 100; ++i)
+    {
+        s.sync_wait([&] { return fan_out(s, ctr); });
+    }
+
+    auto before = s.frame_heap_allocations();
+
+    for(int i = 0; i < 1000; ++i)
+    {
+        s.sync_wait([&] { return fan_out(s, ctr); });
+    }
+
+    assert(s.frame_heap_allocations() == before);
+    assert(ctr == 1100 * 3);
+}
+
+int main()
+{
+    ll::pool p{4};
+    ll::context ctx{p};
+    co::scheduler s{ctx};
+
+    results(s);
+    frames_are_recycled(s);
+
+    std::printf("ok\n");
+    return 0;
+}
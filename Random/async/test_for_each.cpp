@@ -0,0 +1,120 @@
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "./chains.hpp"
+
+// Checks `then_for_each` and `then_reduce`. Run under TSan: the elements
+// written by the chunks must be visible to the following nodes.
+
+void for_each_then_reduce(ll::context& ctx)
+{
+    std::vector<std::int64_t> v(100000);
+
+    auto results = ll::wait_until_complete(
+        ctx.build([&v] { std::iota(v.begin(), v.end(), 1); })
+            .then_for_each(v, [](std::int64_t& x) { x *= 2; })
+            .then_reduce(v, std::int64_t(0), std::plus<>{})
+            .then([](std::int64_t sum) { return sum + 1; }));
+
+    assert(std::get<0>(results) == 100000LL * 100001 + 1);
+}
+
+void ordered_reduction(ll::context& ctx)
+{
+    std::vector<std::string> letters;
+    std::string expected;
+
+    for(int i = 0; i < 1000; ++i)
+    {
+        letters.emplace_back(1, char('a' + i % 26));
+        expected += letters.back();
+    }
+
+    // Concatenation is associative but not commutative.
+    auto results = ll::wait_until_complete(ctx.build([] {}).then_reduce(
+        letters, std::string{">"}, std::plus<>{}));
+
+    assert(std::get<0>(results) == ">" + expected);
+}
+
+void empty_range(ll::context& ctx)
+{
+    std::vector<int> v;
+    int calls = 0;
+
+    auto results = ll::wait_until_complete(
+        ctx.build([] {})
+            .then_for_each(v, [&calls](int) { ++calls; })
+            .then_reduce(v, 42, std::plus<>{}));
+
+    assert(calls == 0);
+    assert(std::get<0>(results) == 42);
+}
+
+void restart(ll::context& ctx)
+{
+    std::vector<int> v(1000, 1);
+    std::atomic<int> done{0};
+    int sum = 0;
+
+    // `done` is set by `finally`: the `then` node still writes its result
+    // after its body returned.
+    auto chain = ctx.build([] {})
+                     .then_reduce(v, 0, std::plus<>{})
+                     .then([&sum](int x) { sum += x; })
+                     .finally([&done] { ++done; });
+
+    for(int i = 0; i < 1000; ++i)
+    {
+        // The range may be resized between runs.
+        v.push_back(1);
+
+        chain.start();
+        while(done != i + 1) std::this_thread::yield();
+    }
+
+    assert(sum == 1000 * 1000 + 1000 * 1001 / 2);
+}
+
+void cancelled(ll::context& ctx)
+{
+    ll::cancellation_source source;
+    source.request_cancellation();
+
+    std::vector<int> v(1000, 1);
+    std::atomic<int> calls{0};
+    std::atomic<bool> done{false};
+
+    auto chain = ctx.build([] {})
+                     .then_for_each(v, [&calls](int) { ++calls; })
+                     .then_reduce(v, 0, std::plus<>{})
+                     .finally([&done] { done = true; });
+
+    chain.cancel_with(source.token());
+    chain.start();
+    while(!done) std::this_thread::yield();
+
+    assert(calls == 0);
+    assert(!chain.parent().has_result());
+}
+
+int main()
+{
+    ll::pool p{4};
+    ll::context ctx{p};
+
+    for_each_then_reduce(ctx);
+    ordered_reduction(ctx);
+    empty_range(ctx);
+    restart(ctx);
+    cancelled(ctx);
+
+    std::printf("ok\n");
+    return 0;
+}
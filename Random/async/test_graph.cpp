@@ -0,0 +1,114 @@
+#include <atomic>
+#include <cassert>
+#include <cstdio>
+#include <memory>
+
+#include "./graph.hpp"
+
+// Checks that graph nodes run after all their predecessors, on every
+// execution. Run under TSan: the writes of the predecessors must be visible
+// to their successors.
+
+void diamond(ll::context& ctx)
+{
+    int a = 0, b = 0, c = 0, d = 0;
+
+    ll::graph g{ctx};
+    auto na = g.add([&] { ++a; });
+    auto nb = g.add([&] { b = a; }, {na});
+    auto nc = g.add([&] { c = a; }, {na});
+    g.add([&] { d = b + c; }, {nb, nc});
+
+    for(int i = 1; i <= 1000; ++i)
+    {
+        g.run();
+        assert(d == 2 * i);
+    }
+}
+
+void independent_chains(ll::context& ctx)
+{
+    // Two roots joined by a node, plus a sink that depends on a root only.
+    std::atomic<int> order{0};
+    int x = 0, y = 0, joined = 0, alone = 0;
+
+    ll::graph g{ctx};
+    auto nx = g.add([&] { x = ++order; });
+    auto ny = g.add([&] { y = ++order; });
+    auto nx2 = g.add([&] { x += 10; }, {nx});
+    g.add([&] { joined = x + y; }, {nx2, ny});
+    g.add([&] { alone = y; }, {ny});
+
+    for(int i = 0; i < 1000; ++i)
+    {
+        order = 0;
+        g.run();
+
+        assert(joined == 13);
+        assert(alone == y);
+    }
+}
+
+void wide(ll::context& ctx)
+{
+    constexpr int n = 64;
+    std::atomic<int> ran{0};
+    int total = 0;
+
+    ll::graph g{ctx};
+    auto first = g.add([] {});
+
+    ll::graph::node_id last;
+    for(int i = 0; i < n; ++i)
+    {
+        last = g.add([&ran] { ++ran; }, {first});
+    }
+
+    auto join = g.add([&] { total += ran.exchange(0); }, {last});
+    (void)join;
+
+    // Only `last` precedes `join`: the other branches are sinks, and the
+    // execution waits for them as well.
+    for(int i = 0; i < 100; ++i)
+    {
+        g.run();
+        total += ran.exchange(0);
+    }
+
+    assert(total == 100 * n);
+}
+
+void destroyed_after_wait(ll::context& ctx)
+{
+    // The owner destroys the graph as soon as `wait` returns, possibly
+    // while the thread that completed the last node is still in
+    // `graph::complete`. Run under ASan.
+    for(int i = 0; i < 1000; ++i)
+    {
+        std::atomic<int> ran{0};
+
+        auto g = std::make_unique<ll::graph>(ctx);
+        auto root = g->add([] {});
+        g->add([&ran] { ++ran; }, {root});
+        g->add([&ran] { ++ran; }, {root});
+
+        g->run();
+        g.reset();
+
+        assert(ran == 2);
+    }
+}
+
+int main()
+{
+    ll::pool p{4};
+    ll::context ctx{p};
+
+    diamond(ctx);
+    independent_chains(ctx);
+    wide(ctx);
+    destroyed_after_wait(ctx);
+
+    std::printf("ok\n");
+    return 0;
+}
@@ -0,0 +1,96 @@
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include "./latch.hpp"
+
+// Checks `ll::latch` and `ll::barrier`. Run under TSan: the writes made
+// before `count_down`/`arrive_and_wait` must be visible after the wait.
+
+void latch_releases_waiters()
+{
+    constexpr int n = 8;
+
+    ll::latch l{n};
+    int values[n]{};
+
+    std::vector<std::thread> threads;
+    for(int i = 0; i < n; ++i)
+    {
+        threads.emplace_back([&, i] {
+            values[i] = i;
+            l.count_down();
+        });
+    }
+
+    l.wait();
+    assert(l.try_wait());
+
+    for(int i = 0; i < n; ++i) assert(values[i] == i);
+    for(auto& t : threads) t.join();
+}
+
+void latch_zero_and_timeout()
+{
+    ll::latch zero{0};
+    zero.wait();
+    assert(zero.wait_for(std::chrono::seconds(1)) == std::cv_status::no_timeout);
+
+    ll::latch l{1};
+    assert(l.wait_for(std::chrono::milliseconds(20)) == std::cv_status::timeout);
+
+    std::thread t{[&l] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        l.count_down();
+    }};
+
+    assert(l.wait_for(std::chrono::seconds(10)) == std::cv_status::no_timeout);
+    t.join();
+
+    l.reset(2);
+    assert(!l.try_wait());
+    l.count_down(2);
+    l.wait();
+}
+
+void barrier_phases()
+{
+    constexpr int n = 4;
+    constexpr int phases = 1000;
+
+    ll::barrier b{n};
+    int slots[n]{};
+
+    std::vector<std::thread> threads;
+    for(int i = 0; i < n; ++i)
+    {
+        threads.emplace_back([&, i] {
+            for(int p = 1; p <= phases; ++p)
+            {
+                slots[i] = p;
+                b.arrive_and_wait();
+
+                // Everyone wrote phase `p` before anyone leaves it...
+                for(int j = 0; j < n; ++j) assert(slots[j] == p);
+
+                // ...and nobody writes phase `p + 1` before everyone read.
+                b.arrive_and_wait();
+            }
+        });
+    }
+
+    for(auto& t : threads) t.join();
+}
+
+int main()
+{
+    latch_releases_waiters();
+    latch_zero_and_timeout();
+    barrier_phases();
+
+    std::printf("ok\n");
+    return 0;
+}
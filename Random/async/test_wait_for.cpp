@@ -0,0 +1,81 @@
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+
+#include "./chains.hpp"
+
+// Checks `ll::wait_for` and cancellation tokens. Run under ASan/TSan: timed
+// out chains must not touch the stack of the waiter, and their shared state
+// must be freed.
+
+void completes_in_time(ll::context& ctx)
+{
+    auto result = ll::wait_for(std::chrono::seconds(10),
+        ctx.build([] { return 10; }).then([](int x) { return x + 1; }),
+        ctx.build([] { return 2.f; })
+            .wait_all([](float x) { return x * 2; }, [](float x) { return x; }));
+
+    assert(result.has_value());
+    assert(std::get<0>(*result) == 11);
+    assert(std::get<1>(std::get<1>(*result)) == 2.f);
+}
+
+void times_out(ll::context& ctx)
+{
+    static std::atomic<int> stages{0};
+    static std::atomic<bool> release{false};
+    stages = 0;
+
+    auto result = ll::wait_for(std::chrono::milliseconds(20),
+        ctx.build([] {
+               ++stages;
+
+               // Blocks until the waiter timed out.
+               while(!release) std::this_thread::yield();
+           })
+            .then([] { ++stages; })
+            .wait_all([] { ++stages; }, [] { ++stages; })
+            .then([] { ++stages; }));
+
+    assert(!result.has_value());
+    release = true;
+
+    // Cancelled: the remaining stages are skipped.
+    ll::sleep_ms(50);
+    assert(stages == 1);
+}
+
+void explicit_token(ll::context& ctx)
+{
+    ll::cancellation_source source;
+    std::atomic<int> stages{0};
+    std::atomic<bool> done{false};
+
+    auto chain = ctx.build([&] { ++stages; })
+                     .then([&] {
+                         ++stages;
+                         source.request_cancellation();
+                     })
+                     .then([&] { ++stages; })
+                     .finally([&] { done = true; });
+
+    chain.cancel_with(source.token());
+    chain.start();
+
+    while(!done) std::this_thread::yield();
+    assert(stages == 2);
+}
+
+int main()
+{
+    ll::pool p{2};
+    ll::context ctx{p};
+
+    completes_in_time(ctx);
+    times_out(ctx);
+    explicit_token(ctx);
+
+    std::puts("ok");
+    return 0;
+}
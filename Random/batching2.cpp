@@ -1,5 +1,16 @@
+#include <chrono>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <unordered_map>
 #include <SSVStart/SSVStart.hpp>
 
+#if defined(__GNUC__) && defined(__SSE2__) && \
+    (defined(__x86_64__) || defined(__i386__))
+#define BATCH_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
 namespace Boilerplate
 {
     class App
@@ -169,8 +180,15 @@ public:
     inline auto get(float mX) const noexcept
     {
         SSVU_ASSERT(mX >= 0.f && mX <= ssvu::tau);
-        return arr[ssvu::toInt(mX * ratio)];
+
+        // `tau * ratio` can round to `TPrecision`. The index is clamped to
+        // the table even if the assertion is disabled.
+        auto i(ssvu::toInt(mX * ratio));
+        return arr[std::max(0, std::min(i, int(TPrecision) - 1))];
     }
+
+    inline static constexpr auto getRatio() noexcept { return ratio; }
+    inline const auto* getData() const noexcept { return arr.data(); }
 };
 
 static constexpr ssvu::SizeT tablePrecision{628};
@@ -229,6 +247,146 @@ namespace Batch
                     ssvu::toFloat(mTexture.getSize().y));
             }
         };
+
+        /// @brief Packs the draw order of a sprite: `zOrder` first, then the
+        /// dense id of its texture.
+        inline auto makeSortKey(
+            ssvu::SizeT mZOrder, std::uint32_t mTextureId) noexcept
+        {
+            SSVU_ASSERT(mZOrder <= 0xFFFFFFFFu);
+            return (std::uint64_t(mZOrder) << 32) | mTextureId;
+        }
+
+        /// @brief Assigns dense ids to textures, the first time they are
+        /// used.
+        /// @details Sprites are usually submitted in runs sharing a texture:
+        /// the last texture and its id are cached, and the map is only
+        /// looked up when the texture changes.
+        class TextureIds
+        {
+        private:
+            std::unordered_map<const sf::Texture*, std::uint32_t> ids;
+            const sf::Texture* lastTexture{nullptr};
+            std::uint32_t lastId{0u};
+
+        public:
+            inline auto get(const sf::Texture* mX)
+            {
+                if(mX == lastTexture) return lastId;
+
+                auto id(static_cast<std::uint32_t>(ids.size()));
+                lastId = ids.emplace(mX, id).first->second;
+                lastTexture = mX;
+
+                return lastId;
+            }
+        };
+
+        /// @brief Computes the draw order of a frame from the sort keys of
+        /// its sprites, in submission order.
+        /// @details If the keys are the same as in the previous frame, the
+        /// previous order is reused; if they are already sorted, the order
+        /// is the identity. Otherwise the indices are sorted with a stable
+        /// LSD radix sort on 8-bit digits, skipping the digits that are the
+        /// same in every key.
+        class KeySorter
+        {
+        private:
+            static constexpr ssvu::SizeT digitCount{8};
+            static constexpr ssvu::SizeT bucketCount{256};
+
+            std::vector<std::uint64_t> keys, prevKeys, keysBuf[2];
+            std::vector<std::uint32_t> order, orderBuf[2];
+
+            inline static auto getDigit(
+                std::uint64_t mKey, ssvu::SizeT mD) noexcept
+            {
+                return (mKey >> (mD * 8)) & (bucketCount - 1);
+            }
+
+            inline void radixSort()
+            {
+                auto n(keys.size());
+                std::array<std::array<std::uint32_t, bucketCount>, digitCount>
+                    hist{};
+
+                for(auto k : keys)
+                    for(auto d(0u); d < digitCount; ++d)
+                        ++hist[d][getDigit(k, d)];
+
+                // The first pass reads the keys in submission order.
+                const std::uint64_t* srcKeys{keys.data()};
+                const std::uint32_t* srcOrder{nullptr};
+                auto buf(0u);
+
+                for(auto d(0u); d < digitCount; ++d)
+                {
+                    auto& h(hist[d]);
+                    if(h[getDigit(keys[0], d)] == n) continue;
+
+                    std::uint32_t offset{0u};
+                    for(auto& x : h)
+                    {
+                        auto count(x);
+                        x = offset;
+                        offset += count;
+                    }
+
+                    auto& dstKeys(keysBuf[buf]);
+                    auto& dstOrder(orderBuf[buf]);
+                    dstKeys.resize(n);
+                    dstOrder.resize(n);
+
+                    for(auto i(0u); i < n; ++i)
+                    {
+                        auto k(srcKeys[i]);
+                        auto pos(h[getDigit(k, d)]++);
+                        dstKeys[pos] = k;
+                        dstOrder[pos] = srcOrder == nullptr ? i : srcOrder[i];
+                    }
+
+                    srcKeys = dstKeys.data();
+                    srcOrder = dstOrder.data();
+                    buf = 1 - buf;
+                }
+
+                if(srcOrder == nullptr)
+                    std::iota(order.begin(), order.end(), 0u);
+                else
+                    std::copy(srcOrder, srcOrder + n, order.begin());
+            }
+
+        public:
+            inline void push(std::uint64_t mKey) { keys.emplace_back(mKey); }
+
+            inline auto getStagedBytes() const noexcept
+            {
+                return keys.size() * sizeof(std::uint64_t);
+            }
+
+            /// @brief Returns the indices of the pushed keys in draw order.
+            inline const auto& sort()
+            {
+                if(keys == prevKeys) return order;
+
+                order.resize(keys.size());
+
+                if(std::is_sorted(keys.begin(), keys.end()))
+                    std::iota(order.begin(), order.end(), 0u);
+                else
+                    radixSort();
+
+                return order;
+            }
+
+            /// @brief Keeps the keys of this frame for the coherence check,
+            /// and clears them.
+            inline void nextFrame() noexcept
+            {
+                std::swap(keys, prevKeys);
+                keys.clear();
+            }
+        };
     }
 
     class Manager;
@@ -252,6 +410,12 @@ namespace Batch
             textureData.set(mX);
         }
 
+        /// @brief Overrides the size taken from the texture, as
+        /// `BatchSpriteSoA::setTextureSize`.
+        inline void setTextureSize(float mSizeX, float mSizeY) noexcept
+        {
+            textureData.set(mSizeX, mSizeY);
+        }
 
         inline void setZOrder(std::size_t mX) noexcept { zOrder = mX; }
         template <typename T>
@@ -303,8 +467,10 @@ namespace Batch
                     position.y};
         }
 
-        template <typename T>
-        inline void emplaceVertices(T& mV) const
+        /// @brief Calls `mF(i, point, texCoords)` for the four corners of
+        /// the sprite.
+        template <typename TF>
+        inline void forVertices(const TF& mF) const
         {
             const auto& hs(getHalfTextureSize());
             const auto& tOrigin(origin - getHalfTextureSize());
@@ -312,83 +478,542 @@ namespace Batch
             auto sSin(rSin * scale.y);
             auto sCos(rCos * scale.x);
 
+            auto erv([this, &mF, &tOrigin, &sSin, &sCos](
+                auto mI, auto mX, auto mY, const auto& mTp)
+                {
+                    mF(mI, getRotatedPoint(mX, mY, sSin, sCos, tOrigin), mTp);
+                });
+
+            erv(0, -hs.x, -hs.y, textureData.nw);
+            erv(1, +hs.x, -hs.y, textureData.ne);
+            erv(2, +hs.x, +hs.y, textureData.se);
+            erv(3, -hs.x, +hs.y, textureData.sw);
+        }
+
+    public:
+        /// @brief Emplaces the `Impl::DrawData` of the sprite in `mV`.
+        template <typename T>
+        inline void emplaceVertices(T& mV) const
+        {
             mV.emplace_back();
             auto& d(mV.back());
 
             d.zOrder = zOrder;
             d.texture = texture;
 
-            auto erv([this, &d, &tOrigin, &sSin, &sCos](
-                auto mI, auto mX, auto mY, const auto& mTp)
+            forVertices([&d](auto mI, const auto& mP, const auto& mTp)
                 {
-                    d.points[mI] = getRotatedPoint(mX, mY, sSin, sCos, tOrigin);
+                    d.points[mI] = mP;
                     d.tp[mI] = mTp;
                 });
+        }
+
+        /// @brief Writes the four vertices of the sprite to `mOut`.
+        inline void writeVertices(sf::Vertex* mOut) const noexcept
+        {
+            forVertices([mOut](auto mI, const auto& mP, const auto& mTp)
+                {
+                    mOut[mI] = sf::Vertex{mP, sf::Color::White, mTp};
+                });
+        }
+    };
 
-            erv(0, -hs.x, -hs.y, textureData.nw);
-            erv(1, +hs.x, -hs.y, textureData.ne);
-            erv(2, +hs.x, +hs.y, textureData.se);
-            erv(3, -hs.x, +hs.y, textureData.sw);
+    /// @brief Sprites sharing a texture, in structure-of-arrays form, whose
+    /// vertices are generated in bulk by `emplaceVertices`.
+    class BatchSpriteSoA
+    {
+        friend class Manager;
+
+    private:
+        std::vector<float> x, y, originX, originY, scaleX, scaleY;
+
+        // Wrapped to `[0, tau]`, as by `BatchSprite::setRadians`.
+        std::vector<float> radians;
+
+        const sf::Texture* texture;
+        Impl::TextureData textureData;
+
+    public:
+        inline BatchSpriteSoA(const sf::Texture& mTexture) noexcept
+            : texture{&mTexture}
+        {
+            textureData.set(mTexture);
+        }
+
+        inline void emplace(const sf::Vector2f& mPosition,
+            const sf::Vector2f& mOrigin, const sf::Vector2f& mScale,
+            float mRadians)
+        {
+            x.emplace_back(mPosition.x);
+            y.emplace_back(mPosition.y);
+            originX.emplace_back(mOrigin.x);
+            originY.emplace_back(mOrigin.y);
+            scaleX.emplace_back(mScale.x);
+            scaleY.emplace_back(mScale.y);
+            radians.emplace_back(ssvu::getWrapRad(mRadians));
+        }
+
+        inline void clear() noexcept
+        {
+            for(auto v : {&x, &y, &originX, &originY, &scaleX, &scaleY,
+                    &radians})
+                v->clear();
+        }
+
+        /// @brief Overrides the size taken from the texture, e.g. to draw
+        /// the top-left part of it.
+        inline void setTextureSize(float mSizeX, float mSizeY) noexcept
+        {
+            textureData.set(mSizeX, mSizeY);
+        }
+
+        inline auto size() const noexcept { return x.size(); }
+
+        /// @brief Checked by `Impl::emplaceVertices`: the arrays are only
+        /// changed together, by `emplace` and `clear`.
+        inline bool hasEqualSizes() const noexcept
+        {
+            for(auto v : {&y, &originX, &originY, &scaleX, &scaleY, &radians})
+                if(v->size() != x.size()) return false;
+
+            return true;
+        }
+
+        inline const auto& getX() const noexcept { return x; }
+        inline const auto& getY() const noexcept { return y; }
+        inline const auto& getOriginX() const noexcept { return originX; }
+        inline const auto& getOriginY() const noexcept { return originY; }
+        inline const auto& getScaleX() const noexcept { return scaleX; }
+        inline const auto& getScaleY() const noexcept { return scaleY; }
+        inline const auto& getRadians() const noexcept { return radians; }
+
+        inline const auto& getTexture() const noexcept { return *texture; }
+        inline const auto& getTextureData() const noexcept
+        {
+            return textureData;
         }
     };
 
+    namespace Impl
+    {
+        /// @brief Writes the quad of every sprite of `mS` in `[mB, mE)` to
+        /// `mOut`, four vertices per sprite, with the same math as
+        /// `BatchSprite::emplaceVertices`.
+        inline void emplaceVerticesScalar(const BatchSpriteSoA& mS,
+            ssvu::SizeT mB, ssvu::SizeT mE, sf::Vertex* mOut) noexcept
+        {
+            const auto& td(mS.getTextureData());
+            const auto& hs(td.halfSize);
+            const std::array<sf::Vector2f, 4> tps{td.nw, td.ne, td.se, td.sw};
+            const std::array<float, 4> cxs{-hs.x, +hs.x, +hs.x, -hs.x};
+            const std::array<float, 4> cys{-hs.y, -hs.y, +hs.y, +hs.y};
+
+            const auto &x(mS.getX()), &y(mS.getY());
+            const auto &originX(mS.getOriginX()), &originY(mS.getOriginY());
+            const auto &scaleX(mS.getScaleX()), &scaleY(mS.getScaleY());
+            const auto& radians(mS.getRadians());
+
+            for(auto i(mB); i < mE; ++i)
+            {
+                auto tOriginX(originX[i] - hs.x);
+                auto tOriginY(originY[i] - hs.y);
+                auto sSin(getSin(radians[i]) * scaleY[i]);
+                auto sCos(getCos(radians[i]) * scaleX[i]);
+
+                for(auto c(0u); c < 4; ++c, ++mOut)
+                {
+                    auto dx(tOriginX - cxs[c]), dy(tOriginY - cys[c]);
+
+                    mOut->position = sf::Vector2f{
+                        dx * sCos - dy * sSin + x[i],
+                        dy * sCos + dx * sSin + y[i]};
+                    mOut->color = sf::Color::White;
+                    mOut->texCoords = tps[c];
+                }
+            }
+        }
+
+#if defined(BATCH_SIMD_X86)
+        /// @brief Writes the quads of `TW` sprites starting at `mI`, from
+        /// the corner positions computed in SIMD registers.
+        template <ssvu::SizeT TW>
+        inline void storeQuads(const BatchSpriteSoA& mS,
+            const float (&mPx)[4][TW], const float (&mPy)[4][TW],
+            sf::Vertex* mOut) noexcept
+        {
+            const auto& td(mS.getTextureData());
+            const std::array<sf::Vector2f, 4> tps{td.nw, td.ne, td.se, td.sw};
+
+            for(auto s(0u); s < TW; ++s)
+                for(auto c(0u); c < 4; ++c, ++mOut)
+                {
+                    mOut->position = sf::Vector2f{mPx[c][s], mPy[c][s]};
+                    mOut->color = sf::Color::White;
+                    mOut->texCoords = tps[c];
+                }
+        }
+
+        /// @brief As `emplaceVerticesScalar`, four sprites at a time with
+        /// SSE2, which has no gather: the tables are read one lane at a
+        /// time.
+        inline void emplaceVerticesSSE(const BatchSpriteSoA& mS,
+            ssvu::SizeT mB, ssvu::SizeT mE, sf::Vertex* mOut) noexcept
+        {
+            constexpr ssvu::SizeT w{4};
+
+            const auto& hs(mS.getTextureData().halfSize);
+            const __m128 hx(_mm_set1_ps(hs.x)), hy(_mm_set1_ps(hs.y));
+            const __m128 cxs[4]{_mm_set1_ps(-hs.x), _mm_set1_ps(+hs.x),
+                _mm_set1_ps(+hs.x), _mm_set1_ps(-hs.x)};
+            const __m128 cys[4]{_mm_set1_ps(-hs.y), _mm_set1_ps(-hs.y),
+                _mm_set1_ps(+hs.y), _mm_set1_ps(+hs.y)};
+
+            const auto* sinTable(getSinTable().getData());
+            const auto* cosTable(getCosTable().getData());
+            const __m128 ratio(_mm_set1_ps(getSinTable().getRatio()));
+
+            const auto &x(mS.getX()), &y(mS.getY());
+            const auto &originX(mS.getOriginX()), &originY(mS.getOriginY());
+            const auto &scaleX(mS.getScaleX()), &scaleY(mS.getScaleY());
+            const auto& radians(mS.getRadians());
+
+            auto i(mB);
+            for(; i + w <= mE; i += w, mOut += w * 4)
+            {
+                // Same index as `TrigTable::get`.
+                alignas(16) std::int32_t idxs[w];
+                _mm_store_si128(reinterpret_cast<__m128i*>(idxs),
+                    _mm_cvttps_epi32(
+                        _mm_mul_ps(_mm_loadu_ps(&radians[i]), ratio)));
+
+                alignas(16) float sins[w], coss[w];
+                for(auto s(0u); s < w; ++s)
+                {
+                    auto idx(std::max(std::min(idxs[s],
+                                          std::int32_t(tablePrecision - 1)),
+                        std::int32_t(0)));
+                    sins[s] = sinTable[idx];
+                    coss[s] = cosTable[idx];
+                }
+
+                auto tOriginX(_mm_sub_ps(_mm_loadu_ps(&originX[i]), hx));
+                auto tOriginY(_mm_sub_ps(_mm_loadu_ps(&originY[i]), hy));
+                auto sSin(_mm_mul_ps(
+                    _mm_load_ps(sins), _mm_loadu_ps(&scaleY[i])));
+                auto sCos(_mm_mul_ps(
+                    _mm_load_ps(coss), _mm_loadu_ps(&scaleX[i])));
+                auto px(_mm_loadu_ps(&x[i])), py(_mm_loadu_ps(&y[i]));
+
+                float outX[4][w], outY[4][w];
+                for(auto c(0u); c < 4; ++c)
+                {
+                    auto dx(_mm_sub_ps(tOriginX, cxs[c]));
+                    auto dy(_mm_sub_ps(tOriginY, cys[c]));
+
+                    _mm_storeu_ps(outX[c],
+                        _mm_add_ps(_mm_sub_ps(_mm_mul_ps(dx, sCos),
+                                       _mm_mul_ps(dy, sSin)),
+                            px));
+                    _mm_storeu_ps(outY[c],
+                        _mm_add_ps(_mm_add_ps(_mm_mul_ps(dy, sCos),
+                                       _mm_mul_ps(dx, sSin)),
+                            py));
+                }
+
+                storeQuads(mS, outX, outY, mOut);
+            }
+
+            emplaceVerticesScalar(mS, i, mE, mOut);
+        }
+
+        /// @brief As `emplaceVerticesScalar`, eight sprites at a time with
+        /// AVX2, gathering from the trigonometric tables.
+        __attribute__((target("avx2"))) inline void emplaceVerticesAVX2(
+            const BatchSpriteSoA& mS, ssvu::SizeT mB, ssvu::SizeT mE,
+            sf::Vertex* mOut) noexcept
+        {
+            constexpr ssvu::SizeT w{8};
+
+            const auto& hs(mS.getTextureData().halfSize);
+            const __m256 hx(_mm256_set1_ps(hs.x)), hy(_mm256_set1_ps(hs.y));
+            const __m256 cxs[4]{_mm256_set1_ps(-hs.x), _mm256_set1_ps(+hs.x),
+                _mm256_set1_ps(+hs.x), _mm256_set1_ps(-hs.x)};
+            const __m256 cys[4]{_mm256_set1_ps(-hs.y), _mm256_set1_ps(-hs.y),
+                _mm256_set1_ps(+hs.y), _mm256_set1_ps(+hs.y)};
+
+            const auto& sinTable(getSinTable());
+            const auto& cosTable(getCosTable());
+            const __m256 ratio(_mm256_set1_ps(sinTable.getRatio()));
+            const __m256i minIdx(_mm256_setzero_si256());
+            const __m256i maxIdx(_mm256_set1_epi32(tablePrecision - 1));
+
+            const auto &x(mS.getX()), &y(mS.getY());
+            const auto &originX(mS.getOriginX()), &originY(mS.getOriginY());
+            const auto &scaleX(mS.getScaleX()), &scaleY(mS.getScaleY());
+            const auto& radians(mS.getRadians());
+
+            auto i(mB);
+            for(; i + w <= mE; i += w, mOut += w * 4)
+            {
+                // Same index as `TrigTable::get`.
+                auto idx(_mm256_max_epi32(
+                    _mm256_min_epi32(
+                        _mm256_cvttps_epi32(
+                            _mm256_mul_ps(_mm256_loadu_ps(&radians[i]), ratio)),
+                        maxIdx),
+                    minIdx));
+
+                auto sins(_mm256_i32gather_ps(sinTable.getData(), idx, 4));
+                auto coss(_mm256_i32gather_ps(cosTable.getData(), idx, 4));
+
+                auto tOriginX(
+                    _mm256_sub_ps(_mm256_loadu_ps(&originX[i]), hx));
+                auto tOriginY(
+                    _mm256_sub_ps(_mm256_loadu_ps(&originY[i]), hy));
+                auto sSin(_mm256_mul_ps(sins, _mm256_loadu_ps(&scaleY[i])));
+                auto sCos(_mm256_mul_ps(coss, _mm256_loadu_ps(&scaleX[i])));
+                auto px(_mm256_loadu_ps(&x[i]));
+                auto py(_mm256_loadu_ps(&y[i]));
+
+                float outX[4][w], outY[4][w];
+                for(auto c(0u); c < 4; ++c)
+                {
+                    auto dx(_mm256_sub_ps(tOriginX, cxs[c]));
+                    auto dy(_mm256_sub_ps(tOriginY, cys[c]));
+
+                    _mm256_storeu_ps(outX[c],
+                        _mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(dx, sCos),
+                                          _mm256_mul_ps(dy, sSin)),
+                            px));
+                    _mm256_storeu_ps(outY[c],
+                        _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dy, sCos),
+                                          _mm256_mul_ps(dx, sSin)),
+                            py));
+                }
+
+                storeQuads(mS, outX, outY, mOut);
+            }
+
+            emplaceVerticesScalar(mS, i, mE, mOut);
+        }
+#endif
+
+        /// @brief Draws `mCount` vertices of `mVs` as quads textured with
+        /// `mTexture` on `mX`: an `sf::RenderTarget`, or any type with the
+        /// same `draw` overload.
+        template <typename TTarget>
+        inline void drawQuads(TTarget& mX, const sf::Vertex* mVs,
+            ssvu::SizeT mCount, const sf::Texture* mTexture)
+        {
+            mX.draw(mVs, mCount, sf::PrimitiveType::Quads,
+                sf::RenderStates{mTexture});
+        }
+
+        enum class VertexKernel
+        {
+            Scalar,
+            SSE,
+            AVX2
+        };
+
+        /// @brief Best kernel supported by the CPU.
+        inline auto getBestVertexKernel() noexcept
+        {
+#if defined(BATCH_SIMD_X86)
+            static const auto result(__builtin_cpu_supports("avx2")
+                                         ? VertexKernel::AVX2
+                                         : VertexKernel::SSE);
+            return result;
+#else
+            return VertexKernel::Scalar;
+#endif
+        }
+
+        /// @brief Writes the quads of all the sprites of `mS` to `mOut`,
+        /// which must have room for `mS.size() * 4` vertices.
+        inline void emplaceVertices(const BatchSpriteSoA& mS,
+            sf::Vertex* mOut,
+            VertexKernel mKernel = getBestVertexKernel()) noexcept
+        {
+            SSVU_ASSERT(mKernel <= getBestVertexKernel());
+            SSVU_ASSERT(mS.hasEqualSizes());
+
+            switch(mKernel)
+            {
+#if defined(BATCH_SIMD_X86)
+                case VertexKernel::AVX2:
+                    emplaceVerticesAVX2(mS, 0, mS.size(), mOut);
+                    return;
+                case VertexKernel::SSE:
+                    emplaceVerticesSSE(mS, 0, mS.size(), mOut);
+                    return;
+#endif
+                default: emplaceVerticesScalar(mS, 0, mS.size(), mOut);
+            }
+        }
+    }
+
     class Manager
     {
     private:
         std::vector<Impl::DrawData> zvs;
+        Impl::KeySorter sorter;
+        Impl::TextureIds textureIds;
         // std::vector<sf::Vertex> vs;
 
         ssvu::GrowableArray<sf::Vertex> vs;
         ssvu::SizeT vsCap{0u};
 
+        using StreamDrawFn = void (*)(
+            void*, const sf::Vertex*, ssvu::SizeT, const sf::Texture*);
 
-    public:
-        inline void drawOn(sf::RenderTarget& mX) noexcept
+        // Streaming state: target and how to draw on it, texture and vertex
+        // count of the pending draw call, and the last streamed `zOrder`.
+        void* streamTarget{nullptr};
+        StreamDrawFn streamDraw{nullptr};
+        const sf::Texture* streamTexture{nullptr};
+        ssvu::SizeT streamCount{0u}, streamZOrder{0u};
+
+        template <typename TTarget>
+        inline static void drawStreamOn(void* mX, const sf::Vertex* mVs,
+            ssvu::SizeT mCount, const sf::Texture* mTexture)
         {
-            ssvu::sort(zvs, [](const auto& mA, const auto& mB)
-                {
-                    if(mA.zOrder < mB.zOrder) return true;
-                    if(mA.zOrder > mB.zOrder) return false;
+            Impl::drawQuads(
+                *static_cast<TTarget*>(mX), mVs, mCount, mTexture);
+        }
 
-                    return mA.texture < mB.texture;
-                });
+        inline void growVerticesIfNeeded(ssvu::SizeT mCount)
+        {
+            if(mCount <= vsCap) return;
 
-            auto newCap(zvs.size() * 4);
-            if(newCap != vsCap)
-            {
-                vs.grow(vsCap, newCap);
-                vsCap = newCap;
-            }
+            vs.grow(vsCap, mCount);
+            vsCap = mCount;
+        }
+
+        inline void flushStream()
+        {
+            if(streamCount == 0) return;
+
+            streamDraw(streamTarget, vs.getDataPtr(), streamCount,
+                streamTexture);
+            streamCount = 0;
+        }
+
+    public:
+        /// @brief Draws the queued sprites on `mX`: an `sf::RenderTarget`,
+        /// or any type with the same `draw` overload.
+        template <typename TTarget>
+        inline void drawOn(TTarget& mX) noexcept
+        {
+            // `vs` may hold the vertices of a pending stream.
+            SSVU_ASSERT(streamTarget == nullptr);
+
+            const auto& order(sorter.sort());
+            growVerticesIfNeeded(zvs.size() * 4);
 
 
-            auto curr(zvs.data());
-            auto end(curr + zvs.size());
+            auto curr(order.data());
+            auto end(curr + order.size());
 
             while(curr != end)
             {
                 // vs.clear();
                 auto cv(vs.getDataPtr());
-                auto tx(curr->texture);
+                auto tx(zvs[*curr].texture);
 
                 do
                 {
+                    const auto& d(zvs[*curr]);
                     for(auto i(0u); i < 4; ++i, ++cv)
                     {
-                        cv->position = curr->points[i];
-                        cv->texCoords = curr->tp[i];
+                        cv->position = d.points[i];
+                        cv->texCoords = d.tp[i];
                     }
 
                     ++curr;
-                } while(curr->texture == tx);
+                } while(curr != end && zvs[*curr].texture == tx);
 
-                mX.draw(vs.getDataPtr(), cv - vs.getDataPtr(),
-                    sf::PrimitiveType::Quads, sf::RenderStates{tx});
+                Impl::drawQuads(
+                    mX, vs.getDataPtr(), cv - vs.getDataPtr(), tx);
             }
 
             zvs.clear();
+            sorter.nextFrame();
+        }
+
+        /// @brief Draws the sprites of `mS` with a single draw call,
+        /// generating their vertices directly in the vertex buffer.
+        template <typename TTarget>
+        inline void drawOn(TTarget& mX, const BatchSpriteSoA& mS)
+        {
+            SSVU_ASSERT(streamTarget == nullptr);
+
+            growVerticesIfNeeded(mS.size() * 4);
+            Impl::emplaceVertices(mS, vs.getDataPtr());
+
+            Impl::drawQuads(mX, vs.getDataPtr(), mS.size() * 4, mS.texture);
+        }
+
+        inline void enqueue(const BatchSprite& mX)
+        {
+            mX.emplaceVertices(zvs);
+            sorter.push(
+                Impl::makeSortKey(mX.zOrder, textureIds.get(mX.texture)));
         }
 
-        inline void enqueue(const BatchSprite& mX) { mX.emplaceVertices(zvs); }
+        /// @brief Starts streaming sprites to `mX`, bypassing the queue.
+        /// @details Streamed sprites must already be in draw order: sorted
+        /// by `zOrder` and, within a layer, grouped by texture. Their
+        /// vertices are written once, directly in the vertex buffer, and a
+        /// draw call is issued whenever the texture changes. `mX` is an
+        /// `sf::RenderTarget`, or any type with the same `draw` overload.
+        template <typename TTarget>
+        inline void beginStream(TTarget& mX) noexcept
+        {
+            SSVU_ASSERT(streamTarget == nullptr);
+
+            streamTarget = &mX;
+            streamDraw = &drawStreamOn<TTarget>;
+            streamTexture = nullptr;
+            streamZOrder = 0;
+        }
+
+        inline void stream(const BatchSprite& mX)
+        {
+            SSVU_ASSERT(streamTarget != nullptr);
+            SSVU_ASSERT(mX.zOrder >= streamZOrder);
+
+            if(mX.texture != streamTexture)
+            {
+                flushStream();
+                streamTexture = mX.texture;
+            }
+
+            if(streamCount + 4 > vsCap)
+                growVerticesIfNeeded(std::max(vsCap * 2, streamCount + 4));
+
+            mX.writeVertices(vs.getDataPtr() + streamCount);
+            streamCount += 4;
+            streamZOrder = mX.zOrder;
+        }
+
+        /// @brief Issues the pending draw call and stops streaming.
+        inline void endStream()
+        {
+            SSVU_ASSERT(streamTarget != nullptr);
+
+            flushStream();
+            streamTarget = nullptr;
+            streamDraw = nullptr;
+        }
+
+        /// @brief Bytes of the queued sprites, staged until `drawOn` copies
+        /// them to the vertex buffer.
+        inline auto getStagedBytes() const noexcept
+        {
+            return zvs.size() * sizeof(Impl::DrawData) +
+                   sorter.getStagedBytes();
+        }
 
         /*inline void directDraw(sf::RenderTarget& mRT, const BatchSprite& mX)
         {
@@ -423,6 +1048,423 @@ namespace Batch
     }*/
 }
 
+// Vertex positions computed by different paths with the same operations in
+// the same order: only FP contraction (e.g. `-march=native`, with FMA) can
+// make them differ.
+inline bool isNearPosition(
+    const sf::Vector2f& mA, const sf::Vector2f& mB) noexcept
+{
+#if defined(__FMA__)
+    constexpr float tolerance{1e-3f};
+#else
+    constexpr float tolerance{0.f};
+#endif
+
+    return std::abs(mA.x - mB.x) <= tolerance &&
+           std::abs(mA.y - mB.y) <= tolerance;
+}
+
+SSVUT_TEST(BatchSpriteSoAVertices)
+{
+    using namespace Batch;
+    using namespace Batch::Impl;
+
+    sf::Texture texture;
+    BatchSpriteSoA soa{texture};
+    soa.setTextureSize(32.f, 8.f);
+
+    std::minstd_rand rng{1234u};
+    auto rnd([&rng](float mMin, float mMax)
+        {
+            return std::uniform_real_distribution<float>{mMin, mMax}(rng);
+        });
+
+    // The reference is `BatchSprite::emplaceVertices`, for the same
+    // sprites. Not a multiple of 8 or 4: the SIMD kernels finish with
+    // scalar code.
+    std::vector<DrawData> zvs;
+    for(auto i(0u); i < 37; ++i)
+    {
+        sf::Vector2f position{rnd(0.f, 800.f), rnd(0.f, 600.f)};
+        sf::Vector2f origin{rnd(0.f, 16.f), rnd(0.f, 4.f)};
+        sf::Vector2f scale{rnd(0.1f, 2.f), rnd(0.1f, 2.f)};
+        auto radians(rnd(-10.f, 10.f));
+
+        BatchSprite s{texture};
+        s.setTextureSize(32.f, 8.f);
+        s.setZOrder(0);
+        s.setPosition(position);
+        s.setOrigin(origin);
+        s.setScale(scale);
+        s.setRadians(radians);
+        s.emplaceVertices(zvs);
+
+        soa.emplace(position, origin, scale, radians);
+    }
+
+    std::vector<sf::Vertex> actual(soa.size() * 4);
+    for(auto k : {VertexKernel::Scalar, VertexKernel::SSE, VertexKernel::AVX2})
+    {
+        if(k > getBestVertexKernel()) continue;
+
+        emplaceVertices(soa, actual.data(), k);
+        for(auto i(0u); i < actual.size(); ++i)
+        {
+            const auto& d(zvs[i / 4]);
+            const auto& a(actual[i]);
+
+            SSVUT_EXPECT(isNearPosition(d.points[i % 4], a.position));
+            SSVUT_EXPECT(d.tp[i % 4].x == a.texCoords.x);
+            SSVUT_EXPECT(d.tp[i % 4].y == a.texCoords.y);
+        }
+    }
+}
+
+SSVUT_TEST(ManagerStreamVertices)
+{
+    using namespace Batch;
+
+    // Records the draw calls issued by `Manager`.
+    struct DrawRecorder
+    {
+        std::vector<const sf::Texture*> textures;
+        std::vector<std::vector<sf::Vertex>> vertices;
+
+        inline void draw(const sf::Vertex* mVs, std::size_t mCount,
+            sf::PrimitiveType, const sf::RenderStates& mStates)
+        {
+            textures.emplace_back(mStates.texture);
+            vertices.emplace_back(mVs, mVs + mCount);
+        }
+    };
+
+    std::array<sf::Texture, 3> textures;
+    std::minstd_rand rng{1234u};
+    auto rnd([&rng](float mMin, float mMax)
+        {
+            return std::uniform_real_distribution<float>{mMin, mMax}(rng);
+        });
+
+    // Already in draw order, with the textures of a layer in order of first
+    // use, as sorted by `drawOn`. The last run of a layer has the texture of
+    // the first run of the next one: both modes merge them.
+    const std::pair<ssvu::SizeT, ssvu::SizeT> runs[]{
+        {0, 0}, {0, 1}, {1, 1}, {1, 2}, {2, 2}, {3, 0}};
+
+    std::vector<BatchSprite> sprites;
+    for(const auto& r : runs)
+        for(auto i(0u); i < 50; ++i)
+        {
+            sprites.emplace_back(textures[r.second]);
+            sprites.back().setZOrder(r.first);
+            sprites.back().setPosition(
+                sf::Vector2f{rnd(0.f, 800.f), rnd(0.f, 600.f)});
+            sprites.back().setOrigin(sf::Vector2f{rnd(0.f, 16.f), 0.f});
+            sprites.back().setScale(
+                sf::Vector2f{rnd(0.1f, 2.f), rnd(0.1f, 2.f)});
+            sprites.back().setRadians(rnd(0.f, ssvu::tau));
+        }
+
+    // Streamed first: the vertex buffer grows while vertices are pending.
+    Manager mgr;
+    DrawRecorder streamed, queued;
+
+    mgr.beginStream(streamed);
+    for(const auto& s : sprites) mgr.stream(s);
+    mgr.endStream();
+
+    for(const auto& s : sprites) mgr.enqueue(s);
+    mgr.drawOn(queued);
+
+    SSVUT_EXPECT(streamed.textures.size() == 4);
+    SSVUT_EXPECT(streamed.textures == queued.textures);
+    SSVUT_EXPECT(streamed.vertices.size() == queued.vertices.size());
+
+    // `drawOn` does not write the colors.
+    auto drawCount(std::min(streamed.vertices.size(), queued.vertices.size()));
+    for(auto i(0u); i < drawCount; ++i)
+    {
+        const auto& vsS(streamed.vertices[i]);
+        const auto& vsQ(queued.vertices[i]);
+        SSVUT_EXPECT(vsS.size() == vsQ.size());
+
+        for(auto j(0u); j < std::min(vsS.size(), vsQ.size()); ++j)
+        {
+            SSVUT_EXPECT(isNearPosition(vsS[j].position, vsQ[j].position));
+            SSVUT_EXPECT(vsS[j].texCoords == vsQ[j].texCoords);
+        }
+    }
+}
+
+namespace Bench
+{
+    template <typename TF>
+    inline auto getMs(const TF& mF)
+    {
+        auto start(std::chrono::high_resolution_clock::now());
+        mF();
+        auto end(std::chrono::high_resolution_clock::now());
+
+        return std::chrono::duration<float, std::milli>(end - start).count();
+    }
+
+    // Draw order of `mCount` sprites on 4 layers and 4 textures: comparison
+    // sort of the `DrawData`, radix sort of the keys, and a frame whose keys
+    // are the same as the previous one's. The keys are built as by
+    // `Manager::enqueue`, with the texture ids, either in random order or
+    // in runs sharing a texture; their cost is also reported alone.
+    inline void sortKeys(ssvu::SizeT mCount)
+    {
+        constexpr ssvu::SizeT frameCount{10};
+
+        std::array<sf::Texture, 4> textures;
+        std::minstd_rand rng{1234u};
+
+        std::vector<Batch::Impl::DrawData> zvs(mCount), zvsRuns(mCount);
+        for(auto i(0u); i < mCount; ++i)
+        {
+            zvs[i].texture = &textures[rng() % textures.size()];
+            zvs[i].zOrder = rng() % 4;
+
+            zvsRuns[i].texture = &textures[i * 16 / mCount % 4];
+            zvsRuns[i].zOrder = zvs[i].zOrder;
+        }
+
+        auto pushKeys([](auto& mSorter, auto& mIds, const auto& mZvs)
+            {
+                for(const auto& d : mZvs)
+                    mSorter.push(Batch::Impl::makeSortKey(
+                        d.zOrder, mIds.get(d.texture)));
+            });
+
+        float msComparison{0.f}, msRadix{0.f}, msCoherent{0.f};
+        float msKeys{0.f}, msKeysRuns{0.f};
+        for(auto f(0u); f < frameCount; ++f)
+        {
+            auto toSort(zvs);
+            msComparison += getMs([&toSort]
+                {
+                    ssvu::sort(toSort, [](const auto& mA, const auto& mB)
+                        {
+                            if(mA.zOrder < mB.zOrder) return true;
+                            if(mA.zOrder > mB.zOrder) return false;
+
+                            return mA.texture < mB.texture;
+                        });
+                });
+
+            Batch::Impl::KeySorter sorter;
+            Batch::Impl::TextureIds ids;
+            auto frame([&]
+                {
+                    pushKeys(sorter, ids, zvs);
+                    sorter.sort();
+                    sorter.nextFrame();
+                });
+
+            msRadix += getMs(frame);
+            msCoherent += getMs(frame);
+
+            msKeys += getMs([&]
+                {
+                    pushKeys(sorter, ids, zvs);
+                });
+            sorter.nextFrame();
+
+            msKeysRuns += getMs([&]
+                {
+                    pushKeys(sorter, ids, zvsRuns);
+                });
+            sorter.nextFrame();
+        }
+
+        ssvu::lo("sort " + ssvu::toStr(mCount))
+            << "comparison " << msComparison / frameCount << " ms, radix "
+            << msRadix / frameCount << " ms, coherent "
+            << msCoherent / frameCount << " ms, keys "
+            << msKeys / frameCount << " ms, keys in runs "
+            << msKeysRuns / frameCount << " ms\n";
+    }
+
+    // Vertices of `mCount` sprites per second, in millions: through
+    // `Impl::DrawData` and the copy of `Manager::drawOn`, and directly
+    // from a `BatchSpriteSoA` with every kernel the CPU supports.
+    inline void vertices(ssvu::SizeT mCount)
+    {
+        using namespace Batch;
+        using namespace Batch::Impl;
+
+        constexpr ssvu::SizeT frameCount{10};
+
+        sf::Texture texture;
+        std::minstd_rand rng{1234u};
+        auto rnd([&rng](float mMin, float mMax)
+            {
+                return std::uniform_real_distribution<float>{mMin, mMax}(rng);
+            });
+
+        std::vector<BatchSprite> sprites;
+        BatchSpriteSoA soa{texture};
+        for(auto i(0u); i < mCount; ++i)
+        {
+            sf::Vector2f position{rnd(0.f, 800.f), rnd(0.f, 600.f)};
+            sf::Vector2f origin{rnd(0.f, 16.f), rnd(0.f, 4.f)};
+            sf::Vector2f scale{rnd(0.1f, 2.f), rnd(0.1f, 2.f)};
+            auto radians(rnd(0.f, ssvu::tau));
+
+            sprites.emplace_back(texture);
+            sprites.back().setPosition(position);
+            sprites.back().setOrigin(origin);
+            sprites.back().setScale(scale);
+            sprites.back().setRadians(radians);
+            soa.emplace(position, origin, scale, radians);
+        }
+
+        std::vector<DrawData> zvs;
+        zvs.reserve(mCount);
+        std::vector<sf::Vertex> vs(mCount * 4);
+
+        auto report([mCount](const char* mTitle, float mMs)
+            {
+                ssvu::lo(mTitle) << mCount * frameCount / (mMs * 1000.f)
+                                 << " M sprites/s\n";
+            });
+
+        report("DrawData", getMs([&]
+                               {
+                                   for(auto f(0u); f < frameCount; ++f)
+                                   {
+                                       zvs.clear();
+                                       for(const auto& s : sprites)
+                                           s.emplaceVertices(zvs);
+
+                                       auto cv(vs.data());
+                                       for(const auto& d : zvs)
+                                           for(auto i(0u); i < 4; ++i, ++cv)
+                                           {
+                                               cv->position = d.points[i];
+                                               cv->texCoords = d.tp[i];
+                                           }
+                                   }
+                               }));
+
+        std::pair<VertexKernel, const char*> kernels[]{
+            {VertexKernel::Scalar, "SoA scalar"},
+            {VertexKernel::SSE, "SoA SSE"}, {VertexKernel::AVX2, "SoA AVX2"}};
+
+        for(const auto& k : kernels)
+        {
+            if(k.first > getBestVertexKernel()) continue;
+
+            report(k.second, getMs([&]
+                                 {
+                                     for(auto f(0u); f < frameCount; ++f)
+                                         emplaceVertices(
+                                             soa, vs.data(), k.first);
+                                 }));
+        }
+    }
+
+    // Counts the draw calls and vertices issued by `Batch::Manager`.
+    struct DrawCounter
+    {
+        ssvu::SizeT drawCount{0u}, vertexCount{0u};
+
+        inline void draw(const sf::Vertex*, std::size_t mCount,
+            sf::PrimitiveType, const sf::RenderStates&) noexcept
+        {
+            ++drawCount;
+            vertexCount += mCount;
+        }
+    };
+
+    // Sprites per second, in millions, and bytes moved per sprite of a frame
+    // of `mCount` sprites already in draw order on 4 layers and 4 textures:
+    // queued by `Manager::enqueue` and drawn by `Manager::drawOn`, and
+    // streamed by `Manager::stream`. The bytes are the ones staged by the
+    // manager until `drawOn`, and the vertices it draws. The draws only
+    // count the calls.
+    inline void streaming(ssvu::SizeT mCount)
+    {
+        using namespace Batch;
+
+        constexpr ssvu::SizeT frameCount{10};
+
+        std::array<sf::Texture, 4> textures;
+        std::minstd_rand rng{1234u};
+        auto rnd([&rng](float mMin, float mMax)
+            {
+                return std::uniform_real_distribution<float>{mMin, mMax}(rng);
+            });
+
+        std::vector<BatchSprite> sprites;
+        for(auto i(0u); i < mCount; ++i)
+        {
+            auto run(i * 16 / mCount);
+
+            sprites.emplace_back(textures[run % 4]);
+            sprites.back().setZOrder(run / 4);
+            sprites.back().setPosition(
+                sf::Vector2f{rnd(0.f, 800.f), rnd(0.f, 600.f)});
+            sprites.back().setOrigin(sf::Vector2f{rnd(0.f, 16.f), 0.f});
+            sprites.back().setScale(sf::Vector2f{1.f, 1.f});
+            sprites.back().setRadians(rnd(0.f, ssvu::tau));
+        }
+
+        Manager mgr;
+        DrawCounter queued, streamed;
+        ssvu::SizeT stagedQueued{0u}, stagedStreamed{0u};
+
+        auto msQueued(getMs([&]
+            {
+                for(auto f(0u); f < frameCount; ++f)
+                {
+                    for(const auto& s : sprites) mgr.enqueue(s);
+
+                    stagedQueued += mgr.getStagedBytes();
+                    mgr.drawOn(queued);
+                }
+            }));
+
+        auto msStreamed(getMs([&]
+            {
+                for(auto f(0u); f < frameCount; ++f)
+                {
+                    mgr.beginStream(streamed);
+                    for(const auto& s : sprites) mgr.stream(s);
+
+                    stagedStreamed += mgr.getStagedBytes();
+                    mgr.endStream();
+                }
+            }));
+
+        auto report([mCount](const char* mTitle, const DrawCounter& mX,
+            ssvu::SizeT mStaged, float mMs)
+            {
+                auto sprites(mCount * frameCount);
+                auto vertexBytes(mX.vertexCount * sizeof(sf::Vertex));
+
+                ssvu::lo(mTitle) << sprites / (mMs * 1000.f)
+                                 << " M sprites/s, " << mStaged / sprites
+                                 << " B/sprite staged, "
+                                 << vertexBytes / sprites
+                                 << " B/sprite drawn, "
+                                 << mX.drawCount / frameCount
+                                 << " draw calls\n";
+            });
+
+        report("queued", queued, stagedQueued, msQueued);
+        report("streamed", streamed, stagedStreamed, msStreamed);
+    }
+
+    inline void run()
+    {
+        for(auto n : {10000u, 100000u, 1000000u}) sortKeys(n);
+        vertices(200000u);
+        streaming(200000u);
+    }
+}
+
 struct MovingThing
 {
     Batch::BatchSprite spr;
@@ -445,10 +1487,17 @@ struct MovingThing
     inline void draw(Batch::Manager& mMgr) { mMgr.enqueue(spr); }
 };
 
-int main()
+int main(int argc, char** argv)
 {
     SSVUT_RUN();
 
+    // Headless benchmarks.
+    if(argc > 1 && std::string{argv[1]} == "--bench")
+    {
+        Bench::run();
+        return 0;
+    }
+
     ssvs::AssetManager<> am;
     am.load<sf::Texture>("l0", "./laser0.png");
     am.load<sf::Texture>("l1", "./laser1.png");
@@ -507,7 +1556,9 @@ int main()
         // for(auto& l : lasers) bm.directDraw(app.getGWindow(), l.spr);
 
         for(auto& l : lasers) l.draw(bm);
-        bm.drawOn(app.getGWindow());
+
+        sf::RenderTarget& rt(app.getGWindow());
+        bm.drawOn(rt);
     };
 
     app.run();
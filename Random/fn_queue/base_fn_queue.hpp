@@ -0,0 +1,105 @@
+#pragma once
+
+#include "./dependencies.hpp"
+#include "./aliases.hpp"
+#include "./vtable.hpp"
+#include "./fixed_storage.hpp"
+#include "./dynamic_storage.hpp"
+
+namespace impl
+{
+    /// @brief Function queue whose memory layout is delegated to
+    /// `TStoragePolicy`.
+    /// @details Storage policies are defined in `impl::storage`.
+    template <typename TStoragePolicy,
+        typename TSignature = typename TStoragePolicy::signature>
+    class base_function_queue;
+
+    template <typename TStoragePolicy, typename TReturn, typename... TArgs>
+    class base_function_queue<TStoragePolicy, TReturn(TArgs...)>
+    {
+    private:
+        using storage_type = TStoragePolicy;
+        using signature = TReturn(TArgs...);
+
+        storage_type _storage;
+
+    public:
+        base_function_queue() = default;
+
+        /// @brief Constructs the queue, passing `allocator` to the storage
+        /// policy.
+        template <typename TAllocator>
+        base_function_queue(std::allocator_arg_t, const TAllocator& allocator)
+            : _storage(allocator)
+        {
+        }
+
+        base_function_queue(const base_function_queue&) = default;
+        base_function_queue& operator=(const base_function_queue&) = default;
+
+        base_function_queue(base_function_queue&&) = default;
+        base_function_queue& operator=(base_function_queue&&) = default;
+
+        template <typename TF>
+        void emplace(TF&& f)
+        // TODO: noexcept
+        {
+            _storage.emplace(FWD(f));
+        }
+
+        void call_all(TArgs... xs)
+        // TODO: noexcept
+        {
+            _storage.for_fns([&xs...](auto& vt, auto fn_ptr)
+                {
+                    vtable::exec_fp(vtable::option::call, vt, fn_ptr, xs...);
+                });
+        }
+
+        void clear() noexcept
+        {
+            _storage.clear();
+        }
+
+        auto size() const noexcept
+        {
+            return _storage.size();
+        }
+
+        auto empty() const noexcept
+        {
+            return _storage.empty();
+        }
+
+        /// @brief Returns the number of storage bytes currently in use.
+        auto used_bytes() const noexcept
+        {
+            return _storage.used_bytes();
+        }
+
+        auto& storage() noexcept
+        {
+            return _storage;
+        }
+
+        const auto& storage() const noexcept
+        {
+            return _storage;
+        }
+    };
+}
+
+/// @brief Function queue storing callable objects in an inline buffer of
+/// `TBufferSize` bytes.
+template <typename TSignature, std::size_t TBufferSize>
+using fixed_fn_queue =
+    impl::base_function_queue<impl::storage::fixed_storage<TSignature,
+        complete_vtable_type<TSignature>, TBufferSize>>;
+
+/// @brief Function queue storing callable objects in a geometrically growing
+/// buffer obtained from `TAllocator`.
+template <typename TSignature, typename TAllocator = std::allocator<char>>
+using dynamic_fn_queue =
+    impl::base_function_queue<impl::storage::dynamic_storage<TSignature,
+        complete_vtable_type<TSignature>, TAllocator>>;
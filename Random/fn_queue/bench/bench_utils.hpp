@@ -0,0 +1,80 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "../dependencies.hpp"
+
+/// @brief Prevents the optimizer from discarding writes to `p`.
+inline void escape(void* p)
+{
+    asm volatile("" : : "g"(p) : "memory");
+}
+
+using hr_clock = std::chrono::high_resolution_clock;
+
+/// @brief Runs `f` `times` times and prints the mean duration.
+template <typename TF>
+void bench(const std::string& title, std::size_t times, TF&& f)
+{
+    std::vector<float> mss;
+
+    for(std::size_t i(0); i < times; ++i)
+    {
+        auto start = hr_clock::now();
+        {
+            f();
+        }
+        auto end = hr_clock::now();
+
+        auto dur = end - start;
+        auto cnt =
+            std::chrono::duration_cast<std::chrono::microseconds>(dur).count();
+
+        mss.emplace_back(cnt / 1000.f);
+    }
+
+    float mean = 0.f;
+    for(auto x : mss)
+    {
+        mean += x;
+    }
+    mean /= mss.size();
+
+    std::cout << title << " | " << mean << " ms\n";
+}
+
+/// @brief Adapts `std::vector<std::function<TSignature>>` to the function
+/// queue interface.
+template <typename TSignature>
+class std_function_vector;
+
+template <typename TReturn, typename... TArgs>
+class std_function_vector<TReturn(TArgs...)>
+{
+private:
+    std::vector<std::function<TReturn(TArgs...)>> _v;
+
+public:
+    template <typename TF>
+    void emplace(TF&& f)
+    {
+        _v.emplace_back(FWD(f));
+    }
+
+    void call_all(TArgs... xs)
+    {
+        for(auto& f : _v)
+        {
+            f(xs...);
+        }
+    }
+
+    void clear()
+    {
+        _v.clear();
+    }
+};
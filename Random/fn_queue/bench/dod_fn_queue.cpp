@@ -0,0 +1,70 @@
+#include "../base_fn_queue.hpp"
+#include "../old_fn_queue.hpp"
+#include "../dod_fn_queue.hpp"
+#include "./bench_utils.hpp"
+
+// Emplaces and calls 1M closures of 4 interleaved types.
+
+constexpr std::size_t closure_count = 1000000;
+constexpr std::size_t call_loops = 10;
+
+// Upper bound of the bytes needed by the closures below.
+constexpr std::size_t fixed_buffer_size = closure_count * 40;
+
+template <typename TQueue>
+void fill(TQueue& q, int& state)
+{
+    for(std::size_t i = 0; i < closure_count / 4; ++i)
+    {
+        q.emplace([&state](int x)
+            {
+                state += x;
+            });
+
+        q.emplace([&state, k = (int)i ](int x)
+            {
+                state += x ^ k;
+            });
+
+        q.emplace([&state, k0 = (int)i, k1 = 1 ](int x)
+            {
+                state -= x + k0 * k1;
+            });
+
+        q.emplace([&state, k0 = 0, k1 = 1, k2 = 2 ](int x) mutable
+            {
+                state += x + k0++ + k1 + k2;
+            });
+    }
+}
+
+template <typename TQueue>
+void run(const std::string& title)
+{
+    int state = 0;
+    auto q = std::make_unique<TQueue>();
+
+    bench(title + " (emplace)", 1, [&]
+        {
+            fill(*q, state);
+            escape(q.get());
+        });
+
+    bench(title + " (call_all)", call_loops, [&]
+        {
+            q->call_all(1);
+            escape(&state);
+        });
+}
+
+int main()
+{
+    using sig = void(int);
+
+    run<fixed_function_queue<sig, fixed_buffer_size>>("fixed_function_queue");
+    run<dynamic_fn_queue<sig>>("dynamic_fn_queue");
+    run<dod_function_queue<sig>>("dod_function_queue");
+    run<dod_function_queue<sig, true>>("dod_function_queue (ordered)");
+
+    return 0;
+}
@@ -0,0 +1,89 @@
+#include "../base_fn_queue.hpp"
+#include "../old_fn_queue.hpp"
+#include "./bench_utils.hpp"
+
+// Measures bytes per entry and calls per second for queues holding many
+// copies of the same closure type.
+
+constexpr std::size_t entry_count = 10000;
+constexpr std::size_t call_loops = 1000;
+
+// Upper bound of the bytes needed by the closures below.
+constexpr std::size_t fixed_buffer_size = entry_count * 32;
+
+/// @brief Bytes per entry of the previous layout, which stored a whole
+/// vtable before every callable object plus a pointer to it in a separate
+/// `std::vector`.
+template <typename TF>
+constexpr auto per_element_vtable_bytes() noexcept
+{
+    constexpr auto alignment = alignof(std::max_align_t);
+    using vtable_type = complete_vtable_type<void(int)>;
+
+    return multiple_round_up(sizeof(vtable_type), alignment) +
+           multiple_round_up(sizeof(TF), alignment) + sizeof(vtable_type*);
+}
+
+template <typename TQueue, typename TF>
+void fill(TQueue& q, const TF& f)
+{
+    for(std::size_t i = 0; i < entry_count; ++i)
+    {
+        q.emplace(f);
+    }
+}
+
+template <typename TQueue, typename TF>
+void run(const std::string& title, const TF& f)
+{
+    auto q = std::make_unique<TQueue>();
+    fill(*q, f);
+
+    std::cout << title << " | "
+              << (float)q->used_bytes() / entry_count << " bytes/entry\n";
+
+    auto start = hr_clock::now();
+    for(std::size_t i = 0; i < call_loops; ++i)
+    {
+        q->call_all(1);
+        escape(q.get());
+    }
+    auto end = hr_clock::now();
+
+    auto s = std::chrono::duration<double>(end - start).count();
+    std::cout << title << " | " << (entry_count * call_loops) / s / 1e6
+              << " Mcalls/s\n";
+}
+
+template <typename TF>
+void run_all(const std::string& title, const TF& f)
+{
+    std::cout << "\n" << title << " (sizeof: " << sizeof(TF) << ")\n";
+    std::cout << "previous layout | " << per_element_vtable_bytes<TF>()
+              << " bytes/entry\n";
+
+    run<fixed_function_queue<void(int), fixed_buffer_size>>(
+        "fixed_function_queue", f);
+
+    run<fixed_fn_queue<void(int), fixed_buffer_size>>("fixed_fn_queue", f);
+    run<dynamic_fn_queue<void(int)>>("dynamic_fn_queue", f);
+}
+
+int main()
+{
+    int state = 0;
+    escape(&state);
+
+    run_all("ref capture", [&state](int x)
+        {
+            state += x;
+        });
+
+    run_all("ref + 2 ints capture", [&state, a = 1, b = 2 ](int x)
+        {
+            state += x + a + b;
+        });
+
+    escape(&state);
+    return 0;
+}
@@ -0,0 +1,83 @@
+#include <boost/hana.hpp>
+#include "../inplace_function.hpp"
+#include "./bench_utils.hpp"
+
+// Measures the call latency of the recursive factorial from
+// `recursive_lambda_asm`, and the construction cost of the wrappers.
+
+constexpr std::size_t loops = 1000000;
+constexpr int depth = 12;
+
+template <typename TF>
+void run_calls(const std::string& title, TF& f)
+{
+    bench(title, 10, [&f]
+        {
+            int res = 0;
+
+            for(std::size_t i = 0; i < loops; ++i)
+            {
+                // Defeats constant folding of the argument.
+                int x = depth;
+                escape(&x);
+
+                res += f(x);
+            }
+
+            escape(&res);
+        });
+}
+
+template <typename TWrapper>
+void run_construction(const std::string& title)
+{
+    bench(title, 10, []
+        {
+            int state = 0;
+
+            for(std::size_t i = 0; i < loops; ++i)
+            {
+                // Too large for the small buffer of `std::function`.
+                TWrapper f = [&state, k0 = i, k1 = i, k2 = i](int x)
+                {
+                    state += x + k0 + k1 + k2;
+                    return state;
+                };
+
+                escape(&f);
+            }
+
+            escape(&state);
+        });
+}
+
+int main()
+{
+    auto yc = boost::hana::fix([](auto self, int x) -> int
+        {
+            return x == 0 ? 1 : x * self(x - 1);
+        });
+
+    std::function<int(int)> stdfn = [&stdfn](int x)
+    {
+        return x == 0 ? 1 : x * stdfn(x - 1);
+    };
+
+    inplace_function<int(int), 16> inplace = [&inplace](int x)
+    {
+        return x == 0 ? 1 : x * inplace(x - 1);
+    };
+
+    std::cout << "calls\n";
+    run_calls("Y-combinator         ", yc);
+    run_calls("std::function        ", stdfn);
+    run_calls("inplace_function     ", inplace);
+
+    std::cout << "\nconstruction\n";
+    run_construction<std::function<int(int)>>("std::function        ");
+    run_construction<inplace_function<int(int), 32>>("inplace_function     ");
+    run_construction<copyable_inplace_function<int(int), 32>>(
+        "copyable_inplace_fn  ");
+
+    return 0;
+}
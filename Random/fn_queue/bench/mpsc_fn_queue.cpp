@@ -0,0 +1,95 @@
+#include "../mpsc_fn_queue.hpp"
+#include "./bench_utils.hpp"
+
+// Producers emplace closures while the consumer drains continuously.
+// Reports the mean enqueue latency (including waits on a full segment) and
+// the consumer throughput, for 1 to 32 producers.
+
+constexpr std::size_t total_pushes = 1 << 21;
+constexpr std::size_t segment_size = 1 << 20;
+
+using queue_type = mpsc_function_queue<void(), segment_size>;
+
+void run(std::size_t producer_count)
+{
+    auto q = std::make_unique<queue_type>();
+    auto pushes = total_pushes / producer_count;
+
+    std::atomic<std::size_t> ready{0};
+    std::atomic<std::size_t> done{0};
+    std::atomic<long long> enqueue_ns{0};
+    long long acc = 0;
+
+    std::vector<std::thread> producers;
+    for(std::size_t p = 0; p < producer_count; ++p)
+    {
+        producers.emplace_back([&, p]
+            {
+                ++ready;
+                while(ready.load() != producer_count)
+                {
+                    std::this_thread::yield();
+                }
+
+                auto start = hr_clock::now();
+                for(std::size_t i = 0; i < pushes; ++i)
+                {
+                    q->emplace([&acc, x = p + i]
+                        {
+                            acc += x;
+                        });
+                }
+                auto end = hr_clock::now();
+
+                enqueue_ns += std::chrono::duration_cast<
+                    std::chrono::nanoseconds>(end - start)
+                                  .count();
+                ++done;
+            });
+    }
+
+    std::size_t calls = 0;
+    std::chrono::nanoseconds drain_time{0};
+
+    auto drain = [&]
+    {
+        auto start = hr_clock::now();
+        auto n = q->drain();
+        auto end = hr_clock::now();
+
+        if(n != 0) drain_time += end - start;
+        calls += n;
+    };
+
+    while(done.load() != producer_count)
+    {
+        drain();
+    }
+    drain();
+
+    for(auto& t : producers)
+    {
+        t.join();
+    }
+
+    escape(&acc);
+
+    auto latency = (double)enqueue_ns.load() / (pushes * producer_count);
+    auto throughput = calls / std::chrono::duration<double>(drain_time).count();
+
+    std::cout << producer_count << " producers | " << latency
+              << " ns/enqueue | " << throughput / 1e6 << " Mcalls/s drained\n";
+}
+
+int main()
+{
+    std::cout << "hardware threads: " << std::thread::hardware_concurrency()
+              << "\n";
+
+    for(std::size_t p : {1, 2, 4, 8, 16, 32})
+    {
+        run(p);
+    }
+
+    return 0;
+}
@@ -0,0 +1,91 @@
+#include "../base_fn_queue.hpp"
+#include "../old_fn_queue.hpp"
+#include "./bench_utils.hpp"
+
+// Compares the storage policies against the monolithic queue and
+// `std::vector<std::function>`, emplacing and calling closures of various
+// sizes.
+
+constexpr std::size_t loops_clear = 100;
+constexpr std::size_t loops_emplace = 100;
+constexpr std::size_t loops_call = 100;
+
+// 4 closures per emplacement loop, at most 64 bytes per entry.
+constexpr std::size_t fixed_buffer_size = loops_emplace * 4 * 64;
+
+template <typename TQueue>
+void run()
+{
+    int state = 0;
+    TQueue q;
+
+    for(std::size_t i0 = 0; i0 < loops_clear; ++i0)
+    {
+        q.clear();
+
+        for(std::size_t i1 = 0; i1 < loops_emplace; ++i1)
+        {
+            q.emplace([](int)
+                {
+                });
+
+            q.emplace([&state](int x)
+                {
+                    state += x;
+                });
+
+            q.emplace([&state, k = 0 ](int x)
+                {
+                    state += x + k;
+                });
+
+            q.emplace([&state, k0 = 0, k1 = 1, k2 = 2 ](int x) mutable
+                {
+                    state += x + k0++ + k1 + k2;
+                });
+
+            escape(&state);
+        }
+
+        escape(&q);
+
+        for(std::size_t i2 = 0; i2 < loops_call; ++i2)
+        {
+            q.call_all(0);
+            q.call_all(1);
+            q.call_all(2);
+        }
+
+        escape(&q);
+    }
+
+    escape(&state);
+}
+
+int main()
+{
+    using sig = void(int);
+    constexpr std::size_t times = 70;
+
+    bench("std::vector<std::function>", times, []
+        {
+            run<std_function_vector<sig>>();
+        });
+
+    bench("fixed_function_queue (old)", times, []
+        {
+            run<fixed_function_queue<sig, fixed_buffer_size>>();
+        });
+
+    bench("fixed_fn_queue", times, []
+        {
+            run<fixed_fn_queue<sig, fixed_buffer_size>>();
+        });
+
+    bench("dynamic_fn_queue", times, []
+        {
+            run<dynamic_fn_queue<sig>>();
+        });
+
+    return 0;
+}
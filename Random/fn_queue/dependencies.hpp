@@ -11,3 +11,7 @@
 #include <vrm/core/static_if.hpp>
 #include <boost/hana.hpp>
 #include <cstring>
+#include <memory>
+#include <algorithm>
+#include <atomic>
+#include <thread>
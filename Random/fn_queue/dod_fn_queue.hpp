@@ -0,0 +1,309 @@
+#pragma once
+
+#include "./dependencies.hpp"
+#include "./aliases.hpp"
+
+namespace impl
+{
+    namespace dod
+    {
+        /// @brief Type-erased operations on a bucket, which is a
+        /// `std::vector<TF>` of callable objects of the same type.
+        /// @details One static instance exists per callable object type: its
+        /// address also identifies the type.
+        template <typename TReturn, typename... TArgs>
+        struct bucket_vtable
+        {
+            fn_ptr<void(void*)> dtor;
+            fn_ptr<void*(const void*)> copy;
+            fn_ptr<void(void*)> clear;
+            fn_ptr<void(void*, TArgs...)> call_all;
+            fn_ptr<void(void*, std::size_t, TArgs...)> call_at;
+        };
+
+        template <typename TF>
+        auto& as_bucket(void* data) noexcept
+        {
+            return *reinterpret_cast<std::vector<TF>*>(data);
+        }
+
+        template <typename TF>
+        auto make_copy_fp(std::true_type) noexcept
+        {
+            return [](const void* data) -> void*
+            {
+                return new std::vector<TF>(
+                    *reinterpret_cast<const std::vector<TF>*>(data));
+            };
+        }
+
+        template <typename TF>
+        auto make_copy_fp(std::false_type) noexcept
+        {
+            return fn_ptr<void*(const void*)>{nullptr};
+        }
+
+        template <typename TF, typename TReturn, typename... TArgs>
+        const auto& bucket_vtable_instance() noexcept
+        {
+            static const bucket_vtable<TReturn, TArgs...> result{
+                // dtor
+                [](void* data)
+                {
+                    delete &as_bucket<TF>(data);
+                },
+                // copy
+                make_copy_fp<TF>(std::is_copy_constructible<TF>{}),
+                // clear
+                [](void* data)
+                {
+                    as_bucket<TF>(data).clear();
+                },
+                // call_all: the callable object type is known here, so that
+                // the calls can be inlined.
+                [](void* data, TArgs... xs)
+                {
+                    for(auto& f : as_bucket<TF>(data))
+                    {
+                        f(xs...);
+                    }
+                },
+                // call_at
+                [](void* data, std::size_t i, TArgs... xs)
+                {
+                    as_bucket<TF>(data)[i](xs...);
+                }};
+
+            return result;
+        }
+    }
+}
+
+/// @brief Function queue that stores callable objects in contiguous
+/// per-type buckets.
+/// @details `call_all` performs one indirect call per bucket, then calls all
+/// the callable objects of that bucket in a tight loop. Calls happen grouped
+/// by type unless `TPreserveOrder` is set, in which case emplacement order is
+/// respected at the cost of one indirect call per callable object.
+template <typename TSignature, bool TPreserveOrder = false>
+class dod_function_queue;
+
+template <typename TReturn, typename... TArgs, bool TPreserveOrder>
+class dod_function_queue<TReturn(TArgs...), TPreserveOrder>
+{
+private:
+    using vtable_type = impl::dod::bucket_vtable<TReturn, TArgs...>;
+    using bucket_idx_type = std::size_t;
+
+    struct bucket
+    {
+        const vtable_type* _vt;
+        void* _data;
+    };
+
+    /// @brief Owns the data of a bucket until it is added to `_buckets`.
+    using bucket_data_ptr = std::unique_ptr<void, fn_ptr<void(void*)>>;
+
+    std::vector<bucket> _buckets;
+
+    /// @brief Bucket indices in emplacement order. Only used if
+    /// `TPreserveOrder` is set.
+    std::vector<bucket_idx_type> _order;
+
+    /// @brief Next callable object index for every bucket, used while
+    /// calling in emplacement order.
+    std::vector<std::size_t> _cursors;
+
+    /// @brief Index of the last used bucket, checked first on emplacement.
+    bucket_idx_type _last_bucket{0};
+
+    std::size_t _size{0};
+
+    template <typename TF>
+    auto bucket_idx_for()
+    {
+        auto vt_ptr = &impl::dod::bucket_vtable_instance<TF, TReturn,
+            TArgs...>();
+
+        // Callable objects of the same type are often emplaced in sequence.
+        if(VRM_CORE_LIKELY(_last_bucket < _buckets.size() &&
+                           _buckets[_last_bucket]._vt == vt_ptr))
+        {
+            return _last_bucket;
+        }
+
+        for(bucket_idx_type i = 0; i < _buckets.size(); ++i)
+        {
+            if(_buckets[i]._vt == vt_ptr)
+            {
+                _last_bucket = i;
+                return i;
+            }
+        }
+
+        bucket_data_ptr data{new std::vector<TF>, vt_ptr->dtor};
+        _buckets.emplace_back(bucket{vt_ptr, data.get()});
+        data.release();
+
+        _last_bucket = _buckets.size() - 1;
+        return _last_bucket;
+    }
+
+    void destroy_all() noexcept
+    {
+        for(auto& b : _buckets)
+        {
+            (*b._vt->dtor)(b._data);
+        }
+    }
+
+    void call_all_ordered(TArgs... xs)
+    {
+        _cursors.assign(_buckets.size(), 0);
+
+        for(auto i : _order)
+        {
+            auto& b = _buckets[i];
+            (*b._vt->call_at)(b._data, _cursors[i]++, xs...);
+        }
+    }
+
+    void call_all_grouped(TArgs... xs)
+    {
+        for(auto& b : _buckets)
+        {
+            (*b._vt->call_all)(b._data, xs...);
+        }
+    }
+
+public:
+    dod_function_queue() = default;
+
+    ~dod_function_queue()
+    {
+        destroy_all();
+    }
+
+    dod_function_queue(const dod_function_queue& rhs)
+        : _order(rhs._order), _size{rhs._size}
+    {
+        _buckets.reserve(rhs._buckets.size());
+
+        // The destructor does not run if the constructor throws: the
+        // buckets already copied are destroyed here.
+        try
+        {
+            for(const auto& b : rhs._buckets)
+            {
+                VRM_CORE_ASSERT(b._vt->copy != nullptr);
+
+                bucket_data_ptr data{(*b._vt->copy)(b._data), b._vt->dtor};
+                _buckets.emplace_back(bucket{b._vt, data.get()});
+                data.release();
+            }
+        }
+        catch(...)
+        {
+            destroy_all();
+            throw;
+        }
+    }
+
+    dod_function_queue& operator=(const dod_function_queue& rhs)
+    {
+        if(this != &rhs)
+        {
+            auto temp(rhs);
+            *this = std::move(temp);
+        }
+
+        return *this;
+    }
+
+    dod_function_queue(dod_function_queue&& rhs) noexcept
+        : _buckets(std::move(rhs._buckets)), _order(std::move(rhs._order)),
+          _size{rhs._size}
+    {
+        rhs._buckets.clear();
+        rhs._order.clear();
+        rhs._size = 0;
+    }
+
+    dod_function_queue& operator=(dod_function_queue&& rhs) noexcept
+    {
+        if(this != &rhs)
+        {
+            destroy_all();
+
+            _buckets = std::move(rhs._buckets);
+            _order = std::move(rhs._order);
+            _size = rhs._size;
+            _last_bucket = 0;
+
+            rhs._buckets.clear();
+            rhs._order.clear();
+            rhs._size = 0;
+        }
+
+        return *this;
+    }
+
+    template <typename TF>
+    void emplace(TF&& f)
+    {
+        using fn_type = std::decay_t<TF>;
+
+        auto i = bucket_idx_for<fn_type>();
+        impl::dod::as_bucket<fn_type>(_buckets[i]._data).emplace_back(FWD(f));
+
+        vrmc::static_if(std::integral_constant<bool, TPreserveOrder>{})
+            .then([i](auto& x_order)
+                {
+                    x_order.emplace_back(i);
+                })(_order);
+
+        ++_size;
+    }
+
+    void call_all(TArgs... xs)
+    {
+        vrmc::static_if(std::integral_constant<bool, TPreserveOrder>{})
+            .then([](auto& self, auto&... x_xs)
+                {
+                    self.call_all_ordered(x_xs...);
+                })
+            .else_([](auto& self, auto&... x_xs)
+                {
+                    self.call_all_grouped(x_xs...);
+                })(*this, xs...);
+    }
+
+    /// @brief Destroys all callable objects. Buckets and their capacity are
+    /// kept, so that refilling the queue does not allocate.
+    void clear() noexcept
+    {
+        for(auto& b : _buckets)
+        {
+            (*b._vt->clear)(b._data);
+        }
+
+        _order.clear();
+        _size = 0;
+    }
+
+    auto size() const noexcept
+    {
+        return _size;
+    }
+
+    auto empty() const noexcept
+    {
+        return _size == 0;
+    }
+
+    /// @brief Returns the number of distinct callable object types.
+    auto bucket_count() const noexcept
+    {
+        return _buckets.size();
+    }
+};
@@ -3,29 +3,225 @@
 #include "./dependencies.hpp"
 #include "./aliases.hpp"
 #include "./vtable.hpp"
+#include "./storage_base.hpp"
 
-// TODO:
 namespace impl
 {
     namespace storage
     {
-        template <typename TSignature, typename TVTable, typename TAllocator>
+        /// @brief Storage policy that emplaces callable objects in a buffer
+        /// obtained from `TAllocator`.
+        /// @details The buffer grows geometrically. Stored callable objects
+        /// are relocated through the vtable `move` entry, which is therefore
+        /// required.
+        template <typename TSignature, typename TVTable,
+            typename TAllocator = std::allocator<char>>
         class dynamic_storage
+            : public storage_base<
+                  dynamic_storage<TSignature, TVTable, TAllocator>, TSignature,
+                  TVTable>
         {
         private:
-            using signature = TSignature;
-            using vtable_type = TVTable;
+            using base_type =
+                storage_base<dynamic_storage, TSignature, TVTable>;
+            friend base_type;
 
+            using base_type::alignment;
 
-            static constexpr auto alignment = alignof(std::max_align_t);
+            VRM_CORE_STATIC_ASSERT_NM(decltype(vtable::has_option(
+                TVTable{}, vtable::option::move)){});
 
-            template <typename T>
-            constexpr auto round_up_to_alignment(T x) const noexcept
+            static constexpr std::size_t growth_factor = 2;
+            static constexpr std::size_t min_capacity = 256;
+
+            /// @brief Allocation unit, guarantees the buffer alignment.
+            using chunk_type = std::aligned_storage_t<alignment, alignment>;
+
+            using allocator_type = typename std::allocator_traits<
+                TAllocator>::template rebind_alloc<chunk_type>;
+
+            using alloc_traits = std::allocator_traits<allocator_type>;
+
+            allocator_type _allocator;
+            chunk_type* _buffer{nullptr};
+
+            /// @brief Capacity of `_buffer`, in bytes.
+            std::size_t _capacity{0};
+
+            auto buffer_ptr() noexcept
+            {
+                return reinterpret_cast<char*>(_buffer);
+            }
+
+            static constexpr auto chunk_count(std::size_t bytes) noexcept
+            {
+                return multiple_round_up(bytes, alignment) / alignment;
+            }
+
+            auto allocate_chunks(std::size_t bytes)
+            {
+                return alloc_traits::allocate(_allocator, chunk_count(bytes));
+            }
+
+            void deallocate_buffer() noexcept
+            {
+                if(_buffer == nullptr) return;
+
+                alloc_traits::deallocate(
+                    _allocator, _buffer, chunk_count(_capacity));
+
+                _buffer = nullptr;
+                _capacity = 0;
+            }
+
+            /// @brief Moves all callable objects to a new buffer of
+            /// `new_capacity` bytes, destroying the moved-from ones.
+            /// @details If a move throws, the new buffer is released and the
+            /// callable objects stay in the current one.
+            void relocate(std::size_t new_capacity)
+            {
+                auto new_buffer = allocate_chunks(new_capacity);
+
+                if(_buffer != nullptr)
+                {
+                    auto src = buffer_ptr();
+                    auto dst = reinterpret_cast<char*>(new_buffer);
+
+                    try
+                    {
+                        entry_layout::transfer<TVTable>(
+                            vtable::option::move, src, dst, this->_next);
+                    }
+                    catch(...)
+                    {
+                        alloc_traits::deallocate(_allocator, new_buffer,
+                            chunk_count(new_capacity));
+
+                        throw;
+                    }
+
+                    this->destroy_all();
+                    deallocate_buffer();
+                }
+
+                _buffer = new_buffer;
+                _capacity = chunk_count(new_capacity) * alignment;
+            }
+
+            void ensure_capacity(std::size_t n)
+            {
+                if(VRM_CORE_LIKELY(n <= _capacity)) return;
+
+                relocate(std::max({n, _capacity * growth_factor, min_capacity}));
+            }
+
+            /// @brief Takes ownership of the buffer of `rhs`, without touching
+            /// the stored callable objects. `*this` must be empty.
+            void steal_buffer(dynamic_storage& rhs) noexcept
             {
-                return multiple_round_up(x, alignment);
+                _buffer = rhs._buffer;
+                _capacity = rhs._capacity;
+                this->_next = rhs._next;
+                this->_size = rhs._size;
+
+                rhs._buffer = nullptr;
+                rhs._capacity = 0;
+                rhs._next = 0;
+                rhs._size = 0;
             }
 
         public:
+            dynamic_storage() = default;
+
+            explicit dynamic_storage(const TAllocator& allocator)
+                : _allocator(allocator)
+            {
+            }
+
+            ~dynamic_storage()
+            {
+                this->destroy_all();
+                deallocate_buffer();
+            }
+
+            dynamic_storage(const dynamic_storage& rhs)
+                : _allocator(alloc_traits::select_on_container_copy_construction(
+                      rhs._allocator))
+            {
+                ensure_capacity(rhs._next);
+
+                // The destructor does not run if the constructor throws.
+                try
+                {
+                    this->copy_all_from(rhs);
+                }
+                catch(...)
+                {
+                    deallocate_buffer();
+                    throw;
+                }
+            }
+
+            dynamic_storage& operator=(const dynamic_storage& rhs)
+            {
+                if(this != &rhs)
+                {
+                    this->clear();
+                    ensure_capacity(rhs._next);
+                    this->copy_all_from(rhs);
+                }
+
+                return *this;
+            }
+
+            dynamic_storage(dynamic_storage&& rhs) noexcept
+                : _allocator(std::move(rhs._allocator))
+            {
+                steal_buffer(rhs);
+            }
+
+            dynamic_storage& operator=(dynamic_storage&& rhs)
+            {
+                if(this == &rhs) return *this;
+
+                this->clear();
+
+                if(alloc_traits::propagate_on_container_move_assignment::value ||
+                    _allocator == rhs._allocator)
+                {
+                    deallocate_buffer();
+
+                    vrmc::static_if(
+                        typename alloc_traits::
+                            propagate_on_container_move_assignment{})
+                        .then([](auto& x_lhs, auto& x_rhs)
+                            {
+                                x_lhs = std::move(x_rhs);
+                            })(_allocator, rhs._allocator);
+
+                    steal_buffer(rhs);
+                }
+                else
+                {
+                    // Allocators differ: the buffer cannot be adopted.
+                    ensure_capacity(rhs._next);
+                    this->move_all_from(rhs);
+                }
+
+                return *this;
+            }
+
+            /// @brief Ensures that at least `n` bytes can be used without
+            /// relocating.
+            void reserve(std::size_t n)
+            {
+                if(n > _capacity) relocate(n);
+            }
+
+            auto capacity() const noexcept
+            {
+                return _capacity;
+            }
         };
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,262 @@
+#pragma once
+
+#include "./dependencies.hpp"
+#include "./utils.hpp"
+#include "./aliases.hpp"
+#include "./vtable.hpp"
+
+/// @brief Namespace dealing with the layout of function queue entries.
+/// @details An entry is a pointer-sized header followed by the callable
+/// object, aligned to its own alignment. Entries are addressed by offsets
+/// relative to a buffer aligned to `alignof(std::max_align_t)`, and are
+/// contiguous.
+namespace entry_layout
+{
+    template <typename TVTable>
+    using vt_ptr_type = const vtable::instance_type<TVTable>*;
+
+    namespace impl
+    {
+        /// @brief Header for 64-bit pointers: canonical user-space addresses
+        /// fit in the lower 48 bits, the upper 16 bits store the size of the
+        /// whole entry.
+        class packed_header
+        {
+        private:
+            std::uint64_t _bits;
+
+        public:
+            static constexpr std::uint64_t size_shift = 48;
+            static constexpr std::uint64_t ptr_mask =
+                (std::uint64_t(1) << size_shift) - 1;
+            static constexpr std::size_t max_entry_size =
+                ~std::uint64_t(0) >> size_shift;
+
+            packed_header(const void* vt_ptr, std::size_t entry_size) noexcept
+            {
+                auto ptr_bits =
+                    std::uint64_t(reinterpret_cast<std::uintptr_t>(vt_ptr));
+
+                VRM_CORE_ASSERT_OP(ptr_bits & ~ptr_mask, ==, 0);
+                VRM_CORE_ASSERT_OP(entry_size, <=, max_entry_size);
+
+                _bits = ptr_bits | (std::uint64_t(entry_size) << size_shift);
+            }
+
+            auto vt_ptr() const noexcept
+            {
+                return reinterpret_cast<const void*>(
+                    std::uintptr_t(_bits & ptr_mask));
+            }
+
+            auto entry_size() const noexcept
+            {
+                return std::size_t(_bits >> size_shift);
+            }
+        };
+
+        /// @brief Header for pointers narrower than 64 bits (wasm32, x86,
+        /// ARM32): the vtable pointer and the size of the whole entry are
+        /// stored in separate words.
+        class split_header
+        {
+        private:
+            const void* _vt_ptr;
+            std::size_t _entry_size;
+
+        public:
+            static constexpr std::size_t max_entry_size = ~std::size_t(0);
+
+            split_header(const void* vt_ptr, std::size_t entry_size) noexcept
+                : _vt_ptr{vt_ptr}, _entry_size{entry_size}
+            {
+            }
+
+            auto vt_ptr() const noexcept { return _vt_ptr; }
+            auto entry_size() const noexcept { return _entry_size; }
+        };
+    }
+
+    /// @brief The header stores a pointer to the static vtable instance of
+    /// the callable object type and the size of the whole entry.
+    /// @details Storing the size in the header (instead of reading it from
+    /// the vtable) keeps the next entry one load away while iterating. With
+    /// 64-bit pointers both fit in a single word.
+    using header_type = std::conditional_t<sizeof(std::uintptr_t) == 8,
+        impl::packed_header, impl::split_header>;
+
+    VRM_CORE_STATIC_ASSERT_NM(std::is_trivially_copyable<header_type>{});
+    VRM_CORE_STATIC_ASSERT_NM(sizeof(header_type) == 8 ||
+                              sizeof(header_type) == 2 * sizeof(void*));
+
+    constexpr auto buffer_alignment = alignof(std::max_align_t);
+    constexpr auto header_alignment = alignof(header_type);
+    constexpr std::size_t max_entry_size = header_type::max_entry_size;
+
+    template <typename TVTable>
+    auto make_header(vt_ptr_type<TVTable> vt_ptr, std::size_t entry_size)
+    {
+        return header_type{vt_ptr, entry_size};
+    }
+
+    template <typename TVTable>
+    auto header_vt_ptr(const header_type& h) noexcept
+    {
+        return static_cast<vt_ptr_type<TVTable>>(h.vt_ptr());
+    }
+
+    inline auto header_entry_size(const header_type& h) noexcept
+    {
+        return h.entry_size();
+    }
+
+    /// @brief Returns the offset of a callable object with alignment
+    /// `fn_alignment` whose header is stored at `header_offset`.
+    constexpr auto fn_offset(
+        std::size_t header_offset, std::size_t fn_alignment) noexcept
+    {
+        return pow2_round_up(header_offset + sizeof(header_type), fn_alignment);
+    }
+
+    /// @brief Returns the offset past the end of an entry for a callable
+    /// object of type `TF` starting at `offset`.
+    /// @details Always a multiple of `header_alignment`.
+    template <typename TF>
+    constexpr auto end_offset(std::size_t offset) noexcept
+    {
+        return pow2_round_up(
+            fn_offset(offset, alignof(TF)) + sizeof(TF), header_alignment);
+    }
+
+    inline auto& header_at(char* buffer, std::size_t offset) noexcept
+    {
+        return *reinterpret_cast<header_type*>(buffer + offset);
+    }
+
+    /// @brief Returns the size of an entry for a callable object of type
+    /// `TF`, padded so that it does not depend on the entry position as long
+    /// as entries start at multiples of `buffer_alignment`.
+    template <typename TF>
+    constexpr auto padded_entry_size() noexcept
+    {
+        return pow2_round_up(end_offset<TF>(0), buffer_alignment);
+    }
+
+    /// @brief Emplaces `f` in a new entry of `entry_size` bytes starting at
+    /// `offset`. Returns the offset past the end of the entry.
+    /// @details `entry_size` must be at least `end_offset<TF>(offset) -
+    /// offset`, and `buffer` must be large enough.
+    template <typename TSignature, typename TVTable, typename TF>
+    auto emplace(
+        char* buffer, std::size_t offset, std::size_t entry_size, TF&& f)
+    // TODO: noexcept
+    {
+        using fn_type = std::decay_t<TF>;
+        VRM_CORE_STATIC_ASSERT_NM(alignof(fn_type) <= buffer_alignment);
+        VRM_CORE_STATIC_ASSERT_NM(
+            padded_entry_size<fn_type>() <= max_entry_size);
+
+        VRM_CORE_ASSERT_OP(
+            offset + entry_size, >=, end_offset<fn_type>(offset));
+
+        auto& vt = vtable::template instance<fn_type, TSignature, TVTable>();
+        auto x_fn_offset = fn_offset(offset, alignof(fn_type));
+
+        new(buffer + x_fn_offset) fn_type(FWD(f));
+        new(buffer + offset)
+            header_type{make_header<TVTable>(&vt, entry_size)};
+
+        return offset + entry_size;
+    }
+
+    /// @brief Emplaces `f` in a new entry starting at `offset`. Returns the
+    /// offset past the end of the entry.
+    /// @details `buffer` must be large enough, see `end_offset`. `offset`
+    /// must be a previously returned end offset, or zero.
+    template <typename TSignature, typename TVTable, typename TF>
+    auto emplace(char* buffer, std::size_t offset, TF&& f)
+    // TODO: noexcept
+    {
+        using fn_type = std::decay_t<TF>;
+        auto entry_size = end_offset<fn_type>(offset) - offset;
+
+        return emplace<TSignature, TVTable>(buffer, offset, entry_size, FWD(f));
+    }
+
+    /// @brief Calls `f(vt_instance, header_offset, fn_offset)` for every
+    /// entry in `[0, end)`, in emplacement order.
+    template <typename TVTable, typename TF>
+    void for_offsets(char* buffer, std::size_t end, TF&& f)
+    {
+        std::size_t offset = 0;
+
+        while(offset < end)
+        {
+            auto h = header_at(buffer, offset);
+            const auto& vt = *header_vt_ptr<TVTable>(h);
+
+            f(vt, offset, fn_offset(offset, vt.fn_alignment));
+            offset += header_entry_size(h);
+        }
+    }
+
+    /// @brief Calls `f(vtable, fn_ptr)` for every entry in `[0, end)`, in
+    /// emplacement order.
+    template <typename TVTable, typename TF>
+    void for_fns(char* buffer, std::size_t end, TF&& f)
+    {
+        for_offsets<TVTable>(buffer, end,
+            [buffer, &f](const auto& vt, auto, auto x_fn_offset)
+            {
+                f(vt.fps, buffer + x_fn_offset);
+            });
+    }
+
+    /// @brief Destroys every callable object in `[0, end)`, in emplacement
+    /// order.
+    template <typename TVTable>
+    void destroy_all(char* buffer, std::size_t end) noexcept
+    {
+        for_fns<TVTable>(buffer, end, [](const auto& vt, auto fn_ptr)
+            {
+                vtable::exec_fp(vtable::option::dtor, vt, fn_ptr);
+            });
+    }
+
+    /// @brief Copies or moves (depending on `o`) every entry in `[0, end)`
+    /// from `src` to the same offset in `dst`.
+    /// @details `dst` must be large enough and must not contain any live
+    /// callable object in `[0, end)`. If a copy or move throws, the
+    /// callable objects already transferred to `dst` are destroyed before
+    /// rethrowing. The ones in `src` are left alive.
+    template <typename TVTable, typename TOption>
+    void transfer(TOption o, char* src, char* dst, std::size_t end)
+    {
+        VRM_CORE_STATIC_ASSERT_NM(
+            decltype(vtable::has_option(TVTable{}, o)){});
+
+        // Offset past the last entry transferred to `dst`.
+        std::size_t done = 0;
+
+        try
+        {
+            for_offsets<TVTable>(src, end,
+                [o, src, dst, &done](const auto& vt, auto x_header_offset,
+                    auto x_fn_offset)
+                {
+                    const auto& h = header_at(src, x_header_offset);
+
+                    vtable::exec_fp(
+                        o, vt.fps, src + x_fn_offset, dst + x_fn_offset);
+
+                    new(dst + x_header_offset) header_type{h};
+                    done = x_header_offset + header_entry_size(h);
+                });
+        }
+        catch(...)
+        {
+            destroy_all<TVTable>(dst, done);
+            throw;
+        }
+    }
+}
@@ -0,0 +1,286 @@
+#pragma once
+
+#include "./dependencies.hpp"
+#include "./aliases.hpp"
+#include "./vtable.hpp"
+
+namespace impl
+{
+    namespace inplace
+    {
+        /// @brief Empty base that deletes the copy operations of the derived
+        /// class when `TEnabled` is `false`.
+        template <bool TEnabled>
+        struct copy_control
+        {
+        };
+
+        template <>
+        struct copy_control<false>
+        {
+            copy_control() = default;
+
+            copy_control(const copy_control&) = delete;
+            copy_control& operator=(const copy_control&) = delete;
+
+            copy_control(copy_control&&) = default;
+            copy_control& operator=(copy_control&&) = default;
+        };
+
+        /// @brief Empty base that deletes the move operations of the derived
+        /// class when `TEnabled` is `false`.
+        template <bool TEnabled>
+        struct move_control
+        {
+        };
+
+        template <>
+        struct move_control<false>
+        {
+            move_control() = default;
+
+            move_control(const move_control&) = default;
+            move_control& operator=(const move_control&) = default;
+
+            move_control(move_control&&) = delete;
+            move_control& operator=(move_control&&) = delete;
+        };
+
+        /// @brief Inline buffer of `TCapacity` bytes holding at most one
+        /// callable object, plus a pointer to its static vtable instance.
+        /// @details Copy and move operations are only instantiated if used.
+        template <typename TSignature, std::size_t TCapacity,
+            typename TVTable>
+        class storage
+        {
+        private:
+            using vtable_type = TVTable;
+            using vt_ptr_type = const vtable::instance_type<vtable_type>*;
+
+            static constexpr auto alignment = alignof(std::max_align_t);
+
+            vt_ptr_type _vt{nullptr};
+
+            // Calling a `const` wrapper can mutate the callable object, like
+            // `std::function`.
+            mutable std::aligned_storage_t<TCapacity, alignment> _buffer;
+
+            template <typename TOption>
+            void transfer_from(TOption o, storage& rhs)
+            {
+                VRM_CORE_STATIC_ASSERT_NM(
+                    decltype(vtable::has_option(vtable_type{}, o)){});
+
+                if(rhs._vt == nullptr) return;
+
+                vtable::exec_fp(o, rhs._vt->fps, rhs.buffer_ptr(), buffer_ptr());
+                _vt = rhs._vt;
+            }
+
+            void copy_from(const storage& rhs)
+            {
+                // The copy ctor function pointers take mutable pointers, but
+                // never modify the source object.
+                transfer_from(
+                    vtable::option::copy, const_cast<storage&>(rhs));
+            }
+
+            void move_from(storage& rhs)
+            {
+                transfer_from(vtable::option::move, rhs);
+                rhs.reset();
+            }
+
+        public:
+            storage() = default;
+
+            template <typename TF>
+            explicit storage(TF&& f)
+            {
+                using fn_type = std::decay_t<TF>;
+
+                new(buffer_ptr()) fn_type(FWD(f));
+                _vt = &vtable::template instance<fn_type, TSignature,
+                    vtable_type>();
+            }
+
+            ~storage()
+            {
+                reset();
+            }
+
+            storage(const storage& rhs)
+            {
+                copy_from(rhs);
+            }
+
+            storage& operator=(const storage& rhs)
+            {
+                if(this != &rhs)
+                {
+                    reset();
+                    copy_from(rhs);
+                }
+
+                return *this;
+            }
+
+            storage(storage&& rhs)
+            {
+                move_from(rhs);
+            }
+
+            storage& operator=(storage&& rhs)
+            {
+                if(this != &rhs)
+                {
+                    reset();
+                    move_from(rhs);
+                }
+
+                return *this;
+            }
+
+            void reset() noexcept
+            {
+                if(_vt == nullptr) return;
+
+                vtable::exec_fp(vtable::option::dtor, _vt->fps, buffer_ptr());
+                _vt = nullptr;
+            }
+
+            auto buffer_ptr() const noexcept
+            {
+                return reinterpret_cast<char*>(&_buffer);
+            }
+
+            auto vt_ptr() const noexcept
+            {
+                return _vt;
+            }
+        };
+    }
+}
+
+/// @brief Callable object wrapper with signature `TSignature`, that stores
+/// the callable object in an inline buffer of `TCapacity` bytes.
+/// @details Never allocates. Callable objects that do not fit are rejected at
+/// compile-time. The vtable is built from the options of `TVTable`: the
+/// wrapper is copyable only with `vtable::option::copy` and movable only with
+/// `vtable::option::move`, and the missing slots cost nothing.
+template <typename TSignature, std::size_t TCapacity, typename TVTable>
+class basic_inplace_function;
+
+template <typename TReturn, typename... TArgs, std::size_t TCapacity,
+    typename TVTable>
+class basic_inplace_function<TReturn(TArgs...), TCapacity, TVTable>
+    : impl::inplace::copy_control<decltype(
+          vtable::has_option(TVTable{}, vtable::option::copy))::value>,
+      impl::inplace::move_control<decltype(
+          vtable::has_option(TVTable{}, vtable::option::move))::value>
+{
+private:
+    using signature = TReturn(TArgs...);
+    using vtable_type = TVTable;
+    using storage_type = impl::inplace::storage<signature, TCapacity, TVTable>;
+
+    static constexpr auto capacity = TCapacity;
+    static constexpr auto alignment = alignof(std::max_align_t);
+
+    static constexpr bool has_copy = decltype(
+        vtable::has_option(vtable_type{}, vtable::option::copy))::value;
+
+    static constexpr bool has_move = decltype(
+        vtable::has_option(vtable_type{}, vtable::option::move))::value;
+
+    VRM_CORE_STATIC_ASSERT_NM(decltype(
+        vtable::has_option(vtable_type{}, vtable::option::call))::value);
+
+    VRM_CORE_STATIC_ASSERT_NM(decltype(
+        vtable::has_option(vtable_type{}, vtable::option::dtor))::value);
+
+    storage_type _storage;
+
+    template <typename TF>
+    static constexpr void check_callable() noexcept
+    {
+        static_assert(sizeof(TF) <= capacity,
+            "callable object does not fit in the inplace_function buffer");
+
+        static_assert(alignof(TF) <= alignment,
+            "callable object is over-aligned for the inplace_function buffer");
+
+        static_assert(!has_copy || std::is_copy_constructible<TF>{},
+            "copyable inplace_function requires a copyable callable object");
+
+        static_assert(!has_move || std::is_move_constructible<TF>{},
+            "movable inplace_function requires a movable callable object");
+    }
+
+    template <typename TF>
+    using enable_if_callable = std::enable_if_t<
+        !std::is_same<std::decay_t<TF>, basic_inplace_function>{} &&
+        !std::is_same<std::decay_t<TF>, std::nullptr_t>{}>;
+
+public:
+    basic_inplace_function() = default;
+
+    basic_inplace_function(std::nullptr_t) noexcept
+    {
+    }
+
+    template <typename TF, typename = enable_if_callable<TF>>
+    basic_inplace_function(TF&& f) : _storage(FWD(f))
+    {
+        check_callable<std::decay_t<TF>>();
+    }
+
+    basic_inplace_function(const basic_inplace_function&) = default;
+    basic_inplace_function& operator=(
+        const basic_inplace_function&) = default;
+
+    basic_inplace_function(basic_inplace_function&&) = default;
+    basic_inplace_function& operator=(basic_inplace_function&&) = default;
+
+    template <typename TF, typename = enable_if_callable<TF>>
+    basic_inplace_function& operator=(TF&& f)
+    {
+        check_callable<std::decay_t<TF>>();
+
+        _storage.reset();
+        new(&_storage) storage_type(FWD(f));
+
+        return *this;
+    }
+
+    basic_inplace_function& operator=(std::nullptr_t) noexcept
+    {
+        _storage.reset();
+        return *this;
+    }
+
+    TReturn operator()(TArgs... xs) const
+    {
+        VRM_CORE_ASSERT(_storage.vt_ptr() != nullptr);
+
+        return vtable::exec_fp(vtable::option::call, _storage.vt_ptr()->fps,
+            _storage.buffer_ptr(), FWD(xs)...);
+    }
+
+    explicit operator bool() const noexcept
+    {
+        return _storage.vt_ptr() != nullptr;
+    }
+};
+
+/// @brief Move-only `basic_inplace_function`.
+template <typename TSignature, std::size_t TCapacity>
+using inplace_function = basic_inplace_function<TSignature, TCapacity,
+    vtable::type<TSignature, vtable::option::call_t, vtable::option::dtor_t,
+        vtable::option::move_t>>;
+
+/// @brief Copyable and movable `basic_inplace_function`.
+template <typename TSignature, std::size_t TCapacity>
+using copyable_inplace_function =
+    basic_inplace_function<TSignature, TCapacity,
+        complete_vtable_type<TSignature>>;
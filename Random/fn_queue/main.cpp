@@ -5,6 +5,7 @@
 #include "./vtable.hpp"
 #include "./fixed_storage.hpp"
 #include "./dynamic_storage.hpp"
+#include "./base_fn_queue.hpp"
 
 int main()
 {
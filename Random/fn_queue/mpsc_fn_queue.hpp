@@ -0,0 +1,237 @@
+#pragma once
+
+#include "./dependencies.hpp"
+#include "./aliases.hpp"
+#include "./vtable.hpp"
+#include "./entry_layout.hpp"
+
+/// @brief Bounded, lock-free function queue with multiple producers and a
+/// single consumer.
+/// @details Callable objects are emplaced in one of two segments of
+/// `TSegmentSize` bytes. Producers reserve space in the active segment by
+/// atomically bumping its tail. The consumer swaps the active segment, waits
+/// for the producers still writing to the old one, then invokes and destroys
+/// all its callable objects in a single pass.
+template <typename TSignature, std::size_t TSegmentSize>
+class mpsc_function_queue;
+
+template <typename TReturn, typename... TArgs, std::size_t TSegmentSize>
+class mpsc_function_queue<TReturn(TArgs...), TSegmentSize>
+{
+private:
+    using signature = TReturn(TArgs...);
+
+    // Copy and move are never needed: callable objects do not leave their
+    // segment.
+    using vtable_type = vtable::type< // .
+        signature,                    // .
+        vtable::option::call_t,       // .
+        vtable::option::dtor_t        // .
+        >;
+
+    static constexpr auto segment_size = TSegmentSize;
+    static constexpr auto alignment = entry_layout::buffer_alignment;
+
+    // Avoids false sharing between the atomic counters of the two segments.
+    static constexpr std::size_t cache_line_size = 64;
+
+    struct segment
+    {
+        std::aligned_storage_t<segment_size, alignment> _buffer;
+
+        /// @brief Offset past the last reserved byte. Can exceed
+        /// `segment_size` after a failed reservation.
+        alignas(cache_line_size) std::atomic<std::size_t> _tail{0};
+
+        /// @brief Start offset of the reservation that crossed
+        /// `segment_size`, if any.
+        std::atomic<std::size_t> _limit{segment_size};
+
+        /// @brief Number of producers currently writing to the segment.
+        alignas(cache_line_size) std::atomic<std::size_t> _writers{0};
+
+        auto buffer_ptr() noexcept
+        {
+            return reinterpret_cast<char*>(&_buffer);
+        }
+
+        /// @brief Returns the offset past the last emplaced entry. Only
+        /// meaningful when no producer is writing.
+        auto end() const noexcept
+        {
+            return std::min(_tail.load(std::memory_order_relaxed),
+                _limit.load(std::memory_order_relaxed));
+        }
+
+        void reset() noexcept
+        {
+            _tail.store(0, std::memory_order_relaxed);
+            _limit.store(segment_size, std::memory_order_relaxed);
+        }
+    };
+
+    /// @brief Fills the reserved bytes of an entry whose callable object
+    /// threw while being constructed. Never invoked: skipped by `drain`.
+    struct tombstone
+    {
+        [[noreturn]] TReturn operator()(TArgs...) const noexcept
+        {
+            std::terminate();
+        }
+    };
+
+    static const auto& tombstone_fps() noexcept
+    {
+        return vtable::instance<tombstone, signature, vtable_type>().fps;
+    }
+
+    segment _segments[2];
+    alignas(cache_line_size) std::atomic<std::size_t> _active{0};
+
+    /// @brief Registers the calling producer as a writer of the active
+    /// segment, and returns it.
+    auto& acquire_active_segment() noexcept
+    {
+        for(;;)
+        {
+            auto idx = _active.load();
+            auto& s = _segments[idx];
+
+            s._writers.fetch_add(1);
+
+            // The consumer swaps `_active` before checking `_writers`: if it
+            // did not swap yet, it will wait for us.
+            if(VRM_CORE_LIKELY(_active.load() == idx)) return s;
+
+            s._writers.fetch_sub(1, std::memory_order_release);
+        }
+    }
+
+    void wait_for_writers(segment& s) noexcept
+    {
+        // Producers only write a single callable object: spin.
+        while(s._writers.load() != 0)
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    void destroy_all(segment& s) noexcept
+    {
+        entry_layout::destroy_all<vtable_type>(s.buffer_ptr(), s.end());
+    }
+
+public:
+    mpsc_function_queue() = default;
+
+    ~mpsc_function_queue()
+    {
+        destroy_all(_segments[0]);
+        destroy_all(_segments[1]);
+    }
+
+    mpsc_function_queue(const mpsc_function_queue&) = delete;
+    mpsc_function_queue& operator=(const mpsc_function_queue&) = delete;
+
+    mpsc_function_queue(mpsc_function_queue&&) = delete;
+    mpsc_function_queue& operator=(mpsc_function_queue&&) = delete;
+
+    /// @brief Emplaces `f`, unless the active segment is full. Can be called
+    /// concurrently from any thread.
+    /// @details If constructing the callable object throws, the exception
+    /// is propagated and the queue is left unchanged, except for the space
+    /// the entry occupies until the next `drain`.
+    /// @return `true` if `f` was emplaced.
+    template <typename TF>
+    bool try_emplace(TF&& f)
+    // TODO: noexcept
+    {
+        using fn_type = std::decay_t<TF>;
+
+        // Entries start at multiples of `alignment`: their size can be
+        // computed before reserving.
+        constexpr auto entry_size =
+            entry_layout::padded_entry_size<fn_type>();
+
+        VRM_CORE_STATIC_ASSERT_NM(entry_size <= segment_size);
+
+        auto& s = acquire_active_segment();
+
+        auto start = s._tail.fetch_add(entry_size, std::memory_order_relaxed);
+        auto end = start + entry_size;
+
+        if(VRM_CORE_UNLIKELY(end > segment_size))
+        {
+            // Only one reservation can cross the end of the segment: it
+            // marks where the emplaced entries stop.
+            if(start < segment_size)
+            {
+                s._limit.store(start, std::memory_order_relaxed);
+            }
+
+            s._writers.fetch_sub(1, std::memory_order_release);
+            return false;
+        }
+
+        try
+        {
+            entry_layout::emplace<signature, vtable_type>(
+                s.buffer_ptr(), start, entry_size, FWD(f));
+        }
+        catch(...)
+        {
+            // The bytes are already reserved: they must hold a valid entry
+            // for `drain`, and the consumer must not wait for us forever.
+            entry_layout::emplace<signature, vtable_type>(
+                s.buffer_ptr(), start, entry_size, tombstone{});
+
+            s._writers.fetch_sub(1, std::memory_order_release);
+            throw;
+        }
+
+        s._writers.fetch_sub(1, std::memory_order_release);
+        return true;
+    }
+
+    /// @brief Emplaces `f`, yielding until the consumer frees space. Can be
+    /// called concurrently from any thread.
+    template <typename TF>
+    void emplace(TF&& f)
+    // TODO: noexcept
+    {
+        // `f` is only forwarded by the successful attempt.
+        while(!try_emplace(FWD(f)))
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    /// @brief Invokes and destroys all the callable objects emplaced so
+    /// far, in emplacement order per producer. Must only be called from the
+    /// consumer thread.
+    /// @return Number of invoked callable objects.
+    auto drain(TArgs... xs)
+    // TODO: noexcept
+    {
+        auto idx = _active.load(std::memory_order_relaxed);
+        auto& s = _segments[idx];
+
+        // Redirect new producers to the other segment, which is empty.
+        _active.store(1 - idx);
+        wait_for_writers(s);
+
+        std::size_t count = 0;
+        entry_layout::for_fns<vtable_type>(s.buffer_ptr(), s.end(),
+            [&count, &xs...](auto& vt, auto fn_ptr)
+            {
+                if(VRM_CORE_UNLIKELY(&vt == &tombstone_fps())) return;
+
+                vtable::exec_fp(vtable::option::call, vt, fn_ptr, xs...);
+                vtable::exec_fp(vtable::option::dtor, vt, fn_ptr);
+                ++count;
+            });
+
+        s.reset();
+        return count;
+    }
+};
@@ -0,0 +1,125 @@
+#pragma once
+
+#include "./dependencies.hpp"
+#include "./utils.hpp"
+#include "./aliases.hpp"
+#include "./vtable.hpp"
+#include "./entry_layout.hpp"
+
+namespace impl
+{
+    namespace storage
+    {
+        /// @brief CRTP base implementing the buffer management shared by all
+        /// storage policies.
+        /// @details Entries are laid out as described in `entry_layout`.
+        /// As they are addressed by offset, the buffer can be copied or
+        /// relocated. `TDerived` must provide `buffer_ptr()` and
+        /// `ensure_capacity(std::size_t)`.
+        template <typename TDerived, typename TSignature, typename TVTable>
+        class storage_base
+        {
+        public:
+            using signature = TSignature;
+            using vtable_type = TVTable;
+
+        protected:
+            static constexpr auto alignment = entry_layout::buffer_alignment;
+
+            /// @brief Offset of the first unused byte of the buffer.
+            std::size_t _next{0};
+
+            /// @brief Number of stored callable objects.
+            std::size_t _size{0};
+
+            auto& derived() noexcept
+            {
+                return static_cast<TDerived&>(*this);
+            }
+
+            /// @brief Copies all the entries of `rhs` in this storage, which
+            /// is assumed to be empty and large enough.
+            void copy_all_from(const TDerived& rhs)
+            {
+                // The copy ctor function pointers take mutable pointers, but
+                // never modify the source object.
+                auto src = const_cast<TDerived&>(rhs).buffer_ptr();
+
+                entry_layout::transfer<vtable_type>(vtable::option::copy, src,
+                    derived().buffer_ptr(), rhs._next);
+
+                _next = rhs._next;
+                _size = rhs._size;
+            }
+
+            /// @brief Moves all the entries of `rhs` in this storage, which
+            /// is assumed to be empty and large enough. `rhs` is cleared.
+            void move_all_from(TDerived& rhs)
+            {
+                entry_layout::transfer<vtable_type>(vtable::option::move,
+                    rhs.buffer_ptr(), derived().buffer_ptr(), rhs._next);
+
+                _next = rhs._next;
+                _size = rhs._size;
+
+                rhs.clear();
+            }
+
+            void destroy_all() noexcept
+            {
+                entry_layout::destroy_all<vtable_type>(
+                    derived().buffer_ptr(), _next);
+            }
+
+        public:
+            template <typename TF>
+            void emplace(TF&& f)
+            // TODO: noexcept
+            {
+                using fn_type = std::decay_t<TF>;
+
+                // Can relocate the buffer: `buffer_ptr()` must be called
+                // after.
+                derived().ensure_capacity(
+                    entry_layout::end_offset<fn_type>(_next));
+
+                _next = entry_layout::emplace<signature, vtable_type>(
+                    derived().buffer_ptr(), _next, FWD(f));
+
+                ++_size;
+            }
+
+            /// @brief Calls `f(vtable, fn_ptr)` for every stored callable
+            /// object, in emplacement order.
+            template <typename TF>
+            void for_fns(TF&& f)
+            {
+                entry_layout::for_fns<vtable_type>(
+                    derived().buffer_ptr(), _next, FWD(f));
+            }
+
+            void clear() noexcept
+            {
+                destroy_all();
+                _next = 0;
+                _size = 0;
+            }
+
+            auto size() const noexcept
+            {
+                return _size;
+            }
+
+            auto empty() const noexcept
+            {
+                return _size == 0;
+            }
+
+            /// @brief Returns the number of buffer bytes currently in use.
+            auto used_bytes() const noexcept
+            {
+                return _next;
+            }
+        };
+    }
+}
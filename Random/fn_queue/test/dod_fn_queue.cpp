@@ -0,0 +1,191 @@
+#include "./test_utils.hpp"
+#include "../dod_fn_queue.hpp"
+
+static int ctors;
+static int dtors;
+
+struct counter
+{
+    counter()
+    {
+        ++ctors;
+    }
+    ~counter()
+    {
+        ++dtors;
+    }
+
+    counter(const counter&)
+    {
+        ++ctors;
+    }
+    counter(counter&&)
+    {
+        ++ctors;
+    }
+};
+
+template <typename TQueue>
+void basic_tests()
+{
+    int acc = 0;
+    TQueue q;
+
+    for(int i = 0; i < 100; ++i)
+    {
+        q.emplace([&acc](int x)
+            {
+                acc += x;
+            });
+        q.emplace([&acc, i](int)
+            {
+                acc += i;
+            });
+        q.emplace([&acc, v = std::vector<int>{1, 2} ](int x)
+            {
+                acc -= x * v.size();
+            });
+    }
+
+    TEST_ASSERT_OP(q.size(), ==, 300);
+    TEST_ASSERT_OP(q.bucket_count(), ==, 3);
+
+    q.call_all(2);
+    TEST_ASSERT_OP(acc, ==, 100 * (2 - 4) + (99 * 100) / 2);
+
+    q.clear();
+    TEST_ASSERT(q.empty());
+    TEST_ASSERT_OP(q.bucket_count(), ==, 3);
+
+    acc = 0;
+    q.call_all(2);
+    TEST_ASSERT_OP(acc, ==, 0);
+}
+
+void order_tests()
+{
+    std::vector<int> out;
+    dod_function_queue<void(), true> q;
+
+    for(int i = 0; i < 10; ++i)
+    {
+        if(i % 2 == 0)
+        {
+            q.emplace([&out, i]
+                {
+                    out.emplace_back(i);
+                });
+        }
+        else
+        {
+            q.emplace([&out, i, k = 0 ]
+                {
+                    out.emplace_back(i + k);
+                });
+        }
+    }
+
+    q.call_all();
+    q.call_all();
+
+    TEST_ASSERT_OP(out.size(), ==, 20);
+    for(int i = 0; i < 20; ++i)
+    {
+        TEST_ASSERT_OP(out[i], ==, i % 10);
+    }
+}
+
+void copy_move_tests()
+{
+    ctors = dtors = 0;
+
+    {
+        int acc = 0;
+        dod_function_queue<void(int)> q;
+
+        q.emplace([&acc, c = counter{} ](int x)
+            {
+                acc += x;
+            });
+        q.emplace([&acc](int x)
+            {
+                acc -= x;
+            });
+
+        auto q_copy = q;
+        TEST_ASSERT_OP(ctors - dtors, ==, 2);
+
+        auto q_moved = std::move(q_copy);
+        TEST_ASSERT(q_copy.empty());
+        TEST_ASSERT_OP(ctors - dtors, ==, 2);
+
+        q_moved.call_all(3);
+        TEST_ASSERT_OP(acc, ==, 0);
+
+        q = std::move(q_moved);
+        TEST_ASSERT_OP(ctors - dtors, ==, 1);
+    }
+
+    TEST_ASSERT_OP(ctors - dtors, ==, 0);
+}
+
+struct throwing_copy
+{
+    throwing_copy() = default;
+    throwing_copy(throwing_copy&&) = default;
+    throwing_copy(const throwing_copy&)
+    {
+        throw 0;
+    }
+};
+
+void throwing_copy_tests()
+{
+    ctors = dtors = 0;
+
+    {
+        int acc = 0;
+        dod_function_queue<void(int)> q;
+
+        q.emplace([&acc, c = counter{} ](int x)
+            {
+                acc += x;
+            });
+        q.emplace([&acc, t = throwing_copy{} ](int x)
+            {
+                acc -= x;
+            });
+
+        // The second bucket throws: the first copied one is destroyed.
+        bool thrown = false;
+
+        try
+        {
+            auto q_copy = q;
+        }
+        catch(int)
+        {
+            thrown = true;
+        }
+
+        TEST_ASSERT(thrown);
+        TEST_ASSERT_OP(ctors - dtors, ==, 1);
+
+        q.call_all(3);
+        TEST_ASSERT_OP(acc, ==, 0);
+    }
+
+    TEST_ASSERT_OP(ctors - dtors, ==, 0);
+}
+
+TEST_MAIN()
+{
+    basic_tests<dod_function_queue<void(int)>>();
+    basic_tests<dod_function_queue<void(int), true>>();
+
+    order_tests();
+    copy_move_tests();
+    throwing_copy_tests();
+
+    return 0;
+}
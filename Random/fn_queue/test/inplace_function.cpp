@@ -0,0 +1,127 @@
+#include "./test_utils.hpp"
+#include "../inplace_function.hpp"
+
+static int ctors;
+static int dtors;
+
+struct counter
+{
+    counter()
+    {
+        ++ctors;
+    }
+    ~counter()
+    {
+        ++dtors;
+    }
+
+    counter(const counter&)
+    {
+        ++ctors;
+    }
+    counter(counter&&)
+    {
+        ++ctors;
+    }
+};
+
+// The wrapper is a vtable pointer plus the inline buffer.
+SA(sizeof(inplace_function<void(), 32>) == 32 + alignof(std::max_align_t));
+
+// Copy and move operations follow the vtable options.
+SA(!std::is_copy_constructible<inplace_function<void(), 32>>{});
+SA(std::is_move_constructible<inplace_function<void(), 32>>{});
+SA(std::is_copy_constructible<copyable_inplace_function<void(), 32>>{});
+SA(std::is_move_constructible<copyable_inplace_function<void(), 32>>{});
+
+using non_movable_vtable = vtable::type<void(), vtable::option::call_t,
+    vtable::option::dtor_t>;
+
+SA(!std::is_copy_constructible<
+    basic_inplace_function<void(), 32, non_movable_vtable>>{});
+SA(!std::is_move_constructible<
+    basic_inplace_function<void(), 32, non_movable_vtable>>{});
+
+void basic_tests()
+{
+    inplace_function<int(int), 16> f;
+    TEST_ASSERT(!f);
+
+    int k = 10;
+    f = [k](int x)
+    {
+        return x * k;
+    };
+
+    TEST_ASSERT(static_cast<bool>(f));
+    TEST_ASSERT_OP(f(2), ==, 20);
+
+    f = nullptr;
+    TEST_ASSERT(!f);
+}
+
+void recursion_tests()
+{
+    inplace_function<int(int), 16> fact = [&fact](int x)
+    {
+        return x == 0 ? 1 : x * fact(x - 1);
+    };
+
+    TEST_ASSERT_OP(fact(6), ==, 720);
+}
+
+void move_only_tests()
+{
+    inplace_function<int(), 16> f = [p = std::make_unique<int>(42)]
+    {
+        return *p;
+    };
+
+    auto f_moved = std::move(f);
+    TEST_ASSERT(!f);
+    TEST_ASSERT_OP(f_moved(), ==, 42);
+
+    inplace_function<int(std::unique_ptr<int>), 16> g =
+        [](std::unique_ptr<int> p)
+    {
+        return *p;
+    };
+
+    TEST_ASSERT_OP(g(std::make_unique<int>(1)), ==, 1);
+}
+
+void lifetime_tests()
+{
+    ctors = dtors = 0;
+
+    {
+        copyable_inplace_function<void(), 32> f = [c = counter{}]
+        {
+        };
+        TEST_ASSERT_OP(ctors - dtors, ==, 1);
+
+        auto f_copy = f;
+        TEST_ASSERT_OP(ctors - dtors, ==, 2);
+
+        auto f_moved = std::move(f);
+        TEST_ASSERT_OP(ctors - dtors, ==, 2);
+
+        f_copy = f_moved;
+        TEST_ASSERT_OP(ctors - dtors, ==, 2);
+
+        f_copy = [] {};
+        TEST_ASSERT_OP(ctors - dtors, ==, 1);
+    }
+
+    TEST_ASSERT_OP(ctors - dtors, ==, 0);
+}
+
+TEST_MAIN()
+{
+    basic_tests();
+    recursion_tests();
+    move_only_tests();
+    lifetime_tests();
+
+    return 0;
+}
@@ -0,0 +1,186 @@
+#include "./test_utils.hpp"
+#include "../mpsc_fn_queue.hpp"
+
+static int ctors;
+static int dtors;
+
+struct counter
+{
+    counter()
+    {
+        ++ctors;
+    }
+    ~counter()
+    {
+        ++dtors;
+    }
+
+    counter(const counter&)
+    {
+        ++ctors;
+    }
+    counter(counter&&)
+    {
+        ++ctors;
+    }
+};
+
+void basic_tests()
+{
+    int acc = 0;
+    mpsc_function_queue<void(int), 1024> q;
+
+    q.emplace([&acc](int x)
+        {
+            acc += x;
+        });
+    q.emplace([&acc, k = 10 ](int x)
+        {
+            acc += x * k;
+        });
+
+    TEST_ASSERT_OP(q.drain(2), ==, 2);
+    TEST_ASSERT_OP(acc, ==, 22);
+
+    TEST_ASSERT_OP(q.drain(2), ==, 0);
+    TEST_ASSERT_OP(acc, ==, 22);
+}
+
+void overflow_tests()
+{
+    ctors = dtors = 0;
+
+    {
+        int acc = 0;
+        mpsc_function_queue<void(), 256> q;
+
+        int pushed = 0;
+        while(q.try_emplace([&acc, c = counter{} ]
+            {
+                ++acc;
+            }))
+        {
+            ++pushed;
+        }
+
+        TEST_ASSERT_OP(pushed, >, 0);
+        TEST_ASSERT(!q.try_emplace([] {}));
+        TEST_ASSERT_OP(ctors - dtors, ==, pushed);
+
+        TEST_ASSERT_OP(q.drain(), ==, pushed);
+        TEST_ASSERT_OP(acc, ==, pushed);
+        TEST_ASSERT_OP(ctors - dtors, ==, 0);
+
+        // Space is available again after draining.
+        TEST_ASSERT(q.try_emplace([&acc, c = counter{} ]
+            {
+                ++acc;
+            }));
+    }
+
+    // The remaining callable object is destroyed with the queue.
+    TEST_ASSERT_OP(ctors - dtors, ==, 0);
+}
+
+struct throwing_move
+{
+    throwing_move() = default;
+    throwing_move(throwing_move&&)
+    {
+        throw 0;
+    }
+};
+
+void throwing_ctor_tests()
+{
+    int acc = 0;
+    mpsc_function_queue<int(), 1024> q;
+
+    q.emplace([&acc]
+        {
+            return ++acc;
+        });
+
+    auto throwing_fn([&acc, t = throwing_move{} ]
+        {
+            return acc += 100;
+        });
+
+    bool thrown = false;
+
+    try
+    {
+        q.emplace(std::move(throwing_fn));
+    }
+    catch(int)
+    {
+        thrown = true;
+    }
+
+    TEST_ASSERT(thrown);
+
+    q.emplace([&acc]
+        {
+            return ++acc;
+        });
+
+    // The failed entry is skipped, and `drain` does not wait for its
+    // producer.
+    TEST_ASSERT_OP(q.drain(), ==, 2);
+    TEST_ASSERT_OP(acc, ==, 2);
+}
+
+void multi_producer_tests()
+{
+    constexpr int producer_count = 4;
+    constexpr int pushes = 20000;
+
+    mpsc_function_queue<void(), 4096> q;
+    std::atomic<int> done{0};
+    long long acc = 0;
+    long long calls = 0;
+
+    std::vector<std::thread> producers;
+    for(int p = 0; p < producer_count; ++p)
+    {
+        producers.emplace_back([&q, &done, &acc, p]
+            {
+                for(int i = 0; i < pushes; ++i)
+                {
+                    // Only the consumer invokes: `acc` needs no sync.
+                    q.emplace([&acc, x = p * pushes + i]
+                        {
+                            acc += x;
+                        });
+                }
+
+                ++done;
+            });
+    }
+
+    while(done.load() != producer_count)
+    {
+        calls += q.drain();
+    }
+
+    calls += q.drain();
+
+    for(auto& t : producers)
+    {
+        t.join();
+    }
+
+    constexpr long long n = producer_count * pushes;
+    TEST_ASSERT_OP(calls, ==, n);
+    TEST_ASSERT_OP(acc, ==, n * (n - 1) / 2);
+}
+
+TEST_MAIN()
+{
+    basic_tests();
+    overflow_tests();
+    throwing_ctor_tests();
+    multi_producer_tests();
+
+    return 0;
+}
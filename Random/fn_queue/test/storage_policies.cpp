@@ -0,0 +1,332 @@
+#include "./test_utils.hpp"
+#include "../base_fn_queue.hpp"
+
+static int ctors;
+static int copy_ctors;
+static int move_ctors;
+static int dtors;
+
+struct counter
+{
+    counter()
+    {
+        ++ctors;
+    }
+    ~counter()
+    {
+        ++dtors;
+    }
+
+    counter(const counter&)
+    {
+        ++copy_ctors;
+    }
+    counter(counter&&)
+    {
+        ++move_ctors;
+    }
+};
+
+void counter_reset()
+{
+    ctors = dtors = copy_ctors = move_ctors = 0;
+}
+
+auto alive_counters()
+{
+    return ctors + copy_ctors + move_ctors - dtors;
+}
+
+// Number of copies or moves of `throwing_counter` before one throws, or
+// `-1` to never throw.
+static int throw_countdown{-1};
+
+struct throwing_counter : counter
+{
+    throwing_counter() = default;
+
+    throwing_counter(const throwing_counter& rhs) : counter(rhs)
+    {
+        maybe_throw();
+    }
+
+    throwing_counter(throwing_counter&& rhs) : counter(std::move(rhs))
+    {
+        maybe_throw();
+    }
+
+    static void maybe_throw()
+    {
+        if(throw_countdown >= 0 && throw_countdown-- == 0) throw 0;
+    }
+};
+
+template <typename TQueue>
+void basic_tests()
+{
+    int acc = 0;
+    int one = 1;
+
+    TQueue q;
+    TEST_ASSERT(q.empty());
+
+    q.emplace([&acc](int x)
+        {
+            acc += x;
+        });
+    q.emplace([&acc, one](int)
+        {
+            acc += one;
+        });
+    q.emplace([&acc, v = std::vector<int>{1, 2, 3} ](int x)
+        {
+            acc -= x + v.size() - 3;
+        });
+    q.emplace([&acc, one](int)
+        {
+            acc -= one;
+        });
+
+    TEST_ASSERT_OP(q.size(), ==, 4);
+
+    q.call_all(5);
+    TEST_ASSERT_OP(acc, ==, 0);
+
+    q.clear();
+    TEST_ASSERT(q.empty());
+
+    q.call_all(5);
+    TEST_ASSERT_OP(acc, ==, 0);
+}
+
+template <typename TQueue>
+void copy_move_tests()
+{
+    counter_reset();
+
+    {
+        int acc = 0;
+        TQueue q;
+
+        q.emplace([&acc, c = counter{} ](int x)
+            {
+                acc += x;
+            });
+        q.emplace([&acc, c = counter{} ](int x)
+            {
+                acc -= x;
+            });
+        TEST_ASSERT_OP(alive_counters(), ==, 2);
+
+        auto q_copy = q;
+        TEST_ASSERT_OP(copy_ctors, ==, 2);
+        TEST_ASSERT_OP(alive_counters(), ==, 4);
+
+        q_copy.call_all(5);
+        TEST_ASSERT_OP(acc, ==, 0);
+
+        auto q_moved = std::move(q_copy);
+        TEST_ASSERT(q_copy.empty());
+        TEST_ASSERT_OP(q_moved.size(), ==, 2);
+        TEST_ASSERT_OP(alive_counters(), ==, 4);
+
+        q_moved.call_all(5);
+        TEST_ASSERT_OP(acc, ==, 0);
+
+        q = q_moved;
+        TEST_ASSERT_OP(alive_counters(), ==, 4);
+
+        q = std::move(q_moved);
+        TEST_ASSERT_OP(alive_counters(), ==, 2);
+
+        q.call_all(3);
+        TEST_ASSERT_OP(acc, ==, 0);
+    }
+
+    TEST_ASSERT_OP(alive_counters(), ==, 0);
+}
+
+void move_only_tests()
+{
+    int acc = 0;
+
+    dynamic_fn_queue<void(int)> q;
+    q.emplace([&acc, p = std::make_unique<int>(10) ](int x)
+        {
+            acc += *p + x;
+        });
+
+    auto q_moved = std::move(q);
+    q_moved.call_all(1);
+    TEST_ASSERT_OP(acc, ==, 11);
+}
+
+void growth_tests()
+{
+    counter_reset();
+
+    {
+        int acc = 0;
+        dynamic_fn_queue<void(int)> q;
+
+        for(int i = 0; i < 1000; ++i)
+        {
+            q.emplace([&acc, i, c = counter{} ](int x)
+                {
+                    acc += i * x;
+                });
+        }
+
+        auto& s = q.storage();
+        TEST_ASSERT_OP(s.capacity(), >=, s.used_bytes());
+        TEST_ASSERT_OP(alive_counters(), ==, 1000);
+
+        q.call_all(2);
+        TEST_ASSERT_OP(acc, ==, 999 * 1000);
+    }
+
+    TEST_ASSERT_OP(alive_counters(), ==, 0);
+}
+
+template <typename TQueue>
+void throwing_copy_tests()
+{
+    counter_reset();
+
+    {
+        int acc = 0;
+        TQueue q;
+
+        for(int i = 0; i < 4; ++i)
+        {
+            q.emplace([&acc, c = throwing_counter{} ](int x)
+                {
+                    acc += x;
+                });
+        }
+
+        TEST_ASSERT_OP(alive_counters(), ==, 4);
+
+        // The third copy throws: the two copied objects are destroyed.
+        bool thrown = false;
+        throw_countdown = 2;
+
+        try
+        {
+            auto q_copy = q;
+        }
+        catch(int)
+        {
+            thrown = true;
+        }
+
+        TEST_ASSERT(thrown);
+        TEST_ASSERT_OP(alive_counters(), ==, 4);
+
+        // The assigned queue is left empty.
+        TQueue q_assigned;
+        q_assigned.emplace([c = throwing_counter{} ](int)
+            {
+            });
+
+        thrown = false;
+        throw_countdown = 2;
+
+        try
+        {
+            q_assigned = q;
+        }
+        catch(int)
+        {
+            thrown = true;
+        }
+
+        throw_countdown = -1;
+
+        TEST_ASSERT(thrown);
+        TEST_ASSERT(q_assigned.empty());
+        TEST_ASSERT_OP(alive_counters(), ==, 4);
+
+        q.call_all(1);
+        TEST_ASSERT_OP(acc, ==, 4);
+    }
+
+    TEST_ASSERT_OP(alive_counters(), ==, 0);
+}
+
+void throwing_relocation_tests()
+{
+    counter_reset();
+
+    {
+        int acc = 0;
+        dynamic_fn_queue<void(int)> q;
+
+        auto emplace_one([&]
+            {
+                q.emplace([&acc, c = throwing_counter{} ](int x)
+                    {
+                        acc += x;
+                    });
+            });
+
+        emplace_one();
+
+        auto& s = q.storage();
+        auto entry_bytes = s.used_bytes();
+
+        while(s.used_bytes() + entry_bytes <= s.capacity()) emplace_one();
+
+        auto size = q.size();
+        auto capacity = s.capacity();
+        TEST_ASSERT_OP(alive_counters(), ==, size);
+
+        // The next emplacement relocates, and the second move throws: the
+        // objects stay in the current buffer.
+        bool thrown = false;
+        throw_countdown = 1;
+
+        try
+        {
+            emplace_one();
+        }
+        catch(int)
+        {
+            thrown = true;
+        }
+
+        throw_countdown = -1;
+
+        TEST_ASSERT(thrown);
+        TEST_ASSERT_OP(q.size(), ==, size);
+        TEST_ASSERT_OP(s.capacity(), ==, capacity);
+        TEST_ASSERT_OP(alive_counters(), ==, size);
+
+        q.call_all(1);
+        TEST_ASSERT_OP(acc, ==, size);
+
+        emplace_one();
+        TEST_ASSERT_OP(q.size(), ==, size + 1);
+        TEST_ASSERT_OP(s.capacity(), >, capacity);
+    }
+
+    TEST_ASSERT_OP(alive_counters(), ==, 0);
+}
+
+TEST_MAIN()
+{
+    basic_tests<fixed_fn_queue<void(int), 512>>();
+    basic_tests<dynamic_fn_queue<void(int)>>();
+
+    copy_move_tests<fixed_fn_queue<void(int), 512>>();
+    copy_move_tests<dynamic_fn_queue<void(int)>>();
+
+    throwing_copy_tests<fixed_fn_queue<void(int), 512>>();
+    throwing_copy_tests<dynamic_fn_queue<void(int)>>();
+
+    move_only_tests();
+    growth_tests();
+    throwing_relocation_tests();
+
+    return 0;
+}
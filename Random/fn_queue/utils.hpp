@@ -8,4 +8,13 @@ constexpr auto multiple_round_up(T0 x, T1 multiple) noexcept
 {
     VRM_CORE_CONSTEXPR_ASSERT(multiple != 0);
     return ((x + multiple - 1) / multiple) * multiple;
-}
\ No newline at end of file
+}
+
+/// @brief Round up `x` to the nearest multiple of `multiple`, which must be a
+/// power of two.
+template <typename T0, typename T1>
+constexpr auto pow2_round_up(T0 x, T1 multiple) noexcept
+{
+    VRM_CORE_CONSTEXPR_ASSERT((multiple & (multiple - 1)) == 0);
+    return (x + multiple - 1) & ~(multiple - 1);
+}
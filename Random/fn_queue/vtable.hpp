@@ -97,7 +97,8 @@ namespace vtable
             {
                 bh::at_key(vt, option::call) = [](char* obj, TArgs... xs)
                 {
-                    return reinterpret_cast<TF*>(obj)->operator()(xs...);
+                    return reinterpret_cast<TF*>(obj)->operator()(
+                        std::forward<TArgs>(xs)...);
                 };
             }
 
@@ -142,10 +143,12 @@ namespace vtable
     }
 
     template <typename TOption, typename TVTable, typename... Ts>
-    void exec_fp(TOption o, TVTable& vt, Ts&&... xs)
+    decltype(auto) exec_fp(TOption o, TVTable& vt, Ts&&... xs)
     {
         auto& fp = bh::at_key(vt, o);
-        (*fp)(FWD(xs)...);
+        VRM_CORE_ASSERT(fp != nullptr);
+
+        return (*fp)(FWD(xs)...);
     }
 
     template <typename TVTable, typename TOption>
@@ -186,6 +189,34 @@ namespace vtable
                 })(vt);
     }
 
+    /// @brief Vtable bound to a specific callable object type, also storing
+    /// its size and alignment.
+    template <typename TVTable>
+    struct instance_type
+    {
+        TVTable fps;
+        std::size_t fn_size;
+        std::size_t fn_alignment;
+    };
+
+    /// @brief Returns the unique vtable instance of type `TVTable` bound to
+    /// `TF`.
+    /// @details Containers can store a pointer to it instead of a copy of
+    /// the whole vtable for every callable object.
+    template <typename TF, typename TSignature, typename TVTable>
+    const auto& instance() noexcept
+    {
+        static const instance_type<TVTable> result{[]
+            {
+                TVTable vt{};
+                setup<TF, TSignature>(vt);
+                return vt;
+            }(),
+            sizeof(TF), alignof(TF)};
+
+        return result;
+    }
+
     template <typename TSignature, typename... TOptions>
     using type = decltype(make<TSignature>(option::make_list(TOptions{}...)));
 }
@@ -108,6 +108,38 @@ namespace behavior
     };
     static_assert(is_valid_behavior<vbo_b>{}, "");
 
+    /// @brief $vbo_b$ with deferred deinitialization: destroyed buffers
+    /// are deleted by a single $glDeleteBuffers$ call in
+    /// $resource::flush_deinit<vbo_batched_b>()$.
+    /// @details Handles must refer to a single buffer. The ids are copied
+    /// on the stack, $chunk_size$ at a time, so that flushing (e.g. from
+    /// the queue's destructor) never allocates.
+    struct vbo_batched_b : vbo_b
+    {
+        static constexpr std::size_t chunk_size{1024};
+
+        vbo_batched_b() = delete;
+
+        static void deinit_batch(const handle_type* handles, std::size_t n)
+        {
+            legacy::GLuint ids[chunk_size];
+
+            for(std::size_t b(0); b < n; b += chunk_size)
+            {
+                auto count(n - b < chunk_size ? n - b : chunk_size);
+
+                for(std::size_t i(0); i < count; ++i)
+                {
+                    assert(handles[b + i]._n == 1);
+                    ids[i] = handles[b + i]._id;
+                }
+
+                legacy::glDeleteBuffers(count, ids);
+            }
+        }
+    };
+    static_assert(is_valid_behavior<vbo_batched_b>{}, "");
+
     struct file_b
     {
         using handle_type = int;
@@ -130,4 +162,18 @@ namespace behavior
         }
     };
     static_assert(is_valid_behavior<file_b>{}, "");
+
+    /// @brief $file_b$ with deferred deinitialization: closed files are
+    /// closed by a single $close_files$ call in
+    /// $resource::flush_deinit<file_batched_b>()$.
+    struct file_batched_b : file_b
+    {
+        file_batched_b() = delete;
+
+        static void deinit_batch(const handle_type* handles, std::size_t n)
+        {
+            legacy::close_files(handles, n);
+        }
+    };
+    static_assert(is_valid_behavior<file_batched_b>{}, "");
 }
\ No newline at end of file
@@ -0,0 +1,162 @@
+// Copyright (c) 2013-2015 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+// Allocations per $shared$ free store resource, and latency of "copy, read
+// the object, destroy" over many resources in random order, which touches
+// the metadata and the object. Build with `-std=c++14 -O2`.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <vector>
+#include "./shared.hpp"
+#include "./shared_resource.hpp"
+#include "./make_resource.hpp"
+
+static std::size_t allocations{0};
+
+void* operator new(std::size_t n)
+{
+    ++allocations;
+
+    if(auto p = std::malloc(n)) return p;
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+namespace
+{
+    struct object
+    {
+        int _value;
+        char _padding[60];
+
+        object(int value) : _value{value}
+        {
+        }
+    };
+
+    // As $behavior::free_store_b$, without logging.
+    struct heap_b
+    {
+        using handle_type = object*;
+
+        heap_b() = delete;
+
+        static handle_type null_handle()
+        {
+            return nullptr;
+        }
+
+        static handle_type init(int value)
+        {
+            return new object{value};
+        }
+
+        static void deinit(const handle_type& handle)
+        {
+            delete handle;
+        }
+    };
+
+    constexpr int count = 1 << 18;
+
+    template <typename TMake>
+    void run(const char* title, TMake&& make)
+    {
+        using handle = decltype(make(0));
+
+        std::vector<handle> handles;
+        handles.reserve(count);
+
+        // Interleaves unrelated allocations, as a long running program
+        // would, so that separate allocations are not adjacent.
+        std::vector<std::unique_ptr<object>> noise;
+        noise.reserve(count);
+
+        auto a0 = allocations;
+
+        for(int i = 0; i < count; ++i)
+        {
+            handles.emplace_back(make(i));
+            noise.emplace_back(new object{i});
+        }
+
+        auto per_resource = double(allocations - a0 - count) / count;
+
+        // $shared$ asserts against self-move-assignment: shuffle indices.
+        std::vector<int> order(count);
+        for(int i = 0; i < count; ++i) order[i] = i;
+
+        std::mt19937 rng{0};
+        std::shuffle(order.begin(), order.end(), rng);
+
+        long long sum{0};
+        auto start = std::chrono::high_resolution_clock::now();
+
+        for(int r = 0; r < 4; ++r)
+        {
+            for(auto i : order)
+            {
+                auto copy = handles[i];
+                sum += copy->_value;
+            }
+        }
+
+        auto end = std::chrono::high_resolution_clock::now();
+        auto ns = std::chrono::duration<double, std::nano>(end - start);
+
+        std::printf("%-30s | %4.2f allocations | %6.2f ns per access (%lld)\n",
+            title, per_resource, ns.count() / (4.0 * count), sum);
+    }
+
+    template <typename TResource>
+    struct arrow : TResource
+    {
+        using TResource::TResource;
+
+        arrow(TResource&& r) : TResource{std::move(r)}
+        {
+        }
+
+        auto operator-> () const noexcept
+        {
+            return this->get();
+        }
+    };
+}
+
+int main()
+{
+    run("shared, separate metadata", [](int i)
+        {
+            return arrow<resource::shared<heap_b>>{heap_b::init(i)};
+        });
+
+    run("make_shared_resource_inline", [](int i)
+        {
+            using r = resource::shared<behavior::free_store_b<object>>;
+            return arrow<r>{make_shared_resource_inline<object>(i)};
+        });
+
+    run("std::make_shared", [](int i)
+        {
+            return std::make_shared<object>(i);
+        });
+
+    return 0;
+}
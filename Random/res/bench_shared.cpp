@@ -0,0 +1,124 @@
+// Copyright (c) 2013-2015 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+// Copy + destroy throughput of $shared$ handles with every lock policy,
+// against $std::shared_ptr$. Build with `-std=c++14 -O2 -pthread`.
+// * "local": every thread copies a handle it created.
+// * "common": every thread copies one handle created by the main thread.
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "./shared.hpp"
+#include "./shared_resource.hpp"
+
+namespace
+{
+    struct int_behavior
+    {
+        using handle_type = int;
+
+        static handle_type null_handle() noexcept
+        {
+            return -1;
+        }
+
+        static handle_type init() noexcept
+        {
+            return 0;
+        }
+
+        static void deinit(const handle_type&) noexcept
+        {
+        }
+    };
+
+    constexpr int iterations = 2000000;
+
+    template <typename T>
+    void copy_loop(const T& src)
+    {
+        for(int i = 0; i < iterations; ++i)
+        {
+            T copy{src};
+            asm volatile("" : : "r"(&copy) : "memory");
+        }
+    }
+
+    template <typename TF>
+    double measure(int thread_count, TF&& f)
+    {
+        std::vector<std::thread> threads;
+        auto start = std::chrono::high_resolution_clock::now();
+
+        for(int t = 0; t < thread_count; ++t) threads.emplace_back(f);
+        for(auto& t : threads) t.join();
+
+        auto end = std::chrono::high_resolution_clock::now();
+        auto ns = std::chrono::duration<double, std::nano>(end - start);
+
+        return ns.count() / (double(iterations) * thread_count);
+    }
+
+    template <typename TMake>
+    void run(const char* title, TMake&& make)
+    {
+        std::printf("%-22s", title);
+
+        for(int threads : {1, 2, 4, 8, 16})
+        {
+            auto local = measure(threads, [&make]
+                {
+                    auto h = make();
+                    copy_loop(h);
+                });
+
+            auto common_handle = make();
+            auto common = measure(threads, [&common_handle]
+                {
+                    copy_loop(common_handle);
+                });
+
+            std::printf(" | %5.2f %5.2f", local, common);
+        }
+
+        std::printf("\n");
+    }
+}
+
+int main()
+{
+    std::printf("ns per copy + destroy, \"local common\" for 1 2 4 8 16 "
+                "threads\n");
+
+    {
+        resource::shared<int_behavior> h{int_behavior::init()};
+        auto ns = measure(1, [&h]
+            {
+                copy_loop(h);
+            });
+
+        std::printf("%-22s | %5.2f (1 thread only)\n", "shared (none)", ns);
+    }
+
+    run("std::shared_ptr", []
+        {
+            return std::make_shared<int>(0);
+        });
+
+    run("atomic_shared", []
+        {
+            return resource::atomic_shared<int_behavior>{int_behavior::init()};
+        });
+
+    run("biased_shared", []
+        {
+            return resource::biased_shared<int_behavior>{int_behavior::init()};
+        });
+
+    return 0;
+}
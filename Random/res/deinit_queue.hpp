@@ -0,0 +1,158 @@
+// Copyright (c) 2013-2015 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+#include "./shared.hpp"
+
+namespace resource
+{
+    namespace impl
+    {
+        template <typename>
+        using deinit_void_t = void;
+
+        /// @brief A behavior opts in to deferred deinitialization by
+        /// defining a static $deinit_batch(const handle_type*, std::size_t)$
+        /// method.
+        template <typename T, typename = void>
+        struct has_deinit_batch : std::false_type
+        {
+        };
+
+        template <typename T>
+        struct has_deinit_batch<T,
+            deinit_void_t<decltype(&T::deinit_batch)>> : std::true_type
+        {
+        };
+
+        /// @brief Per-thread queue of handles waiting for a batched
+        /// $deinit_batch$ call. Flushed by $flush_deinit$, and when the
+        /// thread exits.
+        /// @details Objects with static storage duration, and thread-local
+        /// objects constructed before the queue, are destroyed after it.
+        /// Once the queue has been destroyed, $local()$ returns $nullptr$
+        /// and their handles are deinitialized immediately.
+        template <typename TBehavior>
+        class deinit_queue
+        {
+        public:
+            using behavior_type = TBehavior;
+            using handle_type = typename behavior_type::handle_type;
+
+        private:
+            std::vector<handle_type> _handles;
+
+            deinit_queue() = default;
+
+            // Trivially destructible: still usable after the queue has been
+            // destroyed.
+            static bool& destroyed() noexcept
+            {
+                thread_local bool d{false};
+                return d;
+            }
+
+        public:
+            ~deinit_queue()
+            {
+                destroyed() = true;
+                flush();
+            }
+
+            /// @brief Queue of the calling thread, or $nullptr$ if it has
+            /// already been destroyed.
+            static deinit_queue* local()
+            {
+                if(destroyed()) return nullptr;
+
+                thread_local deinit_queue q;
+                return &q;
+            }
+
+            void push(const handle_type& handle)
+            {
+                // Null handles can be destroyed at any time.
+                if(handle == behavior_type::null_handle()) return;
+
+                // Called when a resource is destroyed: if the handle cannot
+                // be queued, it is deinitialized immediately.
+                try
+                {
+                    _handles.emplace_back(handle);
+                }
+                catch(...)
+                {
+                    behavior_type::deinit_batch(&handle, 1);
+                }
+            }
+
+            void flush()
+            {
+                if(_handles.empty()) return;
+
+                behavior_type::deinit_batch(_handles.data(), _handles.size());
+                _handles.clear();
+            }
+
+            auto size() const noexcept
+            {
+                return _handles.size();
+            }
+        };
+
+        template <typename TBehavior>
+        void deinit_handle(const typename TBehavior::handle_type& handle,
+            std::false_type)
+        {
+            TBehavior::deinit(handle);
+        }
+
+        template <typename TBehavior>
+        void deinit_handle(
+            const typename TBehavior::handle_type& handle, std::true_type)
+        {
+            if(auto q = deinit_queue<TBehavior>::local())
+            {
+                q->push(handle);
+                return;
+            }
+
+            if(handle != TBehavior::null_handle())
+            {
+                TBehavior::deinit_batch(&handle, 1);
+            }
+        }
+
+        /// @brief Deinitializes $handle$, or queues it on the calling thread
+        /// if $TBehavior$ has a $deinit_batch$ method.
+        template <typename TBehavior>
+        void deinit_handle(const typename TBehavior::handle_type& handle)
+        {
+            deinit_handle<TBehavior>(handle, has_deinit_batch<TBehavior>{});
+        }
+    }
+
+    /// @brief Deinitializes the handles of $TBehavior$ queued on the
+    /// calling thread with a single $deinit_batch$ call. Call it at a point
+    /// where the backend can be used (e.g. once per frame, with the GL
+    /// context current).
+    template <typename TBehavior>
+    void flush_deinit()
+    {
+        if(auto q = impl::deinit_queue<TBehavior>::local()) q->flush();
+    }
+
+    /// @brief Number of handles of $TBehavior$ queued on the calling thread.
+    template <typename TBehavior>
+    auto pending_deinit_count()
+    {
+        auto q = impl::deinit_queue<TBehavior>::local();
+        return q != nullptr ? q->size() : std::size_t(0);
+    }
+}
@@ -39,6 +39,10 @@ namespace legacy
     using GLsizei = std::size_t;
     using GLuint = int;
 
+    // Calls and deleted buffers, counted by the mock functions.
+    int glDeleteBuffers_calls{0};
+    int deleted_buffers{0};
+
     void glGenBuffers(GLsizei n, GLuint* ptr)
     {
         static GLuint next_id{1};
@@ -56,6 +60,9 @@ namespace legacy
         }
         else
         {
+            ++glDeleteBuffers_calls;
+            deleted_buffers += n;
+
             std::cout << "glDeleteBuffers(" << n << ", " << *ptr << ")\n";
         }
     }
@@ -64,6 +71,10 @@ namespace legacy
 // File
 namespace legacy
 {
+    // Calls and closed files, counted by the mock functions.
+    int close_calls{0};
+    int closed_files{0};
+
     int open_file()
     {
         static int next_id(1);
@@ -81,7 +92,20 @@ namespace legacy
         }
         else
         {
+            ++close_calls;
+            ++closed_files;
+
             std::cout << "close_file(" << id << ")\n";
         }
     }
+
+    // Closes $n$ files with a single call (as $close_range$ or a batch of
+    // submissions to an $io_uring$ would).
+    void close_files(const int* ids, std::size_t n)
+    {
+        ++close_calls;
+        closed_files += n;
+
+        std::cout << "close_files(" << n << ", " << ids[0] << "...)\n";
+    }
 }
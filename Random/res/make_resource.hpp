@@ -8,6 +8,8 @@
 #include "./shared.hpp"
 #include "./unique_resource.hpp"
 #include "./shared_resource.hpp"
+#include "./shared_block.hpp"
+#include "./behavior.hpp"
 
 template <template <typename> class TResource, typename TBehavior>
 class resource_maker
@@ -48,4 +50,30 @@ template <typename TBehavior, typename... Ts>
 auto make_shared_resource(Ts&&... xs) noexcept(noexcept(true))
 {
     return make_resource<resource::shared, TBehavior>(FWD(xs)...);
-}
\ No newline at end of file
+}
+
+// Allocates the metadata of a $shared$ free store resource and the object
+// it manages in a single block, obtained from $alloc$. The object is
+// destroyed by the last owner, and the block is deallocated by the last
+// weak reference.
+template <typename T,
+    typename TLockPolicy = resource::impl::shared_lock_policy::none,
+    typename TAllocator, typename... Ts>
+auto allocate_shared_resource(const TAllocator& alloc, Ts&&... xs)
+{
+    using block_type = resource::impl::shared_block<TLockPolicy, T, TAllocator>;
+    using resource_type =
+        resource::impl::shared<behavior::free_store_b<T>, TLockPolicy>;
+
+    auto b = block_type::create(alloc, FWD(xs)...);
+    return resource_type{resource::impl::adopt_metadata, b->object(), b};
+}
+
+template <typename T,
+    typename TLockPolicy = resource::impl::shared_lock_policy::none,
+    typename... Ts>
+auto make_shared_resource_inline(Ts&&... xs)
+{
+    return allocate_shared_resource<T, TLockPolicy>(
+        std::allocator<T>{}, FWD(xs)...);
+}
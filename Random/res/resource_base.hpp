@@ -6,6 +6,7 @@
 #pragma once
 
 #include "./shared.hpp"
+#include "./deinit_queue.hpp"
 
 namespace resource
 {
@@ -25,6 +26,8 @@ namespace resource
         /// Defines a default constructor and an $explicit$ constructor that 
         /// taken an handle.
         /// Provides shortcut methods to $deinit$, $nullify$, and $release$.
+        /// $deinit$ queues the handle instead if the behavior supports
+        /// batched deinitialization (see $deinit_queue$).
         /// Provides a $get$ method and $bool$ conversions.
         template <typename TBehavior>
         class resource_base
@@ -38,7 +38,7 @@ namespace resource
         template <typename TBehavior>
         void resource_base<TBehavior>::deinit()
         {
-            behavior_type::deinit(_handle);
+            deinit_handle<behavior_type>(_handle);
         }
 
         template <typename TBehavior>
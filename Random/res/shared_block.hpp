@@ -0,0 +1,108 @@
+// Copyright (c) 2013-2015 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#pragma once
+
+#include <memory>
+#include <type_traits>
+#include "./shared.hpp"
+#include "./shared_metadata.hpp"
+
+namespace resource
+{
+    namespace impl
+    {
+        /// @brief Single allocation holding a $shared_metadata$ instance
+        /// and a $T$ object, obtained from $TAllocator$.
+        /// @details The object is destroyed when the last owner is, and
+        /// the block is deallocated when the last weak reference is.
+        /// The allocator is an empty base when stateless.
+        template <typename TLockPolicy, typename T, typename TAllocator>
+        class shared_block : public shared_metadata<TLockPolicy>,
+                             private std::allocator_traits<TAllocator>::
+                                 template rebind_alloc<shared_block<
+                                     TLockPolicy, T, TAllocator>>
+        {
+        public:
+            using metadata_type = shared_metadata<TLockPolicy>;
+
+            using allocator_type = typename std::allocator_traits<
+                TAllocator>::template rebind_alloc<shared_block>;
+
+            using allocator_traits = std::allocator_traits<allocator_type>;
+
+        private:
+            std::aligned_storage_t<sizeof(T), alignof(T)> _storage;
+
+            static const typename metadata_type::block_functions functions;
+
+            static auto& from_metadata(metadata_type& m) noexcept
+            {
+                return static_cast<shared_block&>(m);
+            }
+
+            static void dispose(metadata_type& m) noexcept
+            {
+                from_metadata(m).object()->~T();
+            }
+
+            static void deallocate(metadata_type& m) noexcept
+            {
+                auto& b(from_metadata(m));
+                allocator_type a{std::move(static_cast<allocator_type&>(b))};
+
+                b.~shared_block();
+                allocator_traits::deallocate(a, &b, 1);
+            }
+
+        public:
+            explicit shared_block(const allocator_type& a)
+                : metadata_type{1, 0, &functions}, allocator_type{a}
+            {
+            }
+
+            auto object() noexcept
+            {
+                return reinterpret_cast<T*>(&_storage);
+            }
+
+            /// @brief Returns a block owned once, with a constructed object.
+            template <typename... Ts>
+            static auto create(const TAllocator& source, Ts&&... xs)
+            {
+                allocator_type a{source};
+                auto b = allocator_traits::allocate(a, 1);
+
+                try
+                {
+                    ::new(static_cast<void*>(b)) shared_block{a};
+                }
+                catch(...)
+                {
+                    allocator_traits::deallocate(a, b, 1);
+                    throw;
+                }
+
+                try
+                {
+                    ::new(static_cast<void*>(b->object())) T(FWD(xs)...);
+                }
+                catch(...)
+                {
+                    b->~shared_block();
+                    allocator_traits::deallocate(a, b, 1);
+                    throw;
+                }
+
+                return b;
+            }
+        };
+
+        template <typename TLockPolicy, typename T, typename TAllocator>
+        const typename shared_metadata<TLockPolicy>::block_functions
+            shared_block<TLockPolicy, T, TAllocator>::functions{
+                &shared_block::dispose, &shared_block::deallocate};
+    }
+}
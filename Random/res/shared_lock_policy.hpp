@@ -0,0 +1,505 @@
+// Copyright (c) 2013-2015 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include "./shared.hpp"
+
+namespace resource
+{
+    namespace impl
+    {
+        using shared_counter_type = unsigned int;
+
+        /// @brief Result of an owner count decrement.
+        enum class release_result
+        {
+            alive,
+            last,
+            deferred
+        };
+
+        // Reference counters used by $shared_metadata$.
+        // Every counter provides:
+        // * $increment()$.
+        // * $decrement()$, returning $true$ if the count reached zero, or a
+        // $release_result$ if $defers_release$ is $true$.
+        // * $try_increment()$, which fails if the count is zero.
+        // * $count()$.
+
+        /// @brief Non-thread-safe counter.
+        class plain_counter
+        {
+        private:
+            shared_counter_type _count;
+
+        public:
+            static constexpr bool defers_release = false;
+
+            explicit plain_counter(shared_counter_type count) noexcept
+                : _count{count}
+            {
+            }
+
+            void increment() noexcept
+            {
+                ++_count;
+            }
+
+            bool decrement() noexcept
+            {
+                assert(_count > 0);
+                return --_count == 0;
+            }
+
+            bool try_increment() noexcept
+            {
+                if(_count == 0) return false;
+
+                ++_count;
+                return true;
+            }
+
+            auto count() const noexcept
+            {
+                return _count;
+            }
+        };
+
+        /// @brief Thread-safe counter.
+        /// @details Increments are relaxed: a new reference can only be
+        /// created from an existing one, which keeps the count positive.
+        /// Decrements are $acq_rel$, so that the thread reaching zero sees
+        /// every access made through the other references.
+        class atomic_counter
+        {
+        private:
+            std::atomic<shared_counter_type> _count;
+
+        public:
+            static constexpr bool defers_release = false;
+
+            explicit atomic_counter(shared_counter_type count) noexcept
+                : _count{count}
+            {
+            }
+
+            void increment() noexcept
+            {
+                _count.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            bool decrement() noexcept
+            {
+                auto old = _count.fetch_sub(1, std::memory_order_acq_rel);
+                assert(old > 0);
+
+                return old == 1;
+            }
+
+            /// @brief Used to upgrade weak references: never resurrects a
+            /// count that reached zero.
+            bool try_increment() noexcept
+            {
+                auto c = _count.load(std::memory_order_relaxed);
+
+                do
+                {
+                    if(c == 0) return false;
+                } while(!_count.compare_exchange_weak(
+                    c, c + 1, std::memory_order_relaxed));
+
+                return true;
+            }
+
+            auto count() const noexcept
+            {
+                return _count.load(std::memory_order_relaxed);
+            }
+        };
+
+        /// @brief Deferred work executed by the thread owning a
+        /// $biased_counter$. Deletes itself after running.
+        class biased_merge_task
+        {
+            friend class biased_queue;
+
+        private:
+            biased_merge_task* _next{nullptr};
+
+        public:
+            virtual ~biased_merge_task() = default;
+            virtual void run() noexcept = 0;
+        };
+
+        /// @brief Lock-free queue of $biased_merge_task$ instances, one per
+        /// thread owning biased counters.
+        /// @details Shared by the thread and by the counters it owns: it
+        /// outlives the thread if counters do. When the thread exits, the
+        /// queue is closed and drained, and later pushes fail.
+        class biased_queue
+        {
+        private:
+            std::atomic<biased_merge_task*> _head{nullptr};
+            std::atomic<unsigned int> _refs{1};
+
+            static biased_merge_task* closed() noexcept
+            {
+                return reinterpret_cast<biased_merge_task*>(std::uintptr_t(1));
+            }
+
+            static void run_all(biased_merge_task* t) noexcept
+            {
+                while(t != nullptr)
+                {
+                    auto next = t->_next;
+                    t->run();
+                    t = next;
+                }
+            }
+
+        public:
+            void retain() noexcept
+            {
+                _refs.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            void release() noexcept
+            {
+                if(_refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                {
+                    delete this;
+                }
+            }
+
+            /// @brief Returns $false$ if the owner thread exited. The
+            /// caller then synchronizes with everything the owner did.
+            bool push(biased_merge_task& t) noexcept
+            {
+                auto h = _head.load(std::memory_order_acquire);
+
+                do
+                {
+                    if(h == closed()) return false;
+                    t._next = h;
+                } while(!_head.compare_exchange_weak(h, &t,
+                    std::memory_order_release, std::memory_order_acquire));
+
+                return true;
+            }
+
+            /// @brief Called by the owner thread.
+            void drain() noexcept
+            {
+                run_all(_head.exchange(nullptr, std::memory_order_acquire));
+            }
+
+            /// @brief Called by the owner thread when it exits.
+            void close() noexcept
+            {
+                run_all(_head.exchange(closed(), std::memory_order_acq_rel));
+            }
+        };
+
+        namespace biased_queue_impl
+        {
+            // Trivially destructible: still usable after the holder has been
+            // destroyed.
+            inline bool& destroyed() noexcept
+            {
+                thread_local bool d{false};
+                return d;
+            }
+
+            struct holder
+            {
+                biased_queue* _queue{nullptr};
+
+                ~holder()
+                {
+                    destroyed() = true;
+                    if(_queue == nullptr) return;
+
+                    _queue->close();
+                    _queue->release();
+                }
+            };
+
+            inline auto& local_holder() noexcept
+            {
+                thread_local holder h;
+                return h;
+            }
+
+            // Owns the counters created by exiting threads. Closed, and never
+            // deleted.
+            inline biased_queue& orphan_queue()
+            {
+                static biased_queue* q([]
+                    {
+                        auto result(new biased_queue);
+                        result->close();
+                        return result;
+                    }());
+
+                return *q;
+            }
+        }
+
+        /// @brief Queue of the calling thread, or $nullptr$ if the thread
+        /// never owned a biased counter or is exiting.
+        /// @details Objects with static storage duration, and thread-local
+        /// objects constructed before the queue, are destroyed after it:
+        /// their counters then behave as if the owner thread had exited.
+        inline biased_queue* current_biased_queue() noexcept
+        {
+            if(biased_queue_impl::destroyed()) return nullptr;
+            return biased_queue_impl::local_holder()._queue;
+        }
+
+        /// @brief Queue of the calling thread, created if needed. Counters
+        /// created while the thread is exiting get a closed queue.
+        inline biased_queue& local_biased_queue()
+        {
+            if(biased_queue_impl::destroyed())
+            {
+                return biased_queue_impl::orphan_queue();
+            }
+
+            auto& h(biased_queue_impl::local_holder());
+            if(h._queue == nullptr) h._queue = new biased_queue;
+
+            return *h._queue;
+        }
+
+        /// @brief Thread-safe counter biased towards its creating thread,
+        /// which updates its own part of the count without atomic
+        /// read-modify-write operations.
+        /// @details Other threads update an atomic $shared$ part, which
+        /// becomes negative when they destroy references created on the
+        /// owner thread. The parts are merged (and every thread uses the
+        /// $shared$ part from then on) when:
+        /// * The $biased$ part reaches zero.
+        /// * The $shared$ part first becomes negative: the count may have
+        /// reached zero, which only the owner can tell. The decrement
+        /// returns $deferred$, and the caller pushes a merge task to the
+        /// owner queue. The owner runs it in $merge_biased_references()$
+        /// or when it exits.
+        class biased_counter
+        {
+        private:
+            // The $shared$ part stores $count * 4 + queued + merged$.
+            static constexpr int merged_bit = 1;
+            static constexpr int queued_bit = 2;
+            static constexpr int flag_bits = merged_bit | queued_bit;
+            static constexpr int one = 4;
+
+            biased_queue& _owner;
+
+            // Only written by the owner thread: relaxed loads and stores are
+            // plain moves, but $count()$ can read it from any thread.
+            std::atomic<shared_counter_type> _biased;
+            bool _merged{false};
+
+            std::atomic<int> _shared{0};
+
+            static bool is_merged(int shared) noexcept
+            {
+                return (shared & merged_bit) != 0;
+            }
+
+            static int count_of(int shared) noexcept
+            {
+                return (shared - (shared & flag_bits)) / one;
+            }
+
+            bool on_owner_thread() const noexcept
+            {
+                return current_biased_queue() == &_owner;
+            }
+
+            // $_merged$ is only read by the owner thread.
+            bool on_fast_path() const noexcept
+            {
+                return on_owner_thread() && !_merged;
+            }
+
+            void add_biased(int n) noexcept
+            {
+                _biased.store(_biased.load(std::memory_order_relaxed) + n,
+                    std::memory_order_relaxed);
+            }
+
+        public:
+            static constexpr bool defers_release = true;
+
+            /// @brief The initial references belong to the calling thread.
+            explicit biased_counter(shared_counter_type count)
+                : _owner(local_biased_queue()), _biased{count}
+            {
+                assert(count > 0);
+                _owner.retain();
+            }
+
+            ~biased_counter()
+            {
+                _owner.release();
+            }
+
+            auto& owner_queue() noexcept
+            {
+                return _owner;
+            }
+
+            void increment() noexcept
+            {
+                if(on_fast_path())
+                {
+                    add_biased(1);
+                    return;
+                }
+
+                _shared.fetch_add(one, std::memory_order_relaxed);
+            }
+
+            release_result decrement() noexcept
+            {
+                if(on_fast_path())
+                {
+                    assert(_biased.load(std::memory_order_relaxed) > 0);
+                    add_biased(-1);
+
+                    if(_biased.load(std::memory_order_relaxed) != 0)
+                    {
+                        return release_result::alive;
+                    }
+
+                    return merge() ? release_result::last
+                                   : release_result::alive;
+                }
+
+                auto s = _shared.fetch_sub(one, std::memory_order_acq_rel) -
+                         one;
+
+                if(is_merged(s))
+                {
+                    return count_of(s) == 0 ? release_result::last
+                                            : release_result::alive;
+                }
+
+                // Not merged: the $biased$ part is positive, unless the
+                // owner is merging.
+                if(count_of(s) >= 0 || (s & queued_bit) != 0)
+                {
+                    return release_result::alive;
+                }
+
+                auto old = _shared.fetch_or(
+                    queued_bit, std::memory_order_relaxed);
+
+                return (old & queued_bit) != 0 ? release_result::alive
+                                               : release_result::deferred;
+            }
+
+            /// @brief Folds the $biased$ part into the $shared$ part. Called
+            /// by the owner thread, or by any thread once the owner exited.
+            /// Returns $true$ if the count reached zero.
+            bool merge() noexcept
+            {
+                auto owner = on_owner_thread();
+                if(owner && _merged) return false;
+
+                auto b = int(_biased.load(std::memory_order_relaxed));
+                auto s = _shared.load(std::memory_order_relaxed);
+
+                do
+                {
+                    // Another thread merged after the owner exited.
+                    if(is_merged(s)) return false;
+                } while(!_shared.compare_exchange_weak(s,
+                    s + b * one + merged_bit, std::memory_order_acq_rel,
+                    std::memory_order_relaxed));
+
+                if(owner) _merged = true;
+                return count_of(s) + b == 0;
+            }
+
+            bool try_increment() noexcept
+            {
+                // Not merged: the $biased$ part is positive. A count that
+                // reached zero was not merged yet, so the resource is still
+                // alive.
+                if(on_fast_path())
+                {
+                    add_biased(1);
+                    return true;
+                }
+
+                auto s = _shared.load(std::memory_order_relaxed);
+
+                do
+                {
+                    if(is_merged(s) && count_of(s) <= 0) return false;
+                } while(!_shared.compare_exchange_weak(
+                    s, s + one, std::memory_order_relaxed));
+
+                return true;
+            }
+
+            /// @brief Exact on the owner thread, approximate elsewhere.
+            auto count() const noexcept
+            {
+                auto s = _shared.load(std::memory_order_relaxed);
+                if(is_merged(s)) return shared_counter_type(count_of(s));
+
+                auto b = _biased.load(std::memory_order_relaxed);
+                return shared_counter_type(int(b) + count_of(s));
+            }
+        };
+
+        // Thread-safety policies.
+        // A policy selects the counters of the owner and weak counts.
+        namespace shared_lock_policy
+        {
+            /// @brief Non-thread-safe policy. No additional performance
+            /// overhead.
+            struct none
+            {
+                using owner_counter_type = plain_counter;
+                using weak_counter_type = plain_counter;
+            };
+
+            /// @brief Thread-safe policy: every count update is an atomic
+            /// read-modify-write.
+            struct atomic
+            {
+                using owner_counter_type = atomic_counter;
+                using weak_counter_type = atomic_counter;
+            };
+
+            /// @brief Thread-safe policy that avoids atomic operations on
+            /// the owner count while copies are made and destroyed on the
+            /// creating thread. Weak references are less frequent, and use
+            /// an atomic count.
+            struct biased
+            {
+                using owner_counter_type = biased_counter;
+                using weak_counter_type = atomic_counter;
+            };
+        }
+    }
+
+    /// @brief Deinitializes the $biased_shared$ resources created on the
+    /// calling thread whose last owner was destroyed on another thread.
+    /// @details Call it at safe points (e.g. once per frame) on threads that
+    /// create $biased_shared$ resources and share them. It also runs when
+    /// such a thread exits.
+    inline void merge_biased_references() noexcept
+    {
+        if(auto q = impl::current_biased_queue()) q->drain();
+    }
+}
@@ -6,24 +6,69 @@
 #pragma once
 
 #include "./shared.hpp"
+#include "./shared_lock_policy.hpp"
 
 namespace resource
 {
     namespace impl
     {
-        using shared_counter_type = unsigned int;
+        /// @brief Tag selecting the constructor of $shared$ that takes an
+        /// already allocated metadata instance.
+        struct adopt_metadata_t
+        {
+        };
+
+        constexpr adopt_metadata_t adopt_metadata{};
 
+        /// @brief Ownership metadata of a $shared$ resource.
+        /// @details As in $std::shared_ptr$, the owners collectively hold
+        /// one weak reference: the resource is deinitialized when the owner
+        /// count reaches zero, and the metadata is deallocated when the
+        /// weak count does. The counters are selected by $TLockPolicy$.
+        /// Metadata that is part of a larger block (see $shared_block$)
+        /// provides its own $block_functions$.
+        template <typename TLockPolicy>
         class shared_metadata
         {
+        public:
+            /// @brief Functions of metadata allocated in a larger block.
+            struct block_functions
+            {
+                // Destroys the resource stored in the block.
+                void (*_dispose)(shared_metadata&);
+
+                // Destroys the metadata and frees the block.
+                void (*_deallocate)(shared_metadata&);
+            };
+
         private:
-            shared_counter_type _owner_count;
-            shared_counter_type _weak_count;
+            using owner_counter_type =
+                typename TLockPolicy::owner_counter_type;
+
+            using weak_counter_type = typename TLockPolicy::weak_counter_type;
+
+            owner_counter_type _owner_count;
+            weak_counter_type _weak_count;
+
+            static auto to_release_result(bool last) noexcept
+            {
+                return last ? release_result::last : release_result::alive;
+            }
+
+            static auto to_release_result(release_result r) noexcept
+            {
+                return r;
+            }
+            // Null if the metadata was allocated on its own with $new$.
+            const block_functions* _block;
 
         public:
             shared_metadata(shared_counter_type owner_count,
-                shared_counter_type weak_count) noexcept
+                shared_counter_type weak_count,
+                const block_functions* block = nullptr)
                 : _owner_count{owner_count},
-                  _weak_count{weak_count}
+                  _weak_count{weak_count + (owner_count > 0 ? 1 : 0)},
+                  _block{block}
             {
             }
 
@@ -35,34 +80,80 @@ namespace resource
 
             void increment_owner() noexcept
             {
-                ++_owner_count;
+                _owner_count.increment();
             }
 
-            void decrement_owner() noexcept
+            static constexpr bool defers_release =
+                owner_counter_type::defers_release;
+
+            /// @brief Returns $last$ if the resource must be deinitialized.
+            release_result decrement_owner() noexcept
             {
-                assert(_owner_count > 0);
-                --_owner_count;
+                return to_release_result(_owner_count.decrement());
+            }
+
+            /// @brief Only available if $defers_release$: folds the parts
+            /// of the owner count, returning $true$ if it reached zero.
+            bool merge_owner() noexcept
+            {
+                return _owner_count.merge();
+            }
+
+            auto& owner_queue() noexcept
+            {
+                return _owner_count.owner_queue();
+            }
+
+            /// @brief Upgrades a weak reference. Fails if the resource was
+            /// already deinitialized.
+            bool try_increment_owner() noexcept
+            {
+                return _owner_count.try_increment();
             }
 
             void increment_weak() noexcept
             {
-                ++_weak_count;
+                _weak_count.increment();
             }
 
-            void decrement_weak() noexcept
+            /// @brief Returns $true$ if the metadata must be deallocated.
+            bool decrement_weak() noexcept
             {
-                assert(_weak_count > 0);
-                --_weak_count;
+                return _weak_count.decrement();
+            }
+
+            /// @brief Destroys a resource stored in the same block, returning
+            /// $false$ if the resource is deinitialized by its behavior.
+            bool dispose() noexcept
+            {
+                if(_block == nullptr) return false;
+
+                _block->_dispose(*this);
+                return true;
+            }
+
+            /// @brief Destroys the metadata and frees its memory.
+            void deallocate() noexcept
+            {
+                if(_block == nullptr)
+                {
+                    delete this;
+                    return;
+                }
+
+                _block->_deallocate(*this);
             }
 
             auto owner_count() const noexcept
             {
-                return _owner_count;
+                return _owner_count.count();
             }
 
             auto weak_count() const noexcept
             {
-                return _weak_count;
+                // Excludes the reference held by the owners.
+                auto owners = owner_count();
+                return _weak_count.count() - (owners > 0 ? 1 : 0);
             }
 
             auto total_count() const noexcept
@@ -76,4 +167,4 @@ namespace resource
             }
         };
     }
-}
\ No newline at end of file
+}
@@ -13,10 +13,14 @@ namespace resource
     namespace impl
     {
         // TODO: test polymorphism with custom shared_ptr
+        template <typename TLockPolicy>
         class shared_ref_counter
         {
+        public:
+            using metadata_type = shared_metadata<TLockPolicy>;
+
         private:
-            shared_metadata* _metadata{nullptr};
+            metadata_type* _metadata{nullptr};
 
             auto& access_metadata() noexcept
             {
@@ -50,34 +54,66 @@ namespace resource
                 access_metadata().increment_owner();
             }
 
-            void decrement_owner() noexcept
+            static void release_weak(metadata_type* metadata) noexcept
             {
-                access_metadata().decrement_owner();
+                if(metadata->decrement_weak())
+                {
+                    metadata->deallocate();
+                }
             }
 
-            void deallocate() noexcept
+            void lose_weak_reference() noexcept
             {
-                // TODO: total_count?
-
-                assert(access_metadata().owner_count() == 0);
-                delete _metadata;
+                release_weak(_metadata);
+                _metadata = nullptr;
             }
 
+            /// @brief Checks on the owner thread whether the owner count
+            /// reached zero. Holds a weak reference to the metadata.
             template <typename TF>
-            void deallocate_if_required(TF&& deleter) noexcept
+            class deferred_release : public biased_merge_task
             {
-                if(!has_any_ref())
+            private:
+                metadata_type* _metadata;
+                TF _deleter;
+
+            public:
+                deferred_release(metadata_type* metadata, TF deleter)
+                    : _metadata{metadata}, _deleter(std::move(deleter))
                 {
-                    deleter();
-                    deallocate();
                 }
 
-                _metadata = nullptr;
+                void run() noexcept override
+                {
+                    if(_metadata->merge_owner())
+                    {
+                        if(!_metadata->dispose()) _deleter();
+                        release_weak(_metadata);
+                    }
+
+                    release_weak(_metadata);
+                    delete this;
+                }
+            };
+
+            template <typename TF>
+            void defer_release(std::false_type, TF&&) noexcept
+            {
+                // Only counters with $defers_release$ return $deferred$.
+                assert(false);
             }
 
-            void decrement_weak() noexcept
+            template <typename TF>
+            void defer_release(std::true_type, TF&& deleter) noexcept
             {
-                access_metadata().decrement_weak();
+                access_metadata().increment_weak();
+
+                // TODO: could throw `std::bad_alloc`.
+                auto t = new deferred_release<std::decay_t<TF>>{
+                    _metadata, std::forward<TF>(deleter)};
+
+                // The owner thread exited: merge here.
+                if(!access_metadata().owner_queue().push(*t)) t->run();
             }
 
         public:
@@ -111,44 +147,79 @@ namespace resource
 
             auto use_count() const noexcept
             {
-                // TODO: owner count?
-
                 return is_null() ? 0 : owner_count();
             }
 
             void acquire_from_null()
             {
                 assert(is_null());
-                _metadata = new shared_metadata{1, 0};
+                _metadata = new metadata_type{1, 0};
                 // TODO: could throw `std::bad_alloc`.
             }
 
+            /// @brief Takes the ownership held by $metadata$, created with an
+            /// owner count of one.
+            void acquire_from_metadata(metadata_type* metadata) noexcept
+            {
+                assert(is_null());
+                _metadata = metadata;
+            }
+
             void acquire_existing() noexcept
             {
                 assert(!is_null());
                 increment_owner();
             }
 
+            /// @brief Acquires ownership from a weak reference. Returns
+            /// $false$ (and sets the counter to null) if the resource was
+            /// already deinitialized.
+            bool try_acquire_existing() noexcept
+            {
+                assert(!is_null());
+                if(access_metadata().try_increment_owner()) return true;
+
+                _metadata = nullptr;
+                return false;
+            }
+
             void increment_weak() noexcept
             {
                 access_metadata().increment_weak();
             }
 
-
-
+            /// @brief Calls $deleter$ if this was the last owner. The call
+            /// can be deferred to the thread owning the count.
             template <typename TF>
             void lose_ownership(TF&& deleter) noexcept
             {
-                decrement_owner();
-                deallocate_if_required(FWD(deleter));
+                switch(access_metadata().decrement_owner())
+                {
+                    case release_result::alive: break;
+
+                    case release_result::last:
+                        if(!access_metadata().dispose()) deleter();
+
+                        // The last owner releases the weak reference held
+                        // by the owners.
+                        lose_weak_reference();
+                        return;
+
+                    case release_result::deferred:
+                        defer_release(std::integral_constant<bool,
+                                          metadata_type::defers_release>{},
+                            std::forward<TF>(deleter));
+                        break;
+                }
+
+                _metadata = nullptr;
             }
 
-            template <typename TF>
-            void lose_weak(TF&& deleter)
+            void lose_weak() noexcept
             {
-                decrement_weak();
-                deallocate_if_required(FWD(deleter));
+                if(is_null()) return;
+                lose_weak_reference();
             }
         };
     }
-}
\ No newline at end of file
+}
@@ -8,6 +8,7 @@
 #pragma once
 
 #include "./shared.hpp"
+#include "./shared_lock_policy.hpp"
 #include "./shared_metadata.hpp"
 #include "./shared_ref_counter.hpp"
 #include "./resource_base.hpp"
@@ -23,18 +24,6 @@ namespace resource
         template <typename TBehavior, typename TLockPolicy>
         class weak;
 
-        // Thread-safety policies.
-        namespace shared_lock_policy
-        {
-            /// @brief Non-thread-safe policy. No additional performance
-            /// overhead.
-            struct none
-            {
-            };
-        
-            // TODO: other policies
-        }
-
         /// @brief Resource class with $shared$ ownership semantics.
         /// @details A thread-safety policy can be specified as a template
         /// parameter.
@@ -49,14 +38,15 @@ namespace resource
             using base_type = impl::resource_base<TBehavior>;
             using behavior_type = typename base_type::behavior_type;
             using handle_type = typename base_type::handle_type;
-            using ref_counter_type = impl::shared_ref_counter;
+            using ref_counter_type = impl::shared_ref_counter<TLockPolicy>;
             using lock_policy_type = TLockPolicy;
             using weak_type = weak<TBehavior, TLockPolicy>;
 
         private:
             // In addition to an handle, we store a $ref_counter$.
             // It is a class containing a pointer to an heap-allocated
-            // shared ownership metadata instance.
+            // shared ownership metadata instance, whose counters are
+            // selected by the lock policy.
             ref_counter_type _ref_counter;
 
             // Qualified $ref_counter$ access methods.
@@ -74,6 +64,11 @@ namespace resource
             ~shared() noexcept;
 
             explicit shared(const handle_type& handle) noexcept;
+
+            /// @brief Takes the ownership held by $metadata$, created with
+            /// an owner count of one for $handle$.
+            shared(adopt_metadata_t, const handle_type& handle,
+                typename ref_counter_type::metadata_type* metadata) noexcept;
             explicit shared(const weak_type& handle) noexcept;
 
             shared(const shared&);
@@ -105,6 +100,14 @@ namespace resource
 
     template <typename TBehavior>
     using shared = impl::shared<TBehavior, impl::shared_lock_policy::none>;
+
+    template <typename TBehavior>
+    using atomic_shared =
+        impl::shared<TBehavior, impl::shared_lock_policy::atomic>;
+
+    template <typename TBehavior>
+    using biased_shared =
+        impl::shared<TBehavior, impl::shared_lock_policy::biased>;
 }
 
 // TODO:
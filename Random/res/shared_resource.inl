@@ -111,14 +111,31 @@ namespace resource
             acquire_from_null_if_required();
         }
 
+        template <typename TBehavior, typename TLockPolicy>
+        shared<TBehavior, TLockPolicy>::shared(adopt_metadata_t,
+            const handle_type& handle,
+            typename ref_counter_type::metadata_type* metadata) noexcept
+            : base_type{handle}
+        {
+            // The metadata was allocated with the resource.
+            assert(!base_type::is_null_handle());
+            access_ref_counter().acquire_from_metadata(metadata);
+        }
+
         template <typename TBehavior, typename TLockPolicy>
         shared<TBehavior, TLockPolicy>::shared(const weak_type& rhs) noexcept
             : base_type{rhs._handle},
               _ref_counter{rhs._ref_counter}
         {
-            // If $handle$ is not null, we need to increment the shared 
-            // ownership counter.
-            acquire_existing_if_required();
+            // If $handle$ is not null, we need to increment the shared
+            // ownership counter - unless the resource was deinitialized in
+            // the meantime, in which case we end up null.
+            if(base_type::is_null_handle()) return;
+
+            if(!access_ref_counter().try_acquire_existing())
+            {
+                base_type::nullify();
+            }
         }
 
         template <typename TBehavior, typename TLockPolicy>
@@ -154,9 +171,11 @@ namespace resource
             // Decrement the ownership count from the metadata.
             // If the count reaches zero, the resource will be deinitialized.
             // The $ref_counter$ internal metadata pointer is set to $nullptr$.
-            access_ref_counter().lose_ownership([this]
+            // The handle is captured by value, as the deinitialization can
+            // be deferred to another thread by the $biased$ policy.
+            access_ref_counter().lose_ownership([h = this->_handle]
                 {
-                    base_type::deinit();
+                    deinit_handle<behavior_type>(h);
                 });
 
             // Sets the current handle to null, and asserts that $ref_counter$ 
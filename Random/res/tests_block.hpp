@@ -0,0 +1,188 @@
+// Copyright (c) 2013-2015 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#pragma once
+
+#include <stdexcept>
+#include <thread>
+#include "./shared.hpp"
+#include "./behavior.hpp"
+#include "./shared_resource.hpp"
+#include "./make_resource.hpp"
+#include "./weak.hpp"
+#include "./tests.hpp"
+
+namespace test
+{
+    int allocated{0};
+    int deallocated{0};
+
+    template <typename T>
+    struct counting_allocator
+    {
+        using value_type = T;
+
+        counting_allocator() = default;
+
+        template <typename TOther>
+        counting_allocator(const counting_allocator<TOther>&) noexcept
+        {
+        }
+
+        T* allocate(std::size_t n)
+        {
+            ++allocated;
+            return std::allocator<T>{}.allocate(n);
+        }
+
+        void deallocate(T* p, std::size_t n) noexcept
+        {
+            ++deallocated;
+            std::allocator<T>{}.deallocate(p, n);
+        }
+
+        template <typename TOther>
+        bool operator==(const counting_allocator<TOther>&) const noexcept
+        {
+            return true;
+        }
+
+        template <typename TOther>
+        bool operator!=(const counting_allocator<TOther>&) const noexcept
+        {
+            return false;
+        }
+    };
+
+    // Counts constructions and destructions in $created$ and $killed$.
+    struct payload
+    {
+        int _value;
+
+        payload(int value) : _value{value}
+        {
+            if(value < 0) throw std::runtime_error{"negative"};
+            ++created;
+        }
+
+        ~payload()
+        {
+            ++killed;
+        }
+    };
+
+    void assert_allocations(int a_allocated, int a_deallocated)
+    {
+        assert(allocated == a_allocated);
+        assert(deallocated == a_deallocated);
+    }
+
+    template <typename TLockPolicy = resource::impl::shared_lock_policy::none>
+    auto make_block_test(int value)
+    {
+        return allocate_shared_resource<payload, TLockPolicy>(
+            counting_allocator<payload>{}, value);
+    }
+
+    using block_weak_test = resource::impl::weak<
+        behavior::free_store_b<payload>,
+        resource::impl::shared_lock_policy::none>;
+
+    // One allocation, released with the last owner
+    void block_0()
+    {
+        allocated = deallocated = 0;
+        assert_ck(0, 0);
+
+        {
+            auto s0 = make_block_test(10);
+            assert_allocations(1, 0);
+            assert_ck(1, 0);
+            assert(s0.get()->_value == 10);
+
+            auto s1 = s0;
+            assert(s1.get() == s0.get());
+            assert(s0.use_count() == 2);
+            assert_allocations(1, 0);
+        }
+
+        assert_ck(1, 1);
+        assert_allocations(1, 1);
+    }
+
+    // Weak references keep the block alive, not the object
+    void block_1()
+    {
+        allocated = deallocated = 0;
+        assert_ck(0, 0);
+
+        {
+            block_weak_test w0;
+
+            {
+                auto s0 = make_block_test(10);
+                w0 = s0;
+
+                auto s1 = w0.lock();
+                assert(s1.get()->_value == 10);
+            }
+
+            assert_ck(1, 1);
+            assert_allocations(1, 0);
+
+            assert(w0.expired());
+            assert(!w0.lock());
+        }
+
+        assert_ck(1, 1);
+        assert_allocations(1, 1);
+    }
+
+    // Throwing constructor
+    void block_2()
+    {
+        allocated = deallocated = 0;
+        assert_ck(0, 0);
+
+        bool thrown{false};
+
+        try
+        {
+            make_block_test(-1);
+        }
+        catch(const std::runtime_error&)
+        {
+            thrown = true;
+        }
+
+        assert(thrown);
+        assert_ck(0, 0);
+        assert_allocations(1, 1);
+    }
+
+    // Last owner on another thread
+    template <typename TLockPolicy>
+    void block_3()
+    {
+        allocated = deallocated = 0;
+        assert_ck(0, 0);
+
+        {
+            auto s0 = make_block_test<TLockPolicy>(10);
+            std::thread t([s1 = s0]
+                {
+                    assert(s1.get()->_value == 10);
+                });
+
+            s0.reset();
+            t.join();
+
+            resource::merge_biased_references();
+            assert_ck(1, 1);
+        }
+
+        assert_allocations(1, 1);
+    }
+}
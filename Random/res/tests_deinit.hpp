@@ -0,0 +1,146 @@
+// Copyright (c) 2013-2015 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#pragma once
+
+#include <thread>
+#include <vector>
+#include "./shared.hpp"
+#include "./legacy.hpp"
+#include "./behavior.hpp"
+#include "./deinit_queue.hpp"
+#include "./unique_resource.hpp"
+#include "./shared_resource.hpp"
+#include "./weak.hpp"
+#include "./tests.hpp"
+
+namespace test
+{
+    void reset_legacy_counts()
+    {
+        legacy::glDeleteBuffers_calls = legacy::deleted_buffers = 0;
+        legacy::close_calls = legacy::closed_files = 0;
+    }
+
+    // Destroyed $unique$ buffers are deleted in one call
+    void deinit_0()
+    {
+        using vbo = behavior::vbo_batched_b;
+        reset_legacy_counts();
+
+        {
+            std::vector<resource::unique<vbo>> buffers;
+            for(int i = 0; i < 100; ++i) buffers.emplace_back(vbo::init(1));
+        }
+
+        assert(resource::pending_deinit_count<vbo>() == 100);
+        assert(legacy::glDeleteBuffers_calls == 0);
+
+        resource::flush_deinit<vbo>();
+        assert(resource::pending_deinit_count<vbo>() == 0);
+        assert(legacy::glDeleteBuffers_calls == 1);
+        assert(legacy::deleted_buffers == 100);
+
+        // Nothing to flush.
+        resource::flush_deinit<vbo>();
+        assert(legacy::glDeleteBuffers_calls == 1);
+
+        // The ids are copied in chunks: one call per chunk.
+        reset_legacy_counts();
+
+        {
+            std::vector<resource::unique<vbo>> buffers;
+            for(std::size_t i = 0; i < vbo::chunk_size * 2 + 1; ++i)
+                buffers.emplace_back(vbo::init(1));
+        }
+
+        resource::flush_deinit<vbo>();
+        assert(legacy::glDeleteBuffers_calls == 3);
+        assert(std::size_t(legacy::deleted_buffers) == vbo::chunk_size * 2 + 1);
+    }
+
+    // Only the last $shared$ owner queues its handle
+    void deinit_1()
+    {
+        using file = behavior::file_batched_b;
+        reset_legacy_counts();
+
+        {
+            resource::impl::weak<file, resource::impl::shared_lock_policy::none>
+                w0;
+
+            {
+                resource::shared<file> s0(file::init());
+                resource::shared<file> s1(file::init());
+                w0 = s0;
+
+                auto s2 = s0;
+                s0.reset();
+                assert(resource::pending_deinit_count<file>() == 0);
+            }
+
+            assert(w0.expired());
+            assert(resource::pending_deinit_count<file>() == 2);
+        }
+
+        assert(legacy::close_calls == 0);
+
+        resource::flush_deinit<file>();
+        assert(legacy::close_calls == 1);
+        assert(legacy::closed_files == 2);
+    }
+
+    // Queues are per-thread, and flushed when the thread exits
+    void deinit_2()
+    {
+        using vbo = behavior::vbo_batched_b;
+        reset_legacy_counts();
+
+        std::thread t([]
+            {
+                for(int i = 0; i < 10; ++i) resource::unique<vbo>{vbo::init(1)};
+            });
+
+        t.join();
+
+        assert(resource::pending_deinit_count<vbo>() == 0);
+        assert(legacy::glDeleteBuffers_calls == 1);
+        assert(legacy::deleted_buffers == 10);
+    }
+
+    // Behaviors without $deinit_batch$ deinitialize immediately
+    void deinit_3()
+    {
+        using vbo = behavior::vbo_b;
+        reset_legacy_counts();
+
+        {
+            resource::unique<vbo> u0(vbo::init(1));
+            resource::unique<vbo> u1(vbo::init(1));
+        }
+
+        assert(legacy::glDeleteBuffers_calls == 2);
+        assert(legacy::deleted_buffers == 2);
+    }
+
+    // Resources destroyed after the queue are deinitialized immediately
+    void deinit_4()
+    {
+        using vbo = behavior::vbo_batched_b;
+        reset_legacy_counts();
+
+        std::thread t([]
+            {
+                // Constructed before the queue: destroyed after it.
+                thread_local resource::unique<vbo> early(vbo::init(1));
+                resource::unique<vbo>{vbo::init(1)};
+            });
+
+        t.join();
+
+        assert(legacy::glDeleteBuffers_calls == 2);
+        assert(legacy::deleted_buffers == 2);
+    }
+}
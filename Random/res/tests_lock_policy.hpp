@@ -0,0 +1,199 @@
+// Copyright (c) 2013-2015 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#pragma once
+
+#include <thread>
+#include <vector>
+#include "./shared.hpp"
+#include "./legacy.hpp"
+#include "./behavior.hpp"
+#include "./unique_resource.hpp"
+#include "./shared_resource.hpp"
+#include "./weak.hpp"
+#include "./tests.hpp"
+
+namespace test
+{
+    namespace lp = resource::impl::shared_lock_policy;
+
+    template <typename TLockPolicy>
+    using policy_shared_test = resource::impl::shared<test_behavior, TLockPolicy>;
+
+    template <typename TLockPolicy>
+    using policy_weak_test = resource::impl::weak<test_behavior, TLockPolicy>;
+
+    // Copies on the creating thread
+    template <typename TLockPolicy>
+    void policy_0()
+    {
+        assert_ck(0, 0);
+
+        {
+            policy_shared_test<TLockPolicy> s0(test_behavior::init());
+            assert_ck(1, 0);
+
+            {
+                auto s1 = s0;
+                auto s2 = s1;
+                assert(s0.use_count() == 3);
+
+                s1.reset();
+                assert(s0.use_count() == 2);
+                assert_ck(1, 0);
+            }
+
+            assert(s0.unique());
+            assert_ck(1, 0);
+        }
+
+        assert_ck(1, 1);
+    }
+
+    // Weak references keep the metadata alive, not the resource
+    template <typename TLockPolicy>
+    void policy_1()
+    {
+        assert_ck(0, 0);
+
+        {
+            policy_weak_test<TLockPolicy> w0;
+
+            {
+                policy_shared_test<TLockPolicy> s0(test_behavior::init());
+                w0 = s0;
+
+                auto s1 = w0.lock();
+                assert(s1.get() == s0.get());
+                assert(s0.use_count() == 2);
+            }
+
+            assert_ck(1, 1);
+            assert(w0.expired());
+            assert(!w0.lock());
+        }
+
+        assert_ck(1, 1);
+    }
+
+    // Copies and destructions on other threads, last owner elsewhere
+    template <typename TLockPolicy>
+    void policy_2()
+    {
+        assert_ck(0, 0);
+
+        {
+            policy_shared_test<TLockPolicy> s0(test_behavior::init());
+            policy_weak_test<TLockPolicy> w0(s0);
+            std::vector<std::thread> threads;
+
+            for(int t = 0; t < 8; ++t)
+            {
+                threads.emplace_back([copy = s0, &w0]
+                    {
+                        for(int i = 0; i < 10000; ++i)
+                        {
+                            auto a = copy;
+                            auto b = w0.lock();
+                            assert(a && b);
+                        }
+                    });
+            }
+
+            // The threads own copies: the last one deinitializes the
+            // resource. With the $biased$ policy, the copies were counted
+            // by this thread, which has to merge the counts.
+            s0.reset();
+
+            for(auto& t : threads) t.join();
+            resource::merge_biased_references();
+            assert_ck(1, 1);
+            assert(w0.expired());
+        }
+
+        assert_ck(1, 1);
+    }
+
+    // Weak references upgraded while the last owner dies
+    template <typename TLockPolicy>
+    void policy_3()
+    {
+        for(int r = 0; r < 100; ++r)
+        {
+            created = killed = 0;
+
+            policy_shared_test<TLockPolicy> s0(test_behavior::init());
+            policy_weak_test<TLockPolicy> w0(s0);
+
+            std::thread t([&w0]
+                {
+                    for(int i = 0; i < 1000; ++i)
+                    {
+                        // Either null, or a valid owner.
+                        auto s = w0.lock();
+                        assert(!s || s.use_count() >= 1);
+                    }
+                });
+
+            s0.reset();
+            t.join();
+
+            assert_ck(1, 1);
+        }
+    }
+
+    // Owner thread exiting before the last owner
+    template <typename TLockPolicy>
+    void policy_4()
+    {
+        assert_ck(0, 0);
+
+        {
+            policy_shared_test<TLockPolicy> s0;
+            policy_shared_test<TLockPolicy> s1;
+
+            std::thread t([&s0, &s1]
+                {
+                    policy_shared_test<TLockPolicy> s(test_behavior::init());
+                    s0 = s;
+                    s1 = s;
+                });
+
+            t.join();
+            assert_ck(1, 0);
+
+            s0.reset();
+            assert_ck(1, 0);
+        }
+
+        assert_ck(1, 1);
+    }
+
+    // Owners destroyed after the owner thread's queue
+    template <typename TLockPolicy>
+    void policy_5()
+    {
+        created = killed = 0;
+
+        {
+            policy_shared_test<TLockPolicy> s0;
+
+            std::thread t([&s0]
+                {
+                    // Constructed before the queue: destroyed after it.
+                    thread_local policy_shared_test<TLockPolicy> early;
+                    early = policy_shared_test<TLockPolicy>(
+                        test_behavior::init());
+
+                    s0 = early;
+                });
+
+            t.join();
+            assert_ck(1, 0);
+        }
+
+        assert_ck(1, 1);
+    }
+}
@@ -17,6 +17,9 @@
 #include "./tests_unique.hpp"
 #include "./tests_shared.hpp"
 #include "./tests_weak.hpp"
+#include "./tests_lock_policy.hpp"
+#include "./tests_block.hpp"
+#include "./tests_deinit.hpp"
 
 namespace test
 {
@@ -56,6 +59,35 @@ namespace test
         RUN_T(weak_4);
         RUN_T(weak_5);
 
+        RUN_T(policy_0<lp::none>);
+        RUN_T(policy_1<lp::none>);
+
+        RUN_T(policy_0<lp::atomic>);
+        RUN_T(policy_1<lp::atomic>);
+        RUN_T(policy_2<lp::atomic>);
+        RUN_T(policy_3<lp::atomic>);
+        RUN_T(policy_4<lp::atomic>);
+        RUN_T(policy_5<lp::atomic>);
+
+        RUN_T(policy_0<lp::biased>);
+        RUN_T(policy_1<lp::biased>);
+        RUN_T(policy_2<lp::biased>);
+        RUN_T(policy_3<lp::biased>);
+        RUN_T(policy_4<lp::biased>);
+        RUN_T(policy_5<lp::biased>);
+
+        RUN_T(block_0);
+        RUN_T(block_1);
+        RUN_T(block_2);
+        RUN_T(block_3<lp::atomic>);
+        RUN_T(block_3<lp::biased>);
+
+        RUN_T(deinit_0);
+        RUN_T(deinit_1);
+        RUN_T(deinit_2);
+        RUN_T(deinit_3);
+        RUN_T(deinit_4);
+
 #undef RUN_T
     }
 }
\ No newline at end of file
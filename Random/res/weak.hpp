@@ -31,7 +31,7 @@ namespace resource
         public:
             using behavior_type = TBehavior;
             using handle_type = typename behavior_type::handle_type;
-            using ref_counter_type = impl::shared_ref_counter;
+            using ref_counter_type = impl::shared_ref_counter<TLockPolicy>;
             using lock_policy_type = TLockPolicy;
             using shared_type = shared<TBehavior, TLockPolicy>;
 
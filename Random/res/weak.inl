@@ -28,7 +28,7 @@ namespace resource
             : _handle{rhs._handle},
               _ref_counter{rhs._ref_counter}
         {
-            _ref_counter.increment_weak();
+            if(!_ref_counter.is_null()) _ref_counter.increment_weak();
         }
 
         template <typename TBehavior, typename TLockPolicy>
@@ -36,7 +36,7 @@ namespace resource
             : _handle{rhs._handle},
               _ref_counter{rhs._ref_counter}
         {
-            _ref_counter.increment_weak();
+            if(!_ref_counter.is_null()) _ref_counter.increment_weak();
         }
 
         template <typename TBehavior, typename TLockPolicy>
@@ -52,7 +52,7 @@ namespace resource
 
             _handle = rhs._handle;
             _ref_counter = rhs._ref_counter;
-            _ref_counter.increment_weak();
+            if(!_ref_counter.is_null()) _ref_counter.increment_weak();
 
             return *this;
         }
@@ -63,7 +63,7 @@ namespace resource
         {
             _handle = rhs._handle;
             _ref_counter = rhs._ref_counter;
-            _ref_counter.increment_weak();
+            if(!_ref_counter.is_null()) _ref_counter.increment_weak();
 
             return *this;
         }
@@ -92,10 +92,9 @@ namespace resource
         template <typename TBehavior, typename TLockPolicy>
         void weak<TBehavior, TLockPolicy>::reset() noexcept
         {
-            _ref_counter.lose_weak([this]
-                {
-                    behavior_type::deinit(_handle);
-                });
+            // The last owner deinitializes the resource: a weak reference
+            // only keeps the metadata alive.
+            _ref_counter.lose_weak();
 
             _handle = behavior_type::null_handle();
             _ref_counter = ref_counter_type{};
@@ -126,6 +125,8 @@ namespace resource
                 return shared_type{};
             }
 
+            // Can still end up null, if the last owner is concurrently
+            // destroyed.
             return shared_type{*this};
         }
     }
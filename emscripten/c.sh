@@ -11,6 +11,7 @@ sudo cp -R ./vrm/ /usr/local/include/
     --preload-file ./vrm/sdl/glsl/ \
     --profiling \
     -std=c++14 "${@:2}" \
+    -ffp-contract=off -fno-associative-math \
     -o ./build/"$1".html ./src/"$1".cpp \
 && (vblank_mode=0 __GL_SYNC_TO_VBLANK=0 chromium --disable-gpu-vsync http://localhost:8080/build/"$1".html)
 # && (vblank_mode=0 firefox http://localhost:8080/"$1".html)
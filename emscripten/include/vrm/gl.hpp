@@ -15,6 +15,7 @@
 #include <vrm/gl/index_type.hpp>
 #include <vrm/gl/vao.hpp>
 #include <vrm/gl/vbo.hpp>
+#include <vrm/gl/sync.hpp>
 #include <vrm/gl/fbo.hpp>
 #include <vrm/gl/attribute.hpp>
 #include <vrm/gl/uniform.hpp>
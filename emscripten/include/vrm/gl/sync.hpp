@@ -0,0 +1,107 @@
+// Copyright (c) 2015-2016 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#pragma once
+
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <vrm/gl/common.hpp>
+#include <vrm/gl/check.hpp>
+
+// Sync objects are core since OpenGL 3.2 and OpenGL ES 3.0: they are not
+// available with OpenGL ES 2 (WebGL).
+#ifdef GL_SYNC_GPU_COMMANDS_COMPLETE
+#define VRM_SDL_GL_HAS_FENCES 1
+#endif
+
+VRM_SDL_NAMESPACE
+{
+    namespace impl
+    {
+        // Checks the version of the current context, as the headers may
+        // declare sync objects that the context does not support.
+        bool fences_supported() noexcept
+        {
+#ifdef VRM_SDL_GL_HAS_FENCES
+            auto version(reinterpret_cast<const char*>(
+                glGetString(GL_VERSION)));
+
+            if(version == nullptr) return false;
+
+            bool es(std::strstr(version, "OpenGL ES") != nullptr);
+            while(*version != '\0' && !std::isdigit(*version)) ++version;
+
+            int major{0}, minor{0};
+            if(std::sscanf(version, "%d.%d", &major, &minor) != 2)
+                return false;
+
+            return es ? major >= 3 : major > 3 || (major == 3 && minor >= 2);
+#else
+            return false;
+#endif
+        }
+
+#ifdef VRM_SDL_GL_HAS_FENCES
+        class fence
+        {
+        private:
+            GLsync _sync{nullptr};
+
+        public:
+            fence() = default;
+
+            fence(const fence&) = delete;
+            fence& operator=(const fence&) = delete;
+
+            ~fence() noexcept { reset(); }
+
+            void reset() noexcept
+            {
+                if(_sync == nullptr) return;
+
+                VRM_SDL_GLCHECK(glDeleteSync(_sync));
+                _sync = nullptr;
+            }
+
+            // Signaled when the GPU completes the commands issued so far.
+            void place() noexcept
+            {
+                reset();
+                VRM_SDL_GLCHECK(
+                    _sync = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+            }
+
+            // Blocks until the fence is signaled, then removes it. Returns
+            // `true` if the CPU had to wait for the GPU.
+            bool wait() noexcept
+            {
+                if(_sync == nullptr) return false;
+
+                constexpr GLuint64 timeout_ns{1000000};
+                bool waited{false};
+                GLenum result;
+
+                VRM_SDL_GLCHECK(result = glClientWaitSync(
+                                    _sync, GL_SYNC_FLUSH_COMMANDS_BIT, 0));
+
+                while(result == GL_TIMEOUT_EXPIRED)
+                {
+                    waited = true;
+                    VRM_SDL_GLCHECK(
+                        result = glClientWaitSync(
+                            _sync, GL_SYNC_FLUSH_COMMANDS_BIT, timeout_ns));
+                }
+
+                VRM_CORE_ASSERT(result != GL_WAIT_FAILED);
+
+                reset();
+                return waited;
+            }
+        };
+#endif
+    }
+}
+VRM_SDL_NAMESPACE_END
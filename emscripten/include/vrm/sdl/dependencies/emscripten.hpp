@@ -15,6 +15,12 @@
 #define GL_GLEXT_PROTOTYPES 1
 #include <SDL_opengles2.h>
 
+// Threads are only available when building with `-s USE_PTHREADS=1`.
+#ifdef __EMSCRIPTEN_PTHREADS__
+#include <thread>
+#define VRM_SDL_HAS_THREADS 1
+#endif
+
 #define GLM_FORCE_RADIANS
 #define GLM_SWIZZLE
 #define GLM_FORCE_CXX14
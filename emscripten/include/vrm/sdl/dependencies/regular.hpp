@@ -18,6 +18,9 @@
 #define glBindVertexArrayOES glBindVertexArray
 #define glDeleteVertexArraysOES glDeleteVertexArrays
 
+#include <thread>
+#define VRM_SDL_HAS_THREADS 1
+
 #define GLM_FORCE_RADIANS
 #define GLM_SWIZZLE
 #define GLM_FORCE_CXX14
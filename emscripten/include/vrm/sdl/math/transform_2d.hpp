@@ -82,6 +82,31 @@ VRM_SDL_NAMESPACE
                 scaling_matrix_2d(size) *                     // .
                 shearing_matrix_2d(shear);
         }
+
+        // Columns of `trasform_matrix_2d` without shearing, computed
+        // directly: the skipped products only add exact zero terms, so the
+        // result is the same unless the compiler contracts to FMA or
+        // reassociates (see `SPRITE_VERTICES_FLAGS` in `CMakeLists.txt`).
+        struct affine_2d
+        {
+            vec2f x_axis, y_axis, translation;
+        };
+
+        VRM_SDL_ALWAYS_INLINE auto affine_transform_2d(const vec2f& position,
+            const vec2f& origin, const vec2f& size, float radians) noexcept
+        {
+            auto c(tbl_cos(radians));
+            auto s(tbl_sin(radians));
+            auto offset(origin - size * 0.5f);
+
+            return affine_2d{
+                // .
+                vec2f(c * size.x, s * size.x),  // .
+                vec2f(-s * size.y, c * size.y), // .
+                vec2f(c * offset.x + -s * offset.y + position.x,
+                    s * offset.x + c * offset.y + position.y) // .
+            };
+        }
     }
 }
 VRM_SDL_NAMESPACE_END
\ No newline at end of file
@@ -8,4 +8,5 @@
 #include <vrm/sdl/math.hpp>
 
 #include <vrm/sdl/utils/fixed_sparse_int_set.hpp>
-#include <vrm/sdl/utils/delegate.hpp>
\ No newline at end of file
+#include <vrm/sdl/utils/delegate.hpp>
+#include <vrm/sdl/utils/worker_pool.hpp>
\ No newline at end of file
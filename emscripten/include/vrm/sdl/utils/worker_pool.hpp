@@ -0,0 +1,165 @@
+// Copyright (c) 2015-2016 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#pragma once
+
+#include <vrm/sdl/common.hpp>
+
+#ifdef VRM_SDL_HAS_THREADS
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+VRM_SDL_NAMESPACE
+{
+    // Threads created once, that run the chunks of `run_chunks` calls
+    // together with the calling thread.
+    class worker_pool
+    {
+    private:
+        using chunk_fn_type = void (*)(const void*, sz_t);
+
+        std::vector<std::thread> _threads;
+        std::mutex _mutex;
+        std::condition_variable _work_cv;
+        std::condition_variable _done_cv;
+
+        // Job of the current `run_chunks` call. Guarded by `_mutex`.
+        chunk_fn_type _chunk_fn{nullptr};
+        const void* _chunk_ctx{nullptr};
+        sz_t _chunk_count{0};
+        sz_t _generation{0};
+        sz_t _pending{0};
+        bool _stop{false};
+
+        template <typename TF>
+        static void call_chunk(const void* ctx, sz_t chunk_idx) noexcept
+        {
+            (*static_cast<const TF*>(ctx))(chunk_idx);
+        }
+
+        // The worker `worker_idx` runs the chunk `worker_idx + 1`.
+        void work(sz_t worker_idx) noexcept
+        {
+            sz_t seen_generation{0};
+            std::unique_lock<std::mutex> lock(_mutex);
+
+            while(true)
+            {
+                _work_cv.wait(lock, [this, &seen_generation]
+                    {
+                        return _stop || _generation != seen_generation;
+                    });
+
+                if(_stop) return;
+                seen_generation = _generation;
+
+                auto chunk_idx(worker_idx + 1);
+                if(chunk_idx >= _chunk_count) continue;
+
+                auto chunk_fn(_chunk_fn);
+                auto chunk_ctx(_chunk_ctx);
+
+                lock.unlock();
+                chunk_fn(chunk_ctx, chunk_idx);
+                lock.lock();
+
+                if(--_pending == 0) _done_cv.notify_one();
+            }
+        }
+
+        void stop_and_join() noexcept
+        {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _stop = true;
+            }
+
+            _work_cv.notify_all();
+            for(auto& t : _threads) t.join();
+        }
+
+    public:
+        // Starts `thread_count` threads. If a thread cannot be started, the
+        // ones already started are joined before rethrowing.
+        worker_pool(sz_t thread_count)
+        {
+            _threads.reserve(thread_count);
+
+            try
+            {
+                for(sz_t i(0); i < thread_count; ++i)
+                {
+                    _threads.emplace_back([this, i]
+                        {
+                            work(i);
+                        });
+                }
+            }
+            catch(...)
+            {
+                stop_and_join();
+                throw;
+            }
+        }
+
+        worker_pool(const worker_pool&) = delete;
+        worker_pool& operator=(const worker_pool&) = delete;
+
+        ~worker_pool() noexcept { stop_and_join(); }
+
+        auto thread_count() const noexcept { return _threads.size(); }
+
+        // Calls `f(chunk_idx)` for every chunk in `[0, chunk_count)`, and
+        // returns when all of them are done. The calling thread runs the
+        // chunk `0`. `f` must not throw on the worker threads: exceptions
+        // thrown by the chunk `0` are rethrown after the others are done.
+        template <typename TF>
+        void run_chunks(sz_t chunk_count, const TF& f)
+        {
+            VRM_CORE_ASSERT(chunk_count <= thread_count() + 1);
+            if(chunk_count == 0) return;
+
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                VRM_CORE_ASSERT(_pending == 0);
+
+                _chunk_fn = &call_chunk<TF>;
+                _chunk_ctx = &f;
+                _chunk_count = chunk_count;
+                _pending = chunk_count - 1;
+                ++_generation;
+            }
+
+            _work_cv.notify_all();
+
+            auto wait_for_workers([this]
+                {
+                    std::unique_lock<std::mutex> lock(_mutex);
+                    _done_cv.wait(lock, [this]
+                        {
+                            return _pending == 0;
+                        });
+                });
+
+            try
+            {
+                f(sz_t(0));
+            }
+            catch(...)
+            {
+                wait_for_workers();
+                throw;
+            }
+
+            wait_for_workers();
+        }
+    };
+}
+VRM_SDL_NAMESPACE_END
+
+#endif
@@ -20,6 +20,7 @@ g++ -g3 -fno-omit-frame-pointer -lSDL2 -lSDL2_ttf -lSDL2_image -lSDL2_gfx -lGL -
     -Wsuggest-override \
     -Wsequence-point \
     -std=c++14 "${@:2}" \
+    -ffp-contract=off -fno-associative-math \
     -o ./build/"$1".x ./src/"$1".cpp \
 && vblank_mode=0 __GL_SYNC_TO_VBLANK=0 ./build/"$1".x 
 
@@ -14,6 +14,7 @@
 #include <random>
 #include <vrm/sdl.hpp>
 #include <vrm/gl.hpp>
+#include "./sprite_vertices.hpp"
 
 namespace sdl = vrm::sdl;
 
@@ -46,30 +47,6 @@ VRM_SDL_NAMESPACE
         };
     }
 
-    class quad_tex_coords
-    {
-    private:
-        vec2f _tx0; // (0.f, 1.f) (NE)
-        vec2f _tx1; // (0.f, 0.f) (NW)
-        vec2f _tx2; // (1.f, 0.f) (SE)
-        vec2f _tx3; // (1.f, 1.f) (SW)
-
-    public:
-        quad_tex_coords() = default;
-        quad_tex_coords(const vec2f& tx0, const vec2f& tx1, const vec2f& tx2,
-            const vec2f& tx3) noexcept : _tx0{tx0},
-                                         _tx1{tx1},
-                                         _tx2{tx2},
-                                         _tx3{tx3}
-        {
-        }
-
-        const auto& tx0() const noexcept { return _tx0; }
-        const auto& tx1() const noexcept { return _tx1; }
-        const auto& tx2() const noexcept { return _tx2; }
-        const auto& tx3() const noexcept { return _tx3; }
-    };
-
     namespace atlas_strategy
     {
         struct naive
@@ -305,33 +282,19 @@ VRM_SDL_NAMESPACE
 }
 VRM_SDL_NAMESPACE_END
 
-#define VRM_SDL_AUTO_VERTEX_ATTRIB_POINTER(                         \
-    attribute_handle, vertex_type, member_name, normalized)         \
-    do                                                              \
-    {                                                               \
-        attribute_handle.enable()                                   \
-            .vertex_attrib_pointer_in<vertex_type,                  \
-                decltype(std::declval<vertex_type>().member_name)>( \
-                normalized, offsetof(vertex_type, member_name));    \
+#define VRM_SDL_AUTO_VERTEX_ATTRIB_POINTER(                             \
+    attribute_handle, vertex_type, member_name, normalized, first_byte) \
+    do                                                                  \
+    {                                                                   \
+        attribute_handle.enable()                                       \
+            .vertex_attrib_pointer_in<vertex_type,                      \
+                decltype(std::declval<vertex_type>().member_name)>(     \
+                normalized,                                             \
+                (first_byte) + offsetof(vertex_type, member_name));     \
     } while(false)
 
 VRM_SDL_NAMESPACE
 {
-    struct bsr_vertex
-    {
-        vec4f _pos_tex_coords;
-        vec4f _color;
-        float _hue;
-
-        // Required to avoid temporary with `emplace_back`.
-        bsr_vertex(const vec4f& pos_tex_coords, const vec4f& color,
-            float hue) noexcept : _pos_tex_coords(pos_tex_coords),
-                                  _color(color),
-                                  _hue(hue)
-        {
-        }
-    };
-
     struct batched_sprite_renderer
     {
         using gl_index_type = GLuint;
@@ -339,18 +302,61 @@ VRM_SDL_NAMESPACE
         static constexpr sz_t vertex_count{batch_size * 4};
         static constexpr sz_t index_count{batch_size * 6};
 
+        // Every frame uploads its vertices to the next slot of the ring, so
+        // that the CPU never writes to a buffer the GPU may still be
+        // reading from.
+        static constexpr sz_t ring_size{3};
+
+        struct ring_slot
+        {
+            sdl::impl::unique_vao _vao;
+            sdl::impl::unique_vbo<buffer_target::array> _vbo;
+
+            // Number of vertices `_vbo` can hold: grows to fit the largest
+            // frame.
+            sz_t _capacity{0};
+
+#ifdef VRM_SDL_GL_HAS_FENCES
+            // Placed after the last draw call of the frame that reads from
+            // `_vbo`.
+            sdl::impl::fence _fence;
+#endif
+        };
+
         program _program{impl::make_batched_sprite_renderer_program()};
-        sdl::impl::unique_vao _vao;
 
-        sdl::impl::unique_vbo<buffer_target::array> _vbo0;
-        sdl::impl::unique_vbo<buffer_target::element_array> _vbo1;
+        std::array<ring_slot, ring_size> _ring;
+        sz_t _ring_idx{0};
+
+        // The indices are the same for every batch: `0, 1, 2, 0, 2, 3`,
+        // offset by `4` for every quad. They are uploaded once.
+        sdl::impl::unique_vbo<buffer_target::element_array> _ibo;
+
+        // Without sync objects, vertex buffers are orphaned before being
+        // written to.
+        bool _use_fences{false};
+
+        sdl::attribute _a_pos_tex_coords;
+        sdl::attribute _a_color;
+        sdl::attribute _a_hue;
 
         sdl::uniform _u_texture;
         sdl::uniform _u_projection_view;
 
         std::vector<bsr_vertex> _data;
-        std::vector<gl_index_type> _indices;
-        gl_index_type _current_batch_vertex_count{0};
+
+        // `draw_sprites` uses at most one thread per `sprites_per_worker`
+        // sprites.
+        static constexpr sz_t sprites_per_worker{1024 * 4};
+
+#ifdef VRM_SDL_HAS_THREADS
+        // Created by the first `draw_sprites` call that can use it.
+        std::unique_ptr<worker_pool> _workers;
+#endif
+
+        // Instrumentation of the last `do_it` call.
+        sz_t _frame_bytes_uploaded{0};
+        sz_t _frame_fence_waits{0};
 
         batched_sprite_renderer() noexcept
         {
@@ -360,44 +366,57 @@ VRM_SDL_NAMESPACE
 
         void init_render_data() noexcept
         {
-            _vao = sdl::make_vao();
-
-            // The VAO "contains" the VBOs.
-            _vao->bind();
-
-            _vbo0 = sdl::make_vbo<buffer_target::array>();
-            _vbo1 = sdl::make_vbo<buffer_target::element_array>();
+            _use_fences = impl::fences_supported();
 
             // Get attributes.
-            auto _a_pos_tex_coords = _program.attribute("a_pos_tex_coords");
-            auto _a_color = _program.attribute("a_color");
-            auto _a_hue = _program.attribute("a_hue");
+            _a_pos_tex_coords = _program.attribute("a_pos_tex_coords");
+            _a_color = _program.attribute("a_color");
+            _a_hue = _program.attribute("a_hue");
 
             // Get uniforms.
             _u_texture = _program.uniform("u_texture");
             _u_projection_view = _program.uniform("u_projection_view");
 
-            // Allocates enough memory for `vertex_count` `bsr_vertex`.
-            // Creates vertices VBO.
-            _data.reserve(vertex_count);
-            _vbo0->bind();
-            _vbo0->allocate_buffer_items<buffer_usage::dynamic_draw,
-                bsr_vertex>(vertex_count);
+            // Indices of `batch_size` quads.
+            std::vector<gl_index_type> indices;
+            indices.reserve(index_count);
 
-            // Allocates enough memory for `index_count` `gl_index_type`.
-            // Creates indices VBO.
-            _indices.reserve(index_count);
-            _vbo1->bind();
-            _vbo1->allocate_buffer_items<buffer_usage::dynamic_draw,
-                gl_index_type>(index_count);
+            for(sz_t i(0); i < batch_size; ++i)
+                for(auto x : {0, 1, 2, 0, 2, 3})
+                    indices.emplace_back(i * 4 + x);
 
-            VRM_SDL_AUTO_VERTEX_ATTRIB_POINTER(
-                _a_pos_tex_coords, bsr_vertex, _pos_tex_coords, true);
+            _data.reserve(vertex_count);
 
-            VRM_SDL_AUTO_VERTEX_ATTRIB_POINTER(
-                _a_color, bsr_vertex, _color, true);
+            for(auto& s : _ring)
+            {
+                // The VAO "contains" the VBOs.
+                s._vao = sdl::make_vao();
+                s._vao->bind();
+
+                // Allocates enough memory for `vertex_count` `bsr_vertex`.
+                s._vbo = sdl::make_vbo<buffer_target::array>();
+                s._vbo->bind();
+                s._vbo->allocate_buffer_items<buffer_usage::stream_draw,
+                    bsr_vertex>(vertex_count);
+                s._capacity = vertex_count;
+
+                // The element array binding is part of the VAO state: the
+                // indices VBO is created with the first VAO, and bound to
+                // the others.
+                if(&s == &_ring.front())
+                {
+                    _ibo = sdl::make_vbo<buffer_target::element_array>();
+                    _ibo->bind();
+                    _ibo->buffer_data_items<buffer_usage::static_draw>(
+                        indices);
+                }
+                else
+                {
+                    _ibo->bind();
+                }
 
-            VRM_SDL_AUTO_VERTEX_ATTRIB_POINTER(_a_hue, bsr_vertex, _hue, true);
+                point_attributes(0);
+            }
         }
 
         void use(const mat4f& projection_view) noexcept
@@ -412,28 +431,57 @@ VRM_SDL_NAMESPACE
         }
 
     private:
-        template <typename... Ts>
-        VRM_SDL_ALWAYS_INLINE void enqueue_v(Ts&&... xs) noexcept
+        // Points the attributes of the bound VAO to the vertices starting
+        // from `first_vertex`. The indices only address `batch_size` quads,
+        // and OpenGL ES 2 cannot offset them with a base vertex.
+        void point_attributes(sz_t first_vertex) noexcept
         {
-            _data.emplace_back(FWD(xs)...);
+            auto first_byte(first_vertex * sizeof(bsr_vertex));
+
+            VRM_SDL_AUTO_VERTEX_ATTRIB_POINTER(_a_pos_tex_coords, bsr_vertex,
+                _pos_tex_coords, true, first_byte);
+
+            VRM_SDL_AUTO_VERTEX_ATTRIB_POINTER(
+                _a_color, bsr_vertex, _color, true, first_byte);
+
+            VRM_SDL_AUTO_VERTEX_ATTRIB_POINTER(
+                _a_hue, bsr_vertex, _hue, true, first_byte);
         }
 
-        template <typename... Ts>
-        VRM_SDL_ALWAYS_INLINE void enqueue_i(Ts&&... xs) noexcept
+        // Uploads all the vertices of the frame to the bound slot `s`.
+        void upload_frame(ring_slot& s) noexcept
         {
-            vrmc::for_args(
-                [this](auto&& i)
-                {
-                    _indices.emplace_back(_current_batch_vertex_count + FWD(i));
-                },
-                FWD(xs)...);
+            auto vertices(_data.size());
 
-            _current_batch_vertex_count += 4;
-
-            if(_current_batch_vertex_count > vertex_count - 3)
+            if(vertices > s._capacity)
+            {
+                // Reallocating also orphans the old storage.
+                s._capacity = std::max(vertices, s._capacity * 2);
+                s._vbo->allocate_buffer_items<buffer_usage::stream_draw,
+                    bsr_vertex>(s._capacity);
+
+#ifdef VRM_SDL_GL_HAS_FENCES
+                s._fence.reset();
+#endif
+            }
+#ifdef VRM_SDL_GL_HAS_FENCES
+            else if(_use_fences)
+            {
+                // The slot was last drawn `ring_size` frames ago: the wait
+                // only blocks if the GPU is that far behind.
+                if(s._fence.wait()) ++_frame_fence_waits;
+            }
+#endif
+            else
             {
-                _current_batch_vertex_count = 0;
+                // Orphans the old storage: the driver can keep it alive for
+                // pending draws instead of waiting for them.
+                s._vbo->allocate_buffer_items<buffer_usage::stream_draw,
+                    bsr_vertex>(s._capacity);
             }
+
+            s._vbo->sub_buffer_data_items(_data, 0, vertices);
+            _frame_bytes_uploaded += vertices * sizeof(bsr_vertex);
         }
 
     public:
@@ -442,87 +490,113 @@ VRM_SDL_NAMESPACE
             const vec2f& origin, const vec2f& size, float radians,
             const vec4f& color, float hue) noexcept
         {
-            vec2f shear(0.f, 0.f);
+            auto offset(_data.size());
+            _data.resize(offset + 4);
+
+            impl::write_sprite_matrix(
+                sprite_desc{tex_coords, position, origin, size, radians,
+                    color, hue},
+                _data.data() + offset);
+        }
+
+        // Draws `count` sprites. Their vertices are generated in parallel,
+        // by the threads of `_workers`: every chunk of sprites is written to
+        // its own range of `_data`.
+        void draw_sprites(const impl::gltexture2d& /*t*/,
+            const sprite_desc* sprites, sz_t count)
+        {
+            auto offset(_data.size());
+            _data.resize(offset + count * 4);
+            auto out(_data.data() + offset);
+
+            auto write_range([sprites, out](sz_t begin, sz_t end)
+                {
+                    for(auto i(begin); i < end; ++i)
+                        impl::write_sprite_affine(sprites[i], out + i * 4);
+                });
+
+#ifdef VRM_SDL_HAS_THREADS
+            auto chunk_count(count / sprites_per_worker);
+
+            if(chunk_count > 1)
+            {
+                if(_workers == nullptr)
+                {
+                    sz_t thread_count(std::thread::hardware_concurrency());
+                    if(thread_count > 0) --thread_count;
 
-            const vec3f pos0(0.f, 1.f, 1.f);
-            const vec3f pos1(0.f, 0.f, 1.f);
-            const vec3f pos2(1.f, 0.f, 1.f);
-            const vec3f pos3(1.f, 1.f, 1.f);
+                    _workers = std::make_unique<worker_pool>(thread_count);
+                }
 
-            auto transform(impl::trasform_matrix_2d(
-                position, origin, size, radians, shear));
+                chunk_count =
+                    std::min(chunk_count, _workers->thread_count() + 1);
+                auto chunk((count + chunk_count - 1) / chunk_count);
 
-            vec3f comp0(transform * pos0);
-            vec3f comp1(transform * pos1);
-            vec3f comp2(transform * pos2);
-            vec3f comp3(transform * pos3);
+                _workers->run_chunks(chunk_count, [&](sz_t chunk_idx)
+                    {
+                        write_range(chunk_idx * chunk,
+                            std::min(count, (chunk_idx + 1) * chunk));
+                    });
 
-            // TODO: "pixel_perfect" parameter or something like that
-            vec4f pos_tex_coords_0(vec2i(comp0.xy()), tex_coords.tx2());
-            vec4f pos_tex_coords_1(vec2i(comp1.xy()), tex_coords.tx0());
-            vec4f pos_tex_coords_2(vec2i(comp2.xy()), tex_coords.tx1());
-            vec4f pos_tex_coords_3(vec2i(comp3.xy()), tex_coords.tx3());
+                return;
+            }
+#endif
 
-            enqueue_v(pos_tex_coords_0, color, hue);
-            enqueue_v(pos_tex_coords_1, color, hue);
-            enqueue_v(pos_tex_coords_2, color, hue);
-            enqueue_v(pos_tex_coords_3, color, hue);
+            write_range(0, count);
+        }
 
-            enqueue_i(0, 1, 2, 0, 2, 3);
+        void draw_sprites(const impl::gltexture2d& t,
+            const std::vector<sprite_desc>& sprites)
+        {
+            draw_sprites(t, sprites.data(), sprites.size());
         }
 
         void do_it()
         {
-            _vao->bind();
-
             // TODO:
             _u_texture.integer(0);
 
-            auto times(_data.size() / vertex_count);
+            _frame_bytes_uploaded = 0;
+            _frame_fence_waits = 0;
 
-            for(decltype(times) i(0); i < times; ++i)
-            {
-                // Send `vertex_count` vertices to GPU, from
-                // `_data[vertex_count * i]`.
-                _vbo0->sub_buffer_data_items(
-                    _data, vertex_count * i, vertex_count);
-
-                // Send `index_count` vertices to GPU, from
-                // `_indices[index_count * i]`.
-                _vbo1->sub_buffer_data_items(
-                    _indices, index_count * i, index_count);
-
-                _vao->draw_elements<primitive::triangles, index_type::ui_int>(
-                    index_count);
-            }
+            if(_data.empty()) return;
+
+            auto& s(_ring[_ring_idx]);
+            _ring_idx = (_ring_idx + 1) % ring_size;
+
+            s._vao->bind();
+            s._vbo->bind();
+            upload_frame(s);
 
+            // Every batch is drawn from its own range of the slot.
             auto total_quad_count(_data.size() / 4);
-            auto rest_quad_count(total_quad_count % batch_size);
 
-            if(rest_quad_count > 0)
+            for(sz_t i(0); i < total_quad_count; i += batch_size)
             {
-                auto rest_offset_count(times * batch_size);
-                auto rest_offset_count_vertex(rest_offset_count * 4);
-                auto rest_offset_count_indices(rest_offset_count * 6);
-                auto rest_vertex_count(rest_quad_count * 4);
-                auto rest_index_count(rest_quad_count * 6);
-
-                // Send `vertex_count` vertices to GPU.
-                _vbo0->sub_buffer_data_items(
-                    _data, rest_offset_count_vertex, rest_vertex_count);
-
-                // Send `index_count` vertices to GPU.
-                _vbo1->sub_buffer_data_items(
-                    _indices, rest_offset_count_indices, rest_index_count);
-
-                _vao->draw_elements<primitive::triangles, index_type::ui_int>(
-                    rest_index_count);
+                auto quad_count(total_quad_count - i);
+                if(quad_count > batch_size) quad_count = batch_size;
+
+                point_attributes(i * 4);
+                s._vao->draw_elements<primitive::triangles,
+                    index_type::ui_int>(quad_count * 6);
             }
 
+#ifdef VRM_SDL_GL_HAS_FENCES
+            if(_use_fences) s._fence.place();
+#endif
+
             _data.clear();
-            _indices.clear();
-            _current_batch_vertex_count = 0;
         }
+
+        // Bytes of vertex data sent to the GPU by the last `do_it` call.
+        auto frame_bytes_uploaded() const noexcept
+        {
+            return _frame_bytes_uploaded;
+        }
+
+        // Number of times the last `do_it` call waited for the GPU to finish
+        // reading a vertex buffer. Always `0` without sync objects.
+        auto frame_fence_waits() const noexcept { return _frame_fence_waits; }
     };
 }
 VRM_SDL_NAMESPACE_END
@@ -732,6 +806,7 @@ struct my_game
     engine_type& _engine;
 
     sdl::batched_sprite_renderer sr;
+    std::vector<sdl::sprite_desc> _sprite_descs;
 
     sdl::atlas _atlas;
 
@@ -835,11 +910,11 @@ struct my_game
     }
 
 
-    auto sprite_draw(const entity_type& x)
+    auto make_sprite_desc(const entity_type& x)
     {
-        sr.draw_sprite(*_atlas.texture(), texture_coords(x.type), x._pos,
-            x._origin, x._size, x._radians,
-            sdl::vec4f{1.f, 0.f, 1.f, x._opacity}, x.hue);
+        return sdl::sprite_desc{texture_coords(x.type), x._pos, x._origin,
+            x._size, x._radians, sdl::vec4f{1.f, 0.f, 1.f, x._opacity},
+            x.hue};
     }
 
     auto make_toriel(game_state_type& /*state*/, sdl::vec2f pos)
@@ -937,10 +1012,12 @@ struct my_game
                 std::to_string(static_cast<int>(_context.fps_limit)));
             auto update_ms_str(std::to_string(_context.update_ms()));
             auto draw_ms_str(std::to_string(_context.draw_ms()));
+            auto upload_kb_str(
+                std::to_string(sr.frame_bytes_uploaded() / 1024));
 
             _context.title(alive_str + " |\tFPS: " + fps_str + "/" +
                            fps_limit_str + "\tU: " + update_ms_str + "\tD: " +
-                           draw_ms_str);
+                           draw_ms_str + "\tUP: " + upload_kb_str + " KB");
         }
 
 
@@ -967,15 +1044,17 @@ struct my_game
         // this->texture(e_type::fireball)->activate_and_bind(GL_TEXTURE0);
         _atlas.texture()->activate_and_bind(GL_TEXTURE0);
 
+        _sprite_descs.clear();
         state.for_alive([this](const auto& e)
             {
                 // TODO: slow
                 // this->texture(e.type)->activate_and_bind(GL_TEXTURE0);
                 // ----------
 
-                this->sprite_draw(e);
+                _sprite_descs.emplace_back(this->make_sprite_desc(e));
             });
 
+        sr.draw_sprites(*_atlas.texture(), _sprite_descs);
 
         sr.do_it();
 
@@ -0,0 +1,120 @@
+// Copyright (c) 2015-2016 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#pragma once
+
+#include <vrm/sdl/math.hpp>
+
+VRM_SDL_NAMESPACE
+{
+    class quad_tex_coords
+    {
+    private:
+        vec2f _tx0; // (0.f, 1.f) (NE)
+        vec2f _tx1; // (0.f, 0.f) (NW)
+        vec2f _tx2; // (1.f, 0.f) (SE)
+        vec2f _tx3; // (1.f, 1.f) (SW)
+
+    public:
+        quad_tex_coords() = default;
+        quad_tex_coords(const vec2f& tx0, const vec2f& tx1, const vec2f& tx2,
+            const vec2f& tx3) noexcept : _tx0{tx0},
+                                         _tx1{tx1},
+                                         _tx2{tx2},
+                                         _tx3{tx3}
+        {
+        }
+
+        const auto& tx0() const noexcept { return _tx0; }
+        const auto& tx1() const noexcept { return _tx1; }
+        const auto& tx2() const noexcept { return _tx2; }
+        const auto& tx3() const noexcept { return _tx3; }
+    };
+
+    struct bsr_vertex
+    {
+        vec4f _pos_tex_coords;
+        vec4f _color;
+        float _hue;
+
+        bsr_vertex() = default;
+
+        bsr_vertex(const vec4f& pos_tex_coords, const vec4f& color,
+            float hue) noexcept : _pos_tex_coords(pos_tex_coords),
+                                  _color(color),
+                                  _hue(hue)
+        {
+        }
+    };
+
+    // Arguments of `batched_sprite_renderer::draw_sprite`, for
+    // `batched_sprite_renderer::draw_sprites`.
+    struct sprite_desc
+    {
+        quad_tex_coords tex_coords;
+        vec2f position, origin, size;
+        float radians;
+        vec4f color;
+        float hue;
+    };
+
+    namespace impl
+    {
+        // Writes the four vertices of `d` to `out`: the transforms of
+        // `(0, 1)`, `(0, 0)`, `(1, 0)` and `(1, 1)`, computed with
+        // matrix-vector products. Used by `draw_sprite`.
+        VRM_SDL_ALWAYS_INLINE void write_sprite_matrix(
+            const sprite_desc& d, bsr_vertex* out) noexcept
+        {
+            vec2f shear(0.f, 0.f);
+
+            const vec3f pos0(0.f, 1.f, 1.f);
+            const vec3f pos1(0.f, 0.f, 1.f);
+            const vec3f pos2(1.f, 0.f, 1.f);
+            const vec3f pos3(1.f, 1.f, 1.f);
+
+            auto transform(trasform_matrix_2d(
+                d.position, d.origin, d.size, d.radians, shear));
+
+            vec3f comp0(transform * pos0);
+            vec3f comp1(transform * pos1);
+            vec3f comp2(transform * pos2);
+            vec3f comp3(transform * pos3);
+
+            // TODO: "pixel_perfect" parameter or something like that
+            const auto& tc(d.tex_coords);
+            out[0] = bsr_vertex(
+                vec4f(vec2i(comp0.xy()), tc.tx2()), d.color, d.hue);
+            out[1] = bsr_vertex(
+                vec4f(vec2i(comp1.xy()), tc.tx0()), d.color, d.hue);
+            out[2] = bsr_vertex(
+                vec4f(vec2i(comp2.xy()), tc.tx1()), d.color, d.hue);
+            out[3] = bsr_vertex(
+                vec4f(vec2i(comp3.xy()), tc.tx3()), d.color, d.hue);
+        }
+
+        // Writes the same vertices as `write_sprite_matrix`, using the
+        // columns of the transform instead of four matrix-vector products.
+        // Used by `draw_sprites`.
+        VRM_SDL_ALWAYS_INLINE void write_sprite_affine(
+            const sprite_desc& d, bsr_vertex* out) noexcept
+        {
+            auto t(affine_transform_2d(
+                d.position, d.origin, d.size, d.radians));
+
+            vec2f comp0(t.y_axis + t.translation);
+            vec2f comp1(t.translation);
+            vec2f comp2(t.x_axis + t.translation);
+            vec2f comp3(t.x_axis + t.y_axis + t.translation);
+
+            const auto& tc(d.tex_coords);
+            out[0] = bsr_vertex(vec4f(vec2i(comp0), tc.tx2()), d.color, d.hue);
+            out[1] = bsr_vertex(vec4f(vec2i(comp1), tc.tx0()), d.color, d.hue);
+            out[2] = bsr_vertex(vec4f(vec2i(comp2), tc.tx1()), d.color, d.hue);
+            out[3] = bsr_vertex(vec4f(vec2i(comp3), tc.tx3()), d.color, d.hue);
+        }
+    }
+}
+VRM_SDL_NAMESPACE_END
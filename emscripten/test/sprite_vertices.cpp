@@ -0,0 +1,78 @@
+// Copyright (c) 2015-2016 Vittorio Romeo
+// License: Academic Free License ("AFL") v. 3.0
+// AFL License page: http://opensource.org/licenses/AFL-3.0
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+#include "../src/sprite_vertices.hpp"
+
+// Checks that the vertices written by `draw_sprites` (affine path) are
+// byte for byte the ones written by `draw_sprite` (matrix path). Needs no
+// window or GL context. Built with the renderer's `-ffp-contract=off
+// -fno-associative-math`: FMA contraction or reassociation (e.g. with
+// `-ffast-math`) rounds the two paths differently.
+
+using namespace vrm::sdl;
+
+int main()
+{
+    std::vector<sprite_desc> sprites;
+
+    std::minstd_rand rng{1234u};
+    auto rnd([&rng](float min, float max)
+        {
+            return std::uniform_real_distribution<float>{min, max}(rng);
+        });
+
+    auto rnd_vec2f([&rnd](float min, float max)
+        {
+            return vec2f(rnd(min, max), rnd(min, max));
+        });
+
+    for(int i = 0; i < 100000; ++i)
+    {
+        sprites.emplace_back(sprite_desc{
+            quad_tex_coords{rnd_vec2f(0.f, 1.f), rnd_vec2f(0.f, 1.f),
+                rnd_vec2f(0.f, 1.f), rnd_vec2f(0.f, 1.f)},
+            rnd_vec2f(-2000.f, 2000.f), rnd_vec2f(-50.f, 50.f),
+            rnd_vec2f(0.f, 300.f), rnd(0.f, 6.28f),
+            vec4f(rnd(0.f, 1.f), rnd(0.f, 1.f), rnd(0.f, 1.f), 1.f),
+            rnd(0.f, 1.f)});
+    }
+
+    // Integer-aligned results, zero sizes, and angles on the axes.
+    for(auto radians : {0.f, 1.5707964f, 3.1415927f})
+        for(auto size : {0.f, 1.f, 32.f})
+        {
+            sprites.emplace_back(sprite_desc{quad_tex_coords{},
+                vec2f(10.f, 20.f), vec2f(16.f, 16.f), vec2f(size, size),
+                radians, vec4f(1.f, 1.f, 1.f, 1.f), 0.f});
+        }
+
+    std::vector<bsr_vertex> expected(4), actual(4);
+    int mismatches{0};
+
+    for(const auto& d : sprites)
+    {
+        impl::write_sprite_matrix(d, expected.data());
+        impl::write_sprite_affine(d, actual.data());
+
+        if(std::memcmp(expected.data(), actual.data(),
+               4 * sizeof(bsr_vertex)) != 0)
+        {
+            ++mismatches;
+        }
+    }
+
+    if(mismatches != 0)
+    {
+        std::printf("%d of %zu sprites differ\n", mismatches, sprites.size());
+        return 1;
+    }
+
+    std::printf("ok\n");
+    return 0;
+}
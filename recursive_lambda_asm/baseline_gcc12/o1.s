@@ -0,0 +1,15 @@
+	.file	"baseline.cpp"
+	.text
+	.globl	main
+	.type	main, @function
+main:
+.LFB1835:
+	.cfi_startproc
+	movl	$720, -4(%rsp)
+	movl	$0, %eax
+	ret
+	.cfi_endproc
+.LFE1835:
+	.size	main, .-main
+	.ident	"GCC: (Debian 12.2.0-14+deb12u1) 12.2.0"
+	.section	.note.GNU-stack,"",@progbits
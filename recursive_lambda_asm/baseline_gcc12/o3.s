@@ -0,0 +1,17 @@
+	.file	"baseline.cpp"
+	.text
+	.section	.text.startup,"ax",@progbits
+	.p2align 4
+	.globl	main
+	.type	main, @function
+main:
+.LFB1835:
+	.cfi_startproc
+	movl	$720, -4(%rsp)
+	xorl	%eax, %eax
+	ret
+	.cfi_endproc
+.LFE1835:
+	.size	main, .-main
+	.ident	"GCC: (Debian 12.2.0-14+deb12u1) 12.2.0"
+	.section	.note.GNU-stack,"",@progbits
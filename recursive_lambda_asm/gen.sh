@@ -0,0 +1,32 @@
+#!/bin/bash
+# Generates the assembly listings of every variant with `$CXX` in
+# `<variant>_<suffix>/`, then prints their sizes.
+# Usage: CXX=g++ ./gen.sh gcc12
+
+set -e
+
+CXX=${CXX:-g++}
+SUFFIX=${1:-gcc}
+FLAGS="-std=c++14 -S -DNDEBUG $EXTRA_FLAGS"
+
+declare -A VARIANTS=(
+    [baseline]="baseline.cpp"
+    [yc]="x.cpp -DUSE_YCOMBINATOR"
+    [stdfn]="x.cpp"
+    [inplace]="x.cpp -DUSE_INPLACE_FUNCTION"
+)
+
+declare -A LEVELS=([o1]=-O1 [o2]=-O2 [o3]=-O3 [ofast]=-Ofast)
+
+for v in baseline yc stdfn inplace; do
+    mkdir -p "${v}_${SUFFIX}"
+
+    for l in o1 o2 o3 ofast; do
+        $CXX $FLAGS ${LEVELS[$l]} ${VARIANTS[$v]} -o "${v}_${SUFFIX}/$l.s"
+    done
+done
+
+for l in o1 o2 o3 ofast; do
+    wc -c ./*_"${SUFFIX}/$l.s"
+    echo
+done
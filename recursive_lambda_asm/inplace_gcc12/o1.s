@@ -0,0 +1,209 @@
+	.file	"x.cpp"
+	.text
+	.type	_ZZN6vtable4impl5makerIFiiEE6set_fpIZ4mainEUliE_N5boost4hana6detail8map_implINS8_10hash_tableIJNS8_6bucketINS7_17integral_constantIxLx0EEEJLm0EEEENSB_INSC_IxLx1EEEJLm1EEEENSB_INSC_IxLx3EEEJLm2EEEEEEENS7_11basic_tupleIJNS7_4pairINSC_IiLi0EEEPFiPciEEENSL_INSC_IiLi1EEEPFvSN_EEENSL_INSC_IiLi3EEEPFvSN_SN_EEEEEEEEEEvSR_RT0_ENUlSN_E_4_FUNESN_, @function
+_ZZN6vtable4impl5makerIFiiEE6set_fpIZ4mainEUliE_N5boost4hana6detail8map_implINS8_10hash_tableIJNS8_6bucketINS7_17integral_constantIxLx0EEEJLm0EEEENSB_INSC_IxLx1EEEJLm1EEEENSB_INSC_IxLx3EEEJLm2EEEEEEENS7_11basic_tupleIJNS7_4pairINSC_IiLi0EEEPFiPciEEENSL_INSC_IiLi1EEEPFvSN_EEENSL_INSC_IiLi3EEEPFvSN_SN_EEEEEEEEEEvSR_RT0_ENUlSN_E_4_FUNESN_:
+.LFB6649:
+	.cfi_startproc
+	ret
+	.cfi_endproc
+.LFE6649:
+	.size	_ZZN6vtable4impl5makerIFiiEE6set_fpIZ4mainEUliE_N5boost4hana6detail8map_implINS8_10hash_tableIJNS8_6bucketINS7_17integral_constantIxLx0EEEJLm0EEEENSB_INSC_IxLx1EEEJLm1EEEENSB_INSC_IxLx3EEEJLm2EEEEEEENS7_11basic_tupleIJNS7_4pairINSC_IiLi0EEEPFiPciEEENSL_INSC_IiLi1EEEPFvSN_EEENSL_INSC_IiLi3EEEPFvSN_SN_EEEEEEEEEEvSR_RT0_ENUlSN_E_4_FUNESN_, .-_ZZN6vtable4impl5makerIFiiEE6set_fpIZ4mainEUliE_N5boost4hana6detail8map_implINS8_10hash_tableIJNS8_6bucketINS7_17integral_constantIxLx0EEEJLm0EEEENSB_INSC_IxLx1EEEJLm1EEEENSB_INSC_IxLx3EEEJLm2EEEEEEENS7_11basic_tupleIJNS7_4pairINSC_IiLi0EEEPFiPciEEENSL_INSC_IiLi1EEEPFvSN_EEENSL_INSC_IiLi3EEEPFvSN_SN_EEEEEEEEEEvSR_RT0_ENUlSN_E_4_FUNESN_
+	.type	_ZZN6vtable4impl5makerIFiiEE6set_fpIZ4mainEUliE_N5boost4hana6detail8map_implINS8_10hash_tableIJNS8_6bucketINS7_17integral_constantIxLx0EEEJLm0EEEENSB_INSC_IxLx1EEEJLm1EEEENSB_INSC_IxLx3EEEJLm2EEEEEEENS7_11basic_tupleIJNS7_4pairINSC_IiLi0EEEPFiPciEEENSL_INSC_IiLi1EEEPFvSN_EEENSL_INSC_IiLi3EEEPFvSN_SN_EEEEEEEEEEvSV_RT0_ENUlSN_SN_E_4_FUNESN_SN_, @function
+_ZZN6vtable4impl5makerIFiiEE6set_fpIZ4mainEUliE_N5boost4hana6detail8map_implINS8_10hash_tableIJNS8_6bucketINS7_17integral_constantIxLx0EEEJLm0EEEENSB_INSC_IxLx1EEEJLm1EEEENSB_INSC_IxLx3EEEJLm2EEEEEEENS7_11basic_tupleIJNS7_4pairINSC_IiLi0EEEPFiPciEEENSL_INSC_IiLi1EEEPFvSN_EEENSL_INSC_IiLi3EEEPFvSN_SN_EEEEEEEEEEvSV_RT0_ENUlSN_SN_E_4_FUNESN_SN_:
+.LFB6662:
+	.cfi_startproc
+	movq	(%rdi), %rax
+	movq	%rax, (%rsi)
+	ret
+	.cfi_endproc
+.LFE6662:
+	.size	_ZZN6vtable4impl5makerIFiiEE6set_fpIZ4mainEUliE_N5boost4hana6detail8map_implINS8_10hash_tableIJNS8_6bucketINS7_17integral_constantIxLx0EEEJLm0EEEENSB_INSC_IxLx1EEEJLm1EEEENSB_INSC_IxLx3EEEJLm2EEEEEEENS7_11basic_tupleIJNS7_4pairINSC_IiLi0EEEPFiPciEEENSL_INSC_IiLi1EEEPFvSN_EEENSL_INSC_IiLi3EEEPFvSN_SN_EEEEEEEEEEvSV_RT0_ENUlSN_SN_E_4_FUNESN_SN_, .-_ZZN6vtable4impl5makerIFiiEE6set_fpIZ4mainEUliE_N5boost4hana6detail8map_implINS8_10hash_tableIJNS8_6bucketINS7_17integral_constantIxLx0EEEJLm0EEEENSB_INSC_IxLx1EEEJLm1EEEENSB_INSC_IxLx3EEEJLm2EEEEEEENS7_11basic_tupleIJNS7_4pairINSC_IiLi0EEEPFiPciEEENSL_INSC_IiLi1EEEPFvSN_EEENSL_INSC_IiLi3EEEPFvSN_SN_EEEEEEEEEEvSV_RT0_ENUlSN_SN_E_4_FUNESN_SN_
+	.type	_ZZN6vtable4impl5makerIFiiEE6set_fpIZ4mainEUliE_N5boost4hana6detail8map_implINS8_10hash_tableIJNS8_6bucketINS7_17integral_constantIxLx0EEEJLm0EEEENSB_INSC_IxLx1EEEJLm1EEEENSB_INSC_IxLx3EEEJLm2EEEEEEENS7_11basic_tupleIJNS7_4pairINSC_IiLi0EEEPFiPciEEENSL_INSC_IiLi1EEEPFvSN_EEENSL_INSC_IiLi3EEEPFvSN_SN_EEEEEEEEEEvSM_RT0_ENUlSN_iE_4_FUNESN_i, @function
+_ZZN6vtable4impl5makerIFiiEE6set_fpIZ4mainEUliE_N5boost4hana6detail8map_implINS8_10hash_tableIJNS8_6bucketINS7_17integral_constantIxLx0EEEJLm0EEEENSB_INSC_IxLx1EEEJLm1EEEENSB_INSC_IxLx3EEEJLm2EEEEEEENS7_11basic_tupleIJNS7_4pairINSC_IiLi0EEEPFiPciEEENSL_INSC_IiLi1EEEPFvSN_EEENSL_INSC_IiLi3EEEPFvSN_SN_EEEEEEEEEEvSM_RT0_ENUlSN_iE_4_FUNESN_i:
+.LFB6639:
+	.cfi_startproc
+	movl	$1, %eax
+	testl	%esi, %esi
+	jne	.L10
+	ret
+.L10:
+	pushq	%rbx
+	.cfi_def_cfa_offset 16
+	.cfi_offset 3, -16
+	movl	%esi, %ebx
+	movq	(%rdi), %rax
+	leal	-1(%rsi), %esi
+	leaq	16(%rax), %rdi
+	movq	(%rax), %rax
+	call	*(%rax)
+	imull	%ebx, %eax
+	popq	%rbx
+	.cfi_def_cfa_offset 8
+	ret
+	.cfi_endproc
+.LFE6639:
+	.size	_ZZN6vtable4impl5makerIFiiEE6set_fpIZ4mainEUliE_N5boost4hana6detail8map_implINS8_10hash_tableIJNS8_6bucketINS7_17integral_constantIxLx0EEEJLm0EEEENSB_INSC_IxLx1EEEJLm1EEEENSB_INSC_IxLx3EEEJLm2EEEEEEENS7_11basic_tupleIJNS7_4pairINSC_IiLi0EEEPFiPciEEENSL_INSC_IiLi1EEEPFvSN_EEENSL_INSC_IiLi3EEEPFvSN_SN_EEEEEEEEEEvSM_RT0_ENUlSN_iE_4_FUNESN_i, .-_ZZN6vtable4impl5makerIFiiEE6set_fpIZ4mainEUliE_N5boost4hana6detail8map_implINS8_10hash_tableIJNS8_6bucketINS7_17integral_constantIxLx0EEEJLm0EEEENSB_INSC_IxLx1EEEJLm1EEEENSB_INSC_IxLx3EEEJLm2EEEEEEENS7_11basic_tupleIJNS7_4pairINSC_IiLi0EEEPFiPciEEENSL_INSC_IiLi1EEEPFvSN_EEENSL_INSC_IiLi3EEEPFvSN_SN_EEEEEEEEEEvSM_RT0_ENUlSN_iE_4_FUNESN_i
+	.section	.text._ZN4impl7inplace7storageIFiiELm16EN5boost4hana6detail8map_implINS5_10hash_tableIJNS5_6bucketINS4_17integral_constantIxLx0EEEJLm0EEEENS8_INS9_IxLx1EEEJLm1EEEENS8_INS9_IxLx3EEEJLm2EEEEEEENS4_11basic_tupleIJNS4_4pairINS9_IiLi0EEEPFiPciEEENSI_INS9_IiLi1EEEPFvSK_EEENSI_INS9_IiLi3EEEPFvSK_SK_EEEEEEEEE5resetEv,"axG",@progbits,_ZN4impl7inplace7storageIFiiELm16EN5boost4hana6detail8map_implINS5_10hash_tableIJNS5_6bucketINS4_17integral_constantIxLx0EEEJLm0EEEENS8_INS9_IxLx1EEEJLm1EEEENS8_INS9_IxLx3EEEJLm2EEEEEEENS4_11basic_tupleIJNS4_4pairINS9_IiLi0EEEPFiPciEEENSI_INS9_IiLi1EEEPFvSK_EEENSI_INS9_IiLi3EEEPFvSK_SK_EEEEEEEEE5resetEv,comdat
+	.align 2
+	.weak	_ZN4impl7inplace7storageIFiiELm16EN5boost4hana6detail8map_implINS5_10hash_tableIJNS5_6bucketINS4_17integral_constantIxLx0EEEJLm0EEEENS8_INS9_IxLx1EEEJLm1EEEENS8_INS9_IxLx3EEEJLm2EEEEEEENS4_11basic_tupleIJNS4_4pairINS9_IiLi0EEEPFiPciEEENSI_INS9_IiLi1EEEPFvSK_EEENSI_INS9_IiLi3EEEPFvSK_SK_EEEEEEEEE5resetEv
+	.type	_ZN4impl7inplace7storageIFiiELm16EN5boost4hana6detail8map_implINS5_10hash_tableIJNS5_6bucketINS4_17integral_constantIxLx0EEEJLm0EEEENS8_INS9_IxLx1EEEJLm1EEEENS8_INS9_IxLx3EEEJLm2EEEEEEENS4_11basic_tupleIJNS4_4pairINS9_IiLi0EEEPFiPciEEENSI_INS9_IiLi1EEEPFvSK_EEENSI_INS9_IiLi3EEEPFvSK_SK_EEEEEEEEE5resetEv, @function
+_ZN4impl7inplace7storageIFiiELm16EN5boost4hana6detail8map_implINS5_10hash_tableIJNS5_6bucketINS4_17integral_constantIxLx0EEEJLm0EEEENS8_INS9_IxLx1EEEJLm1EEEENS8_INS9_IxLx3EEEJLm2EEEEEEENS4_11basic_tupleIJNS4_4pairINS9_IiLi0EEEPFiPciEEENSI_INS9_IiLi1EEEPFvSK_EEENSI_INS9_IiLi3EEEPFvSK_SK_EEEEEEEEE5resetEv:
+.LFB6324:
+	.cfi_startproc
+	.cfi_personality 0x9b,DW.ref.__gxx_personality_v0
+	.cfi_lsda 0x1b,.LLSDA6324
+	movq	(%rdi), %rax
+	testq	%rax, %rax
+	je	.L14
+	pushq	%rbx
+	.cfi_def_cfa_offset 16
+	.cfi_offset 3, -16
+	movq	%rdi, %rbx
+	leaq	16(%rdi), %rdi
+	call	*8(%rax)
+	movq	$0, (%rbx)
+	popq	%rbx
+	.cfi_def_cfa_offset 8
+	ret
+.L14:
+	.cfi_restore 3
+	ret
+	.cfi_endproc
+.LFE6324:
+	.globl	__gxx_personality_v0
+	.section	.gcc_except_table._ZN4impl7inplace7storageIFiiELm16EN5boost4hana6detail8map_implINS5_10hash_tableIJNS5_6bucketINS4_17integral_constantIxLx0EEEJLm0EEEENS8_INS9_IxLx1EEEJLm1EEEENS8_INS9_IxLx3EEEJLm2EEEEEEENS4_11basic_tupleIJNS4_4pairINS9_IiLi0EEEPFiPciEEENSI_INS9_IiLi1EEEPFvSK_EEENSI_INS9_IiLi3EEEPFvSK_SK_EEEEEEEEE5resetEv,"aG",@progbits,_ZN4impl7inplace7storageIFiiELm16EN5boost4hana6detail8map_implINS5_10hash_tableIJNS5_6bucketINS4_17integral_constantIxLx0EEEJLm0EEEENS8_INS9_IxLx1EEEJLm1EEEENS8_INS9_IxLx3EEEJLm2EEEEEEENS4_11basic_tupleIJNS4_4pairINS9_IiLi0EEEPFiPciEEENSI_INS9_IiLi1EEEPFvSK_EEENSI_INS9_IiLi3EEEPFvSK_SK_EEEEEEEEE5resetEv,comdat
+.LLSDA6324:
+	.byte	0xff
+	.byte	0xff
+	.byte	0x1
+	.uleb128 .LLSDACSE6324-.LLSDACSB6324
+.LLSDACSB6324:
+.LLSDACSE6324:
+	.section	.text._ZN4impl7inplace7storageIFiiELm16EN5boost4hana6detail8map_implINS5_10hash_tableIJNS5_6bucketINS4_17integral_constantIxLx0EEEJLm0EEEENS8_INS9_IxLx1EEEJLm1EEEENS8_INS9_IxLx3EEEJLm2EEEEEEENS4_11basic_tupleIJNS4_4pairINS9_IiLi0EEEPFiPciEEENSI_INS9_IiLi1EEEPFvSK_EEENSI_INS9_IiLi3EEEPFvSK_SK_EEEEEEEEE5resetEv,"axG",@progbits,_ZN4impl7inplace7storageIFiiELm16EN5boost4hana6detail8map_implINS5_10hash_tableIJNS5_6bucketINS4_17integral_constantIxLx0EEEJLm0EEEENS8_INS9_IxLx1EEEJLm1EEEENS8_INS9_IxLx3EEEJLm2EEEEEEENS4_11basic_tupleIJNS4_4pairINS9_IiLi0EEEPFiPciEEENSI_INS9_IiLi1EEEPFvSK_EEENSI_INS9_IiLi3EEEPFvSK_SK_EEEEEEEEE5resetEv,comdat
+	.size	_ZN4impl7inplace7storageIFiiELm16EN5boost4hana6detail8map_implINS5_10hash_tableIJNS5_6bucketINS4_17integral_constantIxLx0EEEJLm0EEEENS8_INS9_IxLx1EEEJLm1EEEENS8_INS9_IxLx3EEEJLm2EEEEEEENS4_11basic_tupleIJNS4_4pairINS9_IiLi0EEEPFiPciEEENSI_INS9_IiLi1EEEPFvSK_EEENSI_INS9_IiLi3EEEPFvSK_SK_EEEEEEEEE5resetEv, .-_ZN4impl7inplace7storageIFiiELm16EN5boost4hana6detail8map_implINS5_10hash_tableIJNS5_6bucketINS4_17integral_constantIxLx0EEEJLm0EEEENS8_INS9_IxLx1EEEJLm1EEEENS8_INS9_IxLx3EEEJLm2EEEEEEENS4_11basic_tupleIJNS4_4pairINS9_IiLi0EEEPFiPciEEENSI_INS9_IiLi1EEEPFvSK_EEENSI_INS9_IiLi3EEEPFvSK_SK_EEEEEEEEE5resetEv
+	.text
+	.globl	main
+	.type	main, @function
+main:
+.LFB5168:
+	.cfi_startproc
+	.cfi_personality 0x9b,DW.ref.__gxx_personality_v0
+	.cfi_lsda 0x1b,.LLSDA5168
+	pushq	%rbx
+	.cfi_def_cfa_offset 16
+	.cfi_offset 3, -16
+	subq	$48, %rsp
+	.cfi_def_cfa_offset 64
+	movq	$0, 16(%rsp)
+	leaq	16(%rsp), %rax
+	movq	%rax, 32(%rsp)
+	movzbl	_ZGVZN6vtable8instanceIZ4mainEUliE_FiiEN5boost4hana6detail8map_implINS5_10hash_tableIJNS5_6bucketINS4_17integral_constantIxLx0EEEJLm0EEEENS8_INS9_IxLx1EEEJLm1EEEENS8_INS9_IxLx3EEEJLm2EEEEEEENS4_11basic_tupleIJNS4_4pairINS9_IiLi0EEEPFiPciEEENSI_INS9_IiLi1EEEPFvSK_EEENSI_INS9_IiLi3EEEPFvSK_SK_EEEEEEEEEERKDavE6result(%rip), %eax
+	testb	%al, %al
+	je	.L24
+.L18:
+	leaq	_ZZN6vtable8instanceIZ4mainEUliE_FiiEN5boost4hana6detail8map_implINS5_10hash_tableIJNS5_6bucketINS4_17integral_constantIxLx0EEEJLm0EEEENS8_INS9_IxLx1EEEJLm1EEEENS8_INS9_IxLx3EEEJLm2EEEEEEENS4_11basic_tupleIJNS4_4pairINS9_IiLi0EEEPFiPciEEENSI_INS9_IiLi1EEEPFvSK_EEENSI_INS9_IiLi3EEEPFvSK_SK_EEEEEEEEEERKDavE6result(%rip), %rax
+	movq	%rax, 16(%rsp)
+	leaq	32(%rsp), %rdi
+	movl	$6, %esi
+.LEHB0:
+	call	*_ZZN6vtable8instanceIZ4mainEUliE_FiiEN5boost4hana6detail8map_implINS5_10hash_tableIJNS5_6bucketINS4_17integral_constantIxLx0EEEJLm0EEEENS8_INS9_IxLx1EEEJLm1EEEENS8_INS9_IxLx3EEEJLm2EEEEEEENS4_11basic_tupleIJNS4_4pairINS9_IiLi0EEEPFiPciEEENSI_INS9_IiLi1EEEPFvSK_EEENSI_INS9_IiLi3EEEPFvSK_SK_EEEEEEEEEERKDavE6result(%rip)
+.LEHE0:
+	jmp	.L25
+.L24:
+	leaq	_ZGVZN6vtable8instanceIZ4mainEUliE_FiiEN5boost4hana6detail8map_implINS5_10hash_tableIJNS5_6bucketINS4_17integral_constantIxLx0EEEJLm0EEEENS8_INS9_IxLx1EEEJLm1EEEENS8_INS9_IxLx3EEEJLm2EEEEEEENS4_11basic_tupleIJNS4_4pairINS9_IiLi0EEEPFiPciEEENSI_INS9_IiLi1EEEPFvSK_EEENSI_INS9_IiLi3EEEPFvSK_SK_EEEEEEEEEERKDavE6result(%rip), %rdi
+	call	__cxa_guard_acquire@PLT
+	testl	%eax, %eax
+	je	.L18
+	leaq	_ZZN6vtable4impl5makerIFiiEE6set_fpIZ4mainEUliE_N5boost4hana6detail8map_implINS8_10hash_tableIJNS8_6bucketINS7_17integral_constantIxLx0EEEJLm0EEEENSB_INSC_IxLx1EEEJLm1EEEENSB_INSC_IxLx3EEEJLm2EEEEEEENS7_11basic_tupleIJNS7_4pairINSC_IiLi0EEEPFiPciEEENSL_INSC_IiLi1EEEPFvSN_EEENSL_INSC_IiLi3EEEPFvSN_SN_EEEEEEEEEEvSM_RT0_ENUlSN_iE_4_FUNESN_i(%rip), %rax
+	movq	%rax, _ZZN6vtable8instanceIZ4mainEUliE_FiiEN5boost4hana6detail8map_implINS5_10hash_tableIJNS5_6bucketINS4_17integral_constantIxLx0EEEJLm0EEEENS8_INS9_IxLx1EEEJLm1EEEENS8_INS9_IxLx3EEEJLm2EEEEEEENS4_11basic_tupleIJNS4_4pairINS9_IiLi0EEEPFiPciEEENSI_INS9_IiLi1EEEPFvSK_EEENSI_INS9_IiLi3EEEPFvSK_SK_EEEEEEEEEERKDavE6result(%rip)
+	leaq	_ZZN6vtable4impl5makerIFiiEE6set_fpIZ4mainEUliE_N5boost4hana6detail8map_implINS8_10hash_tableIJNS8_6bucketINS7_17integral_constantIxLx0EEEJLm0EEEENSB_INSC_IxLx1EEEJLm1EEEENSB_INSC_IxLx3EEEJLm2EEEEEEENS7_11basic_tupleIJNS7_4pairINSC_IiLi0EEEPFiPciEEENSL_INSC_IiLi1EEEPFvSN_EEENSL_INSC_IiLi3EEEPFvSN_SN_EEEEEEEEEEvSR_RT0_ENUlSN_E_4_FUNESN_(%rip), %rax
+	movq	%rax, 8+_ZZN6vtable8instanceIZ4mainEUliE_FiiEN5boost4hana6detail8map_implINS5_10hash_tableIJNS5_6bucketINS4_17integral_constantIxLx0EEEJLm0EEEENS8_INS9_IxLx1EEEJLm1EEEENS8_INS9_IxLx3EEEJLm2EEEEEEENS4_11basic_tupleIJNS4_4pairINS9_IiLi0EEEPFiPciEEENSI_INS9_IiLi1EEEPFvSK_EEENSI_INS9_IiLi3EEEPFvSK_SK_EEEEEEEEEERKDavE6result(%rip)
+	leaq	_ZZN6vtable4impl5makerIFiiEE6set_fpIZ4mainEUliE_N5boost4hana6detail8map_implINS8_10hash_tableIJNS8_6bucketINS7_17integral_constantIxLx0EEEJLm0EEEENSB_INSC_IxLx1EEEJLm1EEEENSB_INSC_IxLx3EEEJLm2EEEEEEENS7_11basic_tupleIJNS7_4pairINSC_IiLi0EEEPFiPciEEENSL_INSC_IiLi1EEEPFvSN_EEENSL_INSC_IiLi3EEEPFvSN_SN_EEEEEEEEEEvSV_RT0_ENUlSN_SN_E_4_FUNESN_SN_(%rip), %rax
+	movq	%rax, 16+_ZZN6vtable8instanceIZ4mainEUliE_FiiEN5boost4hana6detail8map_implINS5_10hash_tableIJNS5_6bucketINS4_17integral_constantIxLx0EEEJLm0EEEENS8_INS9_IxLx1EEEJLm1EEEENS8_INS9_IxLx3EEEJLm2EEEEEEENS4_11basic_tupleIJNS4_4pairINS9_IiLi0EEEPFiPciEEENSI_INS9_IiLi1EEEPFvSK_EEENSI_INS9_IiLi3EEEPFvSK_SK_EEEEEEEEEERKDavE6result(%rip)
+	leaq	_ZGVZN6vtable8instanceIZ4mainEUliE_FiiEN5boost4hana6detail8map_implINS5_10hash_tableIJNS5_6bucketINS4_17integral_constantIxLx0EEEJLm0EEEENS8_INS9_IxLx1EEEJLm1EEEENS8_INS9_IxLx3EEEJLm2EEEEEEENS4_11basic_tupleIJNS4_4pairINS9_IiLi0EEEPFiPciEEENSI_INS9_IiLi1EEEPFvSK_EEENSI_INS9_IiLi3EEEPFvSK_SK_EEEEEEEEEERKDavE6result(%rip), %rdi
+	call	__cxa_guard_release@PLT
+	jmp	.L18
+.L20:
+	movq	%rax, %rbx
+	leaq	16(%rsp), %rdi
+	call	_ZN4impl7inplace7storageIFiiELm16EN5boost4hana6detail8map_implINS5_10hash_tableIJNS5_6bucketINS4_17integral_constantIxLx0EEEJLm0EEEENS8_INS9_IxLx1EEEJLm1EEEENS8_INS9_IxLx3EEEJLm2EEEEEEENS4_11basic_tupleIJNS4_4pairINS9_IiLi0EEEPFiPciEEENSI_INS9_IiLi1EEEPFvSK_EEENSI_INS9_IiLi3EEEPFvSK_SK_EEEEEEEEE5resetEv
+	movq	%rbx, %rdi
+.LEHB1:
+	call	_Unwind_Resume@PLT
+.LEHE1:
+.L25:
+	movl	%eax, 12(%rsp)
+	leaq	16(%rsp), %rdi
+	call	_ZN4impl7inplace7storageIFiiELm16EN5boost4hana6detail8map_implINS5_10hash_tableIJNS5_6bucketINS4_17integral_constantIxLx0EEEJLm0EEEENS8_INS9_IxLx1EEEJLm1EEEENS8_INS9_IxLx3EEEJLm2EEEEEEENS4_11basic_tupleIJNS4_4pairINS9_IiLi0EEEPFiPciEEENSI_INS9_IiLi1EEEPFvSK_EEENSI_INS9_IiLi3EEEPFvSK_SK_EEEEEEEEE5resetEv
+	movl	$0, %eax
+	addq	$48, %rsp
+	.cfi_def_cfa_offset 16
+	popq	%rbx
+	.cfi_def_cfa_offset 8
+	ret
+	.cfi_endproc
+.LFE5168:
+	.section	.gcc_except_table,"a",@progbits
+.LLSDA5168:
+	.byte	0xff
+	.byte	0xff
+	.byte	0x1
+	.uleb128 .LLSDACSE5168-.LLSDACSB5168
+.LLSDACSB5168:
+	.uleb128 .LEHB0-.LFB5168
+	.uleb128 .LEHE0-.LEHB0
+	.uleb128 .L20-.LFB5168
+	.uleb128 0
+	.uleb128 .LEHB1-.LFB5168
+	.uleb128 .LEHE1-.LEHB1
+	.uleb128 0
+	.uleb128 0
+.LLSDACSE5168:
+	.text
+	.size	main, .-main
+	.type	_GLOBAL__sub_I_main, @function
+_GLOBAL__sub_I_main:
+.LFB6732:
+	.cfi_startproc
+	pushq	%rbx
+	.cfi_def_cfa_offset 16
+	.cfi_offset 3, -16
+	leaq	_ZStL8__ioinit(%rip), %rbx
+	movq	%rbx, %rdi
+	call	_ZNSt8ios_base4InitC1Ev@PLT
+	leaq	__dso_handle(%rip), %rdx
+	movq	%rbx, %rsi
+	movq	_ZNSt8ios_base4InitD1Ev@GOTPCREL(%rip), %rdi
+	call	__cxa_atexit@PLT
+	popq	%rbx
+	.cfi_def_cfa_offset 8
+	ret
+	.cfi_endproc
+.LFE6732:
+	.size	_GLOBAL__sub_I_main, .-_GLOBAL__sub_I_main
+	.section	.init_array,"aw"
+	.align 8
+	.quad	_GLOBAL__sub_I_main
+	.local	_ZGVZN6vtable8instanceIZ4mainEUliE_FiiEN5boost4hana6detail8map_implINS5_10hash_tableIJNS5_6bucketINS4_17integral_constantIxLx0EEEJLm0EEEENS8_INS9_IxLx1EEEJLm1EEEENS8_INS9_IxLx3EEEJLm2EEEEEEENS4_11basic_tupleIJNS4_4pairINS9_IiLi0EEEPFiPciEEENSI_INS9_IiLi1EEEPFvSK_EEENSI_INS9_IiLi3EEEPFvSK_SK_EEEEEEEEEERKDavE6result
+	.comm	_ZGVZN6vtable8instanceIZ4mainEUliE_FiiEN5boost4hana6detail8map_implINS5_10hash_tableIJNS5_6bucketINS4_17integral_constantIxLx0EEEJLm0EEEENS8_INS9_IxLx1EEEJLm1EEEENS8_INS9_IxLx3EEEJLm2EEEEEEENS4_11basic_tupleIJNS4_4pairINS9_IiLi0EEEPFiPciEEENSI_INS9_IiLi1EEEPFvSK_EEENSI_INS9_IiLi3EEEPFvSK_SK_EEEEEEEEEERKDavE6result,8,8
+	.data
+	.align 32
+	.type	_ZZN6vtable8instanceIZ4mainEUliE_FiiEN5boost4hana6detail8map_implINS5_10hash_tableIJNS5_6bucketINS4_17integral_constantIxLx0EEEJLm0EEEENS8_INS9_IxLx1EEEJLm1EEEENS8_INS9_IxLx3EEEJLm2EEEEEEENS4_11basic_tupleIJNS4_4pairINS9_IiLi0EEEPFiPciEEENSI_INS9_IiLi1EEEPFvSK_EEENSI_INS9_IiLi3EEEPFvSK_SK_EEEEEEEEEERKDavE6result, @object
+	.size	_ZZN6vtable8instanceIZ4mainEUliE_FiiEN5boost4hana6detail8map_implINS5_10hash_tableIJNS5_6bucketINS4_17integral_constantIxLx0EEEJLm0EEEENS8_INS9_IxLx1EEEJLm1EEEENS8_INS9_IxLx3EEEJLm2EEEEEEENS4_11basic_tupleIJNS4_4pairINS9_IiLi0EEEPFiPciEEENSI_INS9_IiLi1EEEPFvSK_EEENSI_INS9_IiLi3EEEPFvSK_SK_EEEEEEEEEERKDavE6result, 40
+_ZZN6vtable8instanceIZ4mainEUliE_FiiEN5boost4hana6detail8map_implINS5_10hash_tableIJNS5_6bucketINS4_17integral_constantIxLx0EEEJLm0EEEENS8_INS9_IxLx1EEEJLm1EEEENS8_INS9_IxLx3EEEJLm2EEEEEEENS4_11basic_tupleIJNS4_4pairINS9_IiLi0EEEPFiPciEEENSI_INS9_IiLi1EEEPFvSK_EEENSI_INS9_IiLi3EEEPFvSK_SK_EEEEEEEEEERKDavE6result:
+	.zero	24
+	.quad	8
+	.quad	8
+	.local	_ZStL8__ioinit
+	.comm	_ZStL8__ioinit,1,1
+	.hidden	DW.ref.__gxx_personality_v0
+	.weak	DW.ref.__gxx_personality_v0
+	.section	.data.rel.local.DW.ref.__gxx_personality_v0,"awG",@progbits,DW.ref.__gxx_personality_v0,comdat
+	.align 8
+	.type	DW.ref.__gxx_personality_v0, @object
+	.size	DW.ref.__gxx_personality_v0, 8
+DW.ref.__gxx_personality_v0:
+	.quad	__gxx_personality_v0
+	.hidden	__dso_handle
+	.ident	"GCC: (Debian 12.2.0-14+deb12u1) 12.2.0"
+	.section	.note.GNU-stack,"",@progbits
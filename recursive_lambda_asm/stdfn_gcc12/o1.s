@@ -0,0 +1,188 @@
+	.file	"x.cpp"
+	.text
+	.type	_ZNSt17_Function_handlerIFiiEZ4mainEUliE_E10_M_managerERSt9_Any_dataRKS3_St18_Manager_operation, @function
+_ZNSt17_Function_handlerIFiiEZ4mainEUliE_E10_M_managerERSt9_Any_dataRKS3_St18_Manager_operation:
+.LFB1877:
+	.cfi_startproc
+	testl	%edx, %edx
+	je	.L2
+	cmpl	$1, %edx
+	je	.L3
+	cmpl	$2, %edx
+	jne	.L5
+	movq	(%rsi), %rax
+	movq	%rax, (%rdi)
+	jmp	.L5
+.L2:
+	leaq	_ZTIZ4mainEUliE_(%rip), %rax
+	movq	%rax, (%rdi)
+.L5:
+	movl	$0, %eax
+	ret
+.L3:
+	movq	%rsi, (%rdi)
+	jmp	.L5
+	.cfi_endproc
+.LFE1877:
+	.size	_ZNSt17_Function_handlerIFiiEZ4mainEUliE_E10_M_managerERSt9_Any_dataRKS3_St18_Manager_operation, .-_ZNSt17_Function_handlerIFiiEZ4mainEUliE_E10_M_managerERSt9_Any_dataRKS3_St18_Manager_operation
+	.type	_ZNSt17_Function_handlerIFiiEZ4mainEUliE_E9_M_invokeERKSt9_Any_dataOi, @function
+_ZNSt17_Function_handlerIFiiEZ4mainEUliE_E9_M_invokeERKSt9_Any_dataOi:
+.LFB1876:
+	.cfi_startproc
+	pushq	%rbx
+	.cfi_def_cfa_offset 16
+	.cfi_offset 3, -16
+	subq	$16, %rsp
+	.cfi_def_cfa_offset 32
+	movl	(%rsi), %ebx
+	movl	$1, %eax
+	testl	%ebx, %ebx
+	jne	.L12
+.L7:
+	addq	$16, %rsp
+	.cfi_remember_state
+	.cfi_def_cfa_offset 16
+	popq	%rbx
+	.cfi_def_cfa_offset 8
+	ret
+.L12:
+	.cfi_restore_state
+	movq	(%rdi), %rax
+	leal	-1(%rbx), %edx
+	movl	%edx, 12(%rsp)
+	cmpq	$0, 16(%rax)
+	je	.L13
+	leaq	12(%rsp), %rsi
+	movq	%rax, %rdi
+	call	*24(%rax)
+	imull	%ebx, %eax
+	jmp	.L7
+.L13:
+	call	_ZSt25__throw_bad_function_callv@PLT
+	.cfi_endproc
+.LFE1876:
+	.size	_ZNSt17_Function_handlerIFiiEZ4mainEUliE_E9_M_invokeERKSt9_Any_dataOi, .-_ZNSt17_Function_handlerIFiiEZ4mainEUliE_E9_M_invokeERKSt9_Any_dataOi
+	.section	.text._ZNSt14_Function_baseD2Ev,"axG",@progbits,_ZNSt14_Function_baseD5Ev,comdat
+	.align 2
+	.weak	_ZNSt14_Function_baseD2Ev
+	.type	_ZNSt14_Function_baseD2Ev, @function
+_ZNSt14_Function_baseD2Ev:
+.LFB1765:
+	.cfi_startproc
+	.cfi_personality 0x9b,DW.ref.__gxx_personality_v0
+	.cfi_lsda 0x1b,.LLSDA1765
+	movq	16(%rdi), %rax
+	testq	%rax, %rax
+	je	.L17
+	subq	$8, %rsp
+	.cfi_def_cfa_offset 16
+	movl	$3, %edx
+	movq	%rdi, %rsi
+	call	*%rax
+	addq	$8, %rsp
+	.cfi_def_cfa_offset 8
+	ret
+.L17:
+	ret
+	.cfi_endproc
+.LFE1765:
+	.globl	__gxx_personality_v0
+	.section	.gcc_except_table._ZNSt14_Function_baseD2Ev,"aG",@progbits,_ZNSt14_Function_baseD5Ev,comdat
+.LLSDA1765:
+	.byte	0xff
+	.byte	0xff
+	.byte	0x1
+	.uleb128 .LLSDACSE1765-.LLSDACSB1765
+.LLSDACSB1765:
+.LLSDACSE1765:
+	.section	.text._ZNSt14_Function_baseD2Ev,"axG",@progbits,_ZNSt14_Function_baseD5Ev,comdat
+	.size	_ZNSt14_Function_baseD2Ev, .-_ZNSt14_Function_baseD2Ev
+	.weak	_ZNSt14_Function_baseD1Ev
+	.set	_ZNSt14_Function_baseD1Ev,_ZNSt14_Function_baseD2Ev
+	.text
+	.globl	main
+	.type	main, @function
+main:
+.LFB1835:
+	.cfi_startproc
+	.cfi_personality 0x9b,DW.ref.__gxx_personality_v0
+	.cfi_lsda 0x1b,.LLSDA1835
+	pushq	%rbx
+	.cfi_def_cfa_offset 16
+	.cfi_offset 3, -16
+	subq	$48, %rsp
+	.cfi_def_cfa_offset 64
+	movq	$0, 24(%rsp)
+	leaq	16(%rsp), %rdi
+	movq	%rdi, 16(%rsp)
+	leaq	_ZNSt17_Function_handlerIFiiEZ4mainEUliE_E9_M_invokeERKSt9_Any_dataOi(%rip), %rax
+	movq	%rax, 40(%rsp)
+	leaq	_ZNSt17_Function_handlerIFiiEZ4mainEUliE_E10_M_managerERSt9_Any_dataRKS3_St18_Manager_operation(%rip), %rax
+	movq	%rax, 32(%rsp)
+	movl	$6, 8(%rsp)
+	leaq	8(%rsp), %rsi
+.LEHB0:
+	call	_ZNSt17_Function_handlerIFiiEZ4mainEUliE_E9_M_invokeERKSt9_Any_dataOi
+.LEHE0:
+	jmp	.L26
+.L22:
+	movq	%rax, %rbx
+	leaq	16(%rsp), %rdi
+	call	_ZNSt14_Function_baseD2Ev
+	movq	%rbx, %rdi
+.LEHB1:
+	call	_Unwind_Resume@PLT
+.LEHE1:
+.L26:
+	movl	%eax, 12(%rsp)
+	leaq	16(%rsp), %rdi
+	call	_ZNSt14_Function_baseD2Ev
+	movl	$0, %eax
+	addq	$48, %rsp
+	.cfi_def_cfa_offset 16
+	popq	%rbx
+	.cfi_def_cfa_offset 8
+	ret
+	.cfi_endproc
+.LFE1835:
+	.section	.gcc_except_table,"a",@progbits
+.LLSDA1835:
+	.byte	0xff
+	.byte	0xff
+	.byte	0x1
+	.uleb128 .LLSDACSE1835-.LLSDACSB1835
+.LLSDACSB1835:
+	.uleb128 .LEHB0-.LFB1835
+	.uleb128 .LEHE0-.LEHB0
+	.uleb128 .L22-.LFB1835
+	.uleb128 0
+	.uleb128 .LEHB1-.LFB1835
+	.uleb128 .LEHE1-.LEHB1
+	.uleb128 0
+	.uleb128 0
+.LLSDACSE1835:
+	.text
+	.size	main, .-main
+	.section	.data.rel.ro,"aw"
+	.align 8
+	.type	_ZTIZ4mainEUliE_, @object
+	.size	_ZTIZ4mainEUliE_, 16
+_ZTIZ4mainEUliE_:
+	.quad	_ZTVN10__cxxabiv117__class_type_infoE+16
+	.quad	_ZTSZ4mainEUliE_
+	.section	.rodata
+	.align 8
+	.type	_ZTSZ4mainEUliE_, @object
+	.size	_ZTSZ4mainEUliE_, 14
+_ZTSZ4mainEUliE_:
+	.string	"*Z4mainEUliE_"
+	.hidden	DW.ref.__gxx_personality_v0
+	.weak	DW.ref.__gxx_personality_v0
+	.section	.data.rel.local.DW.ref.__gxx_personality_v0,"awG",@progbits,DW.ref.__gxx_personality_v0,comdat
+	.align 8
+	.type	DW.ref.__gxx_personality_v0, @object
+	.size	DW.ref.__gxx_personality_v0, 8
+DW.ref.__gxx_personality_v0:
+	.quad	__gxx_personality_v0
+	.ident	"GCC: (Debian 12.2.0-14+deb12u1) 12.2.0"
+	.section	.note.GNU-stack,"",@progbits
@@ -0,0 +1,250 @@
+	.file	"x.cpp"
+	.text
+	.p2align 4
+	.type	_ZNSt17_Function_handlerIFiiEZ4mainEUliE_E9_M_invokeERKSt9_Any_dataOi, @function
+_ZNSt17_Function_handlerIFiiEZ4mainEUliE_E9_M_invokeERKSt9_Any_dataOi:
+.LFB1876:
+	.cfi_startproc
+	pushq	%rbx
+	.cfi_def_cfa_offset 16
+	.cfi_offset 3, -16
+	movl	$1, %eax
+	subq	$16, %rsp
+	.cfi_def_cfa_offset 32
+	movl	(%rsi), %ebx
+	testl	%ebx, %ebx
+	jne	.L9
+	addq	$16, %rsp
+	.cfi_remember_state
+	.cfi_def_cfa_offset 16
+	popq	%rbx
+	.cfi_def_cfa_offset 8
+	ret
+	.p2align 4,,10
+	.p2align 3
+.L9:
+	.cfi_restore_state
+	movq	(%rdi), %rax
+	leal	-1(%rbx), %edx
+	movl	%edx, 12(%rsp)
+	cmpq	$0, 16(%rax)
+	je	.L10
+	leaq	12(%rsp), %rsi
+	movq	%rax, %rdi
+	call	*24(%rax)
+	addq	$16, %rsp
+	.cfi_remember_state
+	.cfi_def_cfa_offset 16
+	imull	%ebx, %eax
+	popq	%rbx
+	.cfi_def_cfa_offset 8
+	ret
+.L10:
+	.cfi_restore_state
+	call	_ZSt25__throw_bad_function_callv@PLT
+	.cfi_endproc
+.LFE1876:
+	.size	_ZNSt17_Function_handlerIFiiEZ4mainEUliE_E9_M_invokeERKSt9_Any_dataOi, .-_ZNSt17_Function_handlerIFiiEZ4mainEUliE_E9_M_invokeERKSt9_Any_dataOi
+	.p2align 4
+	.type	_ZNSt17_Function_handlerIFiiEZ4mainEUliE_E10_M_managerERSt9_Any_dataRKS3_St18_Manager_operation, @function
+_ZNSt17_Function_handlerIFiiEZ4mainEUliE_E10_M_managerERSt9_Any_dataRKS3_St18_Manager_operation:
+.LFB1877:
+	.cfi_startproc
+	testl	%edx, %edx
+	je	.L12
+	cmpl	$1, %edx
+	je	.L13
+	cmpl	$2, %edx
+	je	.L17
+.L15:
+	xorl	%eax, %eax
+	ret
+	.p2align 4,,10
+	.p2align 3
+.L12:
+	leaq	_ZTIZ4mainEUliE_(%rip), %rax
+	movq	%rax, (%rdi)
+	xorl	%eax, %eax
+	ret
+	.p2align 4,,10
+	.p2align 3
+.L13:
+	movq	%rsi, (%rdi)
+	xorl	%eax, %eax
+	ret
+	.p2align 4,,10
+	.p2align 3
+.L17:
+	movq	(%rsi), %rax
+	movq	%rax, (%rdi)
+	jmp	.L15
+	.cfi_endproc
+.LFE1877:
+	.size	_ZNSt17_Function_handlerIFiiEZ4mainEUliE_E10_M_managerERSt9_Any_dataRKS3_St18_Manager_operation, .-_ZNSt17_Function_handlerIFiiEZ4mainEUliE_E10_M_managerERSt9_Any_dataRKS3_St18_Manager_operation
+	.section	.text._ZNSt14_Function_baseD2Ev,"axG",@progbits,_ZNSt14_Function_baseD5Ev,comdat
+	.align 2
+	.p2align 4
+	.weak	_ZNSt14_Function_baseD2Ev
+	.type	_ZNSt14_Function_baseD2Ev, @function
+_ZNSt14_Function_baseD2Ev:
+.LFB1765:
+	.cfi_startproc
+	.cfi_personality 0x9b,DW.ref.__gxx_personality_v0
+	.cfi_lsda 0x1b,.LLSDA1765
+	movq	16(%rdi), %rax
+	testq	%rax, %rax
+	je	.L24
+	subq	$8, %rsp
+	.cfi_def_cfa_offset 16
+	movl	$3, %edx
+	movq	%rdi, %rsi
+	call	*%rax
+	addq	$8, %rsp
+	.cfi_def_cfa_offset 8
+	ret
+	.p2align 4,,10
+	.p2align 3
+.L24:
+	ret
+	.cfi_endproc
+.LFE1765:
+	.globl	__gxx_personality_v0
+	.section	.gcc_except_table._ZNSt14_Function_baseD2Ev,"aG",@progbits,_ZNSt14_Function_baseD5Ev,comdat
+.LLSDA1765:
+	.byte	0xff
+	.byte	0xff
+	.byte	0x1
+	.uleb128 .LLSDACSE1765-.LLSDACSB1765
+.LLSDACSB1765:
+.LLSDACSE1765:
+	.section	.text._ZNSt14_Function_baseD2Ev,"axG",@progbits,_ZNSt14_Function_baseD5Ev,comdat
+	.size	_ZNSt14_Function_baseD2Ev, .-_ZNSt14_Function_baseD2Ev
+	.weak	_ZNSt14_Function_baseD1Ev
+	.set	_ZNSt14_Function_baseD1Ev,_ZNSt14_Function_baseD2Ev
+	.section	.text.unlikely,"ax",@progbits
+.LCOLDB0:
+	.section	.text.startup,"ax",@progbits
+.LHOTB0:
+	.p2align 4
+	.globl	main
+	.type	main, @function
+main:
+.LFB1835:
+	.cfi_startproc
+	.cfi_personality 0x9b,DW.ref.__gxx_personality_v0
+	.cfi_lsda 0x1b,.LLSDA1835
+	pushq	%rbp
+	.cfi_def_cfa_offset 16
+	.cfi_offset 6, -16
+	leaq	_ZNSt17_Function_handlerIFiiEZ4mainEUliE_E9_M_invokeERKSt9_Any_dataOi(%rip), %rax
+	leaq	_ZNSt17_Function_handlerIFiiEZ4mainEUliE_E10_M_managerERSt9_Any_dataRKS3_St18_Manager_operation(%rip), %rdx
+	pushq	%rbx
+	.cfi_def_cfa_offset 24
+	.cfi_offset 3, -24
+	movq	%rdx, %xmm0
+	movq	%rax, %xmm1
+	punpcklqdq	%xmm1, %xmm0
+	subq	$56, %rsp
+	.cfi_def_cfa_offset 80
+	leaq	16(%rsp), %rbx
+	leaq	12(%rsp), %rsi
+	movq	$0, 24(%rsp)
+	movq	%rbx, %rdi
+	movq	%rbx, 16(%rsp)
+	movl	$6, 12(%rsp)
+	movaps	%xmm0, 32(%rsp)
+.LEHB0:
+	call	_ZNSt17_Function_handlerIFiiEZ4mainEUliE_E9_M_invokeERKSt9_Any_dataOi
+.LEHE0:
+	movq	%rbx, %rdi
+	movl	%eax, 12(%rsp)
+	call	_ZNSt14_Function_baseD2Ev
+	addq	$56, %rsp
+	.cfi_remember_state
+	.cfi_def_cfa_offset 24
+	xorl	%eax, %eax
+	popq	%rbx
+	.cfi_def_cfa_offset 16
+	popq	%rbp
+	.cfi_def_cfa_offset 8
+	ret
+.L29:
+	.cfi_restore_state
+	movq	%rax, %rbp
+	jmp	.L28
+	.section	.gcc_except_table,"a",@progbits
+.LLSDA1835:
+	.byte	0xff
+	.byte	0xff
+	.byte	0x1
+	.uleb128 .LLSDACSE1835-.LLSDACSB1835
+.LLSDACSB1835:
+	.uleb128 .LEHB0-.LFB1835
+	.uleb128 .LEHE0-.LEHB0
+	.uleb128 .L29-.LFB1835
+	.uleb128 0
+.LLSDACSE1835:
+	.section	.text.startup
+	.cfi_endproc
+	.section	.text.unlikely
+	.cfi_startproc
+	.cfi_personality 0x9b,DW.ref.__gxx_personality_v0
+	.cfi_lsda 0x1b,.LLSDAC1835
+	.type	main.cold, @function
+main.cold:
+.LFSB1835:
+.L28:
+	.cfi_def_cfa_offset 80
+	.cfi_offset 3, -24
+	.cfi_offset 6, -16
+	movq	%rbx, %rdi
+	call	_ZNSt14_Function_baseD2Ev
+	movq	%rbp, %rdi
+.LEHB1:
+	call	_Unwind_Resume@PLT
+.LEHE1:
+	.cfi_endproc
+.LFE1835:
+	.section	.gcc_except_table
+.LLSDAC1835:
+	.byte	0xff
+	.byte	0xff
+	.byte	0x1
+	.uleb128 .LLSDACSEC1835-.LLSDACSBC1835
+.LLSDACSBC1835:
+	.uleb128 .LEHB1-.LCOLDB0
+	.uleb128 .LEHE1-.LEHB1
+	.uleb128 0
+	.uleb128 0
+.LLSDACSEC1835:
+	.section	.text.unlikely
+	.section	.text.startup
+	.size	main, .-main
+	.section	.text.unlikely
+	.size	main.cold, .-main.cold
+.LCOLDE0:
+	.section	.text.startup
+.LHOTE0:
+	.section	.data.rel.ro,"aw"
+	.align 8
+	.type	_ZTIZ4mainEUliE_, @object
+	.size	_ZTIZ4mainEUliE_, 16
+_ZTIZ4mainEUliE_:
+	.quad	_ZTVN10__cxxabiv117__class_type_infoE+16
+	.quad	_ZTSZ4mainEUliE_
+	.section	.rodata
+	.align 8
+	.type	_ZTSZ4mainEUliE_, @object
+	.size	_ZTSZ4mainEUliE_, 14
+_ZTSZ4mainEUliE_:
+	.string	"*Z4mainEUliE_"
+	.hidden	DW.ref.__gxx_personality_v0
+	.weak	DW.ref.__gxx_personality_v0
+	.section	.data.rel.local.DW.ref.__gxx_personality_v0,"awG",@progbits,DW.ref.__gxx_personality_v0,comdat
+	.align 8
+	.type	DW.ref.__gxx_personality_v0, @object
+	.size	DW.ref.__gxx_personality_v0, 8
+DW.ref.__gxx_personality_v0:
+	.quad	__gxx_personality_v0
+	.ident	"GCC: (Debian 12.2.0-14+deb12u1) 12.2.0"
+	.section	.note.GNU-stack,"",@progbits
@@ -2,24 +2,36 @@
 #include <functional>
 
 // #define USE_YCOMBINATOR
+// #define USE_INPLACE_FUNCTION
+
+#ifdef USE_INPLACE_FUNCTION
+#include "../Random/fn_queue/inplace_function.hpp"
+#endif
 
 int main()
 {
-#ifndef USE_YCOMBINATOR
-    std::function<int(int)> f = [&](int x)
-    {
-        if(x == 0)
-            return 1;
-        return x * f(x - 1);
-    };
-#else
+#if defined(USE_YCOMBINATOR)
     auto f = boost::hana::fix([](auto self, int x) -> int
         {
             if(x == 0)
                 return 1;
             return x * self(x - 1);
         });
+#elif defined(USE_INPLACE_FUNCTION)
+    inplace_function<int(int), 16> f = [&](int x)
+    {
+        if(x == 0)
+            return 1;
+        return x * f(x - 1);
+    };
+#else
+    std::function<int(int)> f = [&](int x)
+    {
+        if(x == 0)
+            return 1;
+        return x * f(x - 1);
+    };
 #endif
 
     volatile auto res = f(6);
-}
\ No newline at end of file
+}
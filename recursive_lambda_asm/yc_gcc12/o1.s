@@ -0,0 +1,205 @@
+	.file	"x.cpp"
+	.text
+	.align 2
+	.type	_ZNR5boost4hana5fix_tIZ4mainEUlT_iE_EclIJiEEEDcDpOT_, @function
+_ZNR5boost4hana5fix_tIZ4mainEUlT_iE_EclIJiEEEDcDpOT_:
+.LFB1839:
+	.cfi_startproc
+	pushq	%r13
+	.cfi_def_cfa_offset 16
+	.cfi_offset 13, -16
+	pushq	%r12
+	.cfi_def_cfa_offset 24
+	.cfi_offset 12, -24
+	pushq	%rbp
+	.cfi_def_cfa_offset 32
+	.cfi_offset 6, -32
+	pushq	%rbx
+	.cfi_def_cfa_offset 40
+	.cfi_offset 3, -40
+	subq	$24, %rsp
+	.cfi_def_cfa_offset 64
+	movl	(%rsi), %ebx
+	movl	$1, %eax
+	testl	%ebx, %ebx
+	jne	.L11
+.L1:
+	addq	$24, %rsp
+	.cfi_remember_state
+	.cfi_def_cfa_offset 40
+	popq	%rbx
+	.cfi_def_cfa_offset 32
+	popq	%rbp
+	.cfi_def_cfa_offset 24
+	popq	%r12
+	.cfi_def_cfa_offset 16
+	popq	%r13
+	.cfi_def_cfa_offset 8
+	ret
+.L11:
+	.cfi_restore_state
+	movl	%ebx, %ebp
+	subl	$1, %ebp
+	jne	.L12
+.L3:
+	imull	%ebx, %eax
+	jmp	.L1
+.L12:
+	movl	%ebx, %r12d
+	subl	$2, %r12d
+	jne	.L13
+.L4:
+	imull	%ebp, %eax
+	jmp	.L3
+.L13:
+	movl	%ebx, %r13d
+	subl	$3, %r13d
+	jne	.L14
+.L5:
+	imull	%r12d, %eax
+	jmp	.L4
+.L14:
+	leal	-4(%rbx), %eax
+	movl	%eax, 12(%rsp)
+	leaq	12(%rsp), %rsi
+	leaq	11(%rsp), %rdi
+	call	_ZNR5boost4hana5fix_tIZ4mainEUlT_iE_EclIJiEEEDcDpOT_
+	imull	%r13d, %eax
+	jmp	.L5
+	.cfi_endproc
+.LFE1839:
+	.size	_ZNR5boost4hana5fix_tIZ4mainEUlT_iE_EclIJiEEEDcDpOT_, .-_ZNR5boost4hana5fix_tIZ4mainEUlT_iE_EclIJiEEEDcDpOT_
+	.align 2
+	.type	_ZZ4mainENKUlT_iE_clIN5boost4hana5fix_tIS0_EEEEiS_i, @function
+_ZZ4mainENKUlT_iE_clIN5boost4hana5fix_tIS0_EEEEiS_i:
+.LFB1850:
+	.cfi_startproc
+	movl	$1, %eax
+	testl	%esi, %esi
+	jne	.L36
+	ret
+.L36:
+	pushq	%r15
+	.cfi_def_cfa_offset 16
+	.cfi_offset 15, -16
+	pushq	%r14
+	.cfi_def_cfa_offset 24
+	.cfi_offset 14, -24
+	pushq	%r13
+	.cfi_def_cfa_offset 32
+	.cfi_offset 13, -32
+	pushq	%r12
+	.cfi_def_cfa_offset 40
+	.cfi_offset 12, -40
+	pushq	%rbp
+	.cfi_def_cfa_offset 48
+	.cfi_offset 6, -48
+	pushq	%rbx
+	.cfi_def_cfa_offset 56
+	.cfi_offset 3, -56
+	subq	$40, %rsp
+	.cfi_def_cfa_offset 96
+	movl	%esi, %ebx
+	movl	%esi, %ebp
+	subl	$1, %ebp
+	jne	.L37
+.L17:
+	imull	%ebx, %eax
+	addq	$40, %rsp
+	.cfi_remember_state
+	.cfi_def_cfa_offset 56
+	popq	%rbx
+	.cfi_def_cfa_offset 48
+	popq	%rbp
+	.cfi_def_cfa_offset 40
+	popq	%r12
+	.cfi_def_cfa_offset 32
+	popq	%r13
+	.cfi_def_cfa_offset 24
+	popq	%r14
+	.cfi_def_cfa_offset 16
+	popq	%r15
+	.cfi_def_cfa_offset 8
+	ret
+.L37:
+	.cfi_restore_state
+	movl	%esi, %r12d
+	subl	$2, %r12d
+	jne	.L38
+.L18:
+	imull	%ebp, %eax
+	jmp	.L17
+.L38:
+	movl	%esi, %r13d
+	subl	$3, %r13d
+	jne	.L39
+.L19:
+	imull	%r12d, %eax
+	jmp	.L18
+.L39:
+	movl	%esi, %r14d
+	subl	$4, %r14d
+	jne	.L40
+.L20:
+	imull	%r13d, %eax
+	jmp	.L19
+.L40:
+	movl	%esi, %r15d
+	subl	$5, %r15d
+	jne	.L41
+.L21:
+	imull	%r14d, %eax
+	jmp	.L20
+.L41:
+	movl	%esi, %edx
+	subl	$6, %edx
+	movl	%edx, 8(%rsp)
+	jne	.L42
+.L22:
+	imull	%r15d, %eax
+	jmp	.L21
+.L42:
+	movl	%esi, %ecx
+	subl	$7, %ecx
+	movl	%ecx, 12(%rsp)
+	jne	.L43
+.L23:
+	movl	8(%rsp), %edi
+	imull	%eax, %edi
+	movl	%edi, %eax
+	jmp	.L22
+.L43:
+	leal	-8(%rsi), %eax
+	movl	%eax, 28(%rsp)
+	leaq	28(%rsp), %rsi
+	leaq	27(%rsp), %rdi
+	call	_ZNR5boost4hana5fix_tIZ4mainEUlT_iE_EclIJiEEEDcDpOT_
+	movl	12(%rsp), %ecx
+	imull	%eax, %ecx
+	movl	%ecx, %eax
+	jmp	.L23
+	.cfi_endproc
+.LFE1850:
+	.size	_ZZ4mainENKUlT_iE_clIN5boost4hana5fix_tIS0_EEEEiS_i, .-_ZZ4mainENKUlT_iE_clIN5boost4hana5fix_tIS0_EEEEiS_i
+	.globl	main
+	.type	main, @function
+main:
+.LFB1835:
+	.cfi_startproc
+	subq	$24, %rsp
+	.cfi_def_cfa_offset 32
+	leaq	11(%rsp), %rdi
+	movl	$5, %esi
+	call	_ZZ4mainENKUlT_iE_clIN5boost4hana5fix_tIS0_EEEEiS_i
+	leal	(%rax,%rax,2), %eax
+	addl	%eax, %eax
+	movl	%eax, 12(%rsp)
+	movl	$0, %eax
+	addq	$24, %rsp
+	.cfi_def_cfa_offset 8
+	ret
+	.cfi_endproc
+.LFE1835:
+	.size	main, .-main
+	.ident	"GCC: (Debian 12.2.0-14+deb12u1) 12.2.0"
+	.section	.note.GNU-stack,"",@progbits
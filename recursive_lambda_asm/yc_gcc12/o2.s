@@ -0,0 +1,180 @@
+	.file	"x.cpp"
+	.text
+	.align 2
+	.p2align 4
+	.type	_ZNR5boost4hana5fix_tIZ4mainEUlT_iE_EclIJiEEEDcDpOT_.isra.0, @function
+_ZNR5boost4hana5fix_tIZ4mainEUlT_iE_EclIJiEEEDcDpOT_.isra.0:
+.LFB1899:
+	.cfi_startproc
+	movl	$1, %eax
+	testl	%edi, %edi
+	jne	.L26
+.L1:
+	ret
+	.p2align 4,,10
+	.p2align 3
+.L26:
+	movl	%edi, %edx
+	subl	$1, %edx
+	je	.L1
+	movl	%edi, %ecx
+	subl	$2, %ecx
+	jne	.L27
+	movl	$1, %edx
+	movl	$2, %ecx
+.L4:
+	imull	%ecx, %edx
+	imull	%edx, %eax
+	ret
+	.p2align 4,,10
+	.p2align 3
+.L27:
+	movl	%edi, %esi
+	subl	$3, %esi
+	movl	%esi, %r8d
+	je	.L28
+.L6:
+	movl	%r8d, %esi
+	imull	%ecx, %esi
+	imull	%edx, %esi
+	imull	%edi, %esi
+	imull	%esi, %eax
+	subl	$4, %edi
+	je	.L1
+	subl	$4, %edx
+	je	.L1
+	subl	$4, %ecx
+	je	.L12
+	subl	$4, %r8d
+	je	.L5
+	jmp	.L6
+	.p2align 4,,10
+	.p2align 3
+.L28:
+	movl	$1, %ecx
+	movl	$2, %edx
+.L5:
+	imull	%ecx, %edx
+	movl	$3, %ecx
+	jmp	.L4
+.L12:
+	movl	$2, %ecx
+	jmp	.L4
+	.cfi_endproc
+.LFE1899:
+	.size	_ZNR5boost4hana5fix_tIZ4mainEUlT_iE_EclIJiEEEDcDpOT_.isra.0, .-_ZNR5boost4hana5fix_tIZ4mainEUlT_iE_EclIJiEEEDcDpOT_.isra.0
+	.align 2
+	.p2align 4
+	.type	_ZZ4mainENKUlT_iE_clIN5boost4hana5fix_tIS0_EEEEiS_i.constprop.0, @function
+_ZZ4mainENKUlT_iE_clIN5boost4hana5fix_tIS0_EEEEiS_i.constprop.0:
+.LFB1901:
+	.cfi_startproc
+	movl	$1, %eax
+	testl	%edi, %edi
+	jne	.L59
+.L55:
+	ret
+	.p2align 4,,10
+	.p2align 3
+.L59:
+	movl	%edi, %r10d
+	movl	%edi, %r9d
+	subl	$1, %r10d
+	je	.L55
+	movl	%edi, %r11d
+	subl	$2, %r11d
+	jne	.L60
+	imull	%edi, %eax
+	ret
+	.p2align 4,,10
+	.p2align 3
+.L60:
+	pushq	%r14
+	.cfi_def_cfa_offset 16
+	.cfi_offset 14, -16
+	pushq	%r13
+	.cfi_def_cfa_offset 24
+	.cfi_offset 13, -24
+	pushq	%r12
+	.cfi_def_cfa_offset 32
+	.cfi_offset 12, -32
+	pushq	%rbp
+	.cfi_def_cfa_offset 40
+	.cfi_offset 6, -40
+	pushq	%rbx
+	.cfi_def_cfa_offset 48
+	.cfi_offset 3, -48
+	movl	%edi, %ebx
+	subl	$3, %ebx
+	je	.L33
+	movl	%edi, %ebp
+	subl	$4, %ebp
+	jne	.L61
+.L34:
+	imull	%r11d, %eax
+.L33:
+	imull	%r10d, %eax
+	popq	%rbx
+	.cfi_remember_state
+	.cfi_def_cfa_offset 40
+	popq	%rbp
+	.cfi_def_cfa_offset 32
+	popq	%r12
+	.cfi_def_cfa_offset 24
+	popq	%r13
+	.cfi_def_cfa_offset 16
+	popq	%r14
+	.cfi_def_cfa_offset 8
+	imull	%r9d, %eax
+	ret
+	.p2align 4,,10
+	.p2align 3
+.L61:
+	.cfi_restore_state
+	movl	%edi, %r12d
+	subl	$5, %r12d
+	je	.L35
+	movl	%edi, %r13d
+	subl	$6, %r13d
+	je	.L36
+	movl	%edi, %r14d
+	subl	$7, %r14d
+	je	.L37
+	leal	-8(%rdi), %edi
+	call	_ZNR5boost4hana5fix_tIZ4mainEUlT_iE_EclIJiEEEDcDpOT_.isra.0
+	imull	%eax, %r14d
+	movl	%r14d, %eax
+	imull	%r13d, %eax
+.L37:
+	imull	%r12d, %eax
+.L36:
+	imull	%ebp, %eax
+.L35:
+	imull	%ebx, %eax
+	jmp	.L34
+	.cfi_endproc
+.LFE1901:
+	.size	_ZZ4mainENKUlT_iE_clIN5boost4hana5fix_tIS0_EEEEiS_i.constprop.0, .-_ZZ4mainENKUlT_iE_clIN5boost4hana5fix_tIS0_EEEEiS_i.constprop.0
+	.section	.text.startup,"ax",@progbits
+	.p2align 4
+	.globl	main
+	.type	main, @function
+main:
+.LFB1835:
+	.cfi_startproc
+	subq	$16, %rsp
+	.cfi_def_cfa_offset 24
+	movl	$5, %edi
+	call	_ZZ4mainENKUlT_iE_clIN5boost4hana5fix_tIS0_EEEEiS_i.constprop.0
+	leal	(%rax,%rax,2), %eax
+	addl	%eax, %eax
+	movl	%eax, 12(%rsp)
+	xorl	%eax, %eax
+	addq	$16, %rsp
+	.cfi_def_cfa_offset 8
+	ret
+	.cfi_endproc
+.LFE1835:
+	.size	main, .-main
+	.ident	"GCC: (Debian 12.2.0-14+deb12u1) 12.2.0"
+	.section	.note.GNU-stack,"",@progbits